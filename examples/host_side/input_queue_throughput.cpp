@@ -0,0 +1,50 @@
+#include <chrono>
+#include <iostream>
+
+// Includes common necessary includes for development using depthai library
+#include "depthai/depthai.hpp"
+
+// Sends 1080p NV12 frames to the device as fast as possible, as a replay setup would, and reports throughput
+int main() {
+    using namespace std::chrono;
+
+    dai::Pipeline pipeline;
+    auto xin = pipeline.create<dai::node::XLinkIn>();
+    auto xout = pipeline.create<dai::node::XLinkOut>();
+    xin->setStreamName("in");
+    xin->setMaxDataSize(1920 * 1080 * 3 / 2);
+    xout->setStreamName("out");
+    // Frames are looped back, but the host doesn't wait for them
+    xout->input.setBlocking(false);
+    xout->input.setQueueSize(1);
+    xin->out.link(xout->input);
+
+    dai::Device device(pipeline);
+    auto in = device.getInputQueue("in");
+    device.getOutputQueue("out", 1, false);
+
+    for(unsigned depth : {1u, 4u}) {
+        in->setPipelineDepth(depth);
+        const auto before = in->getStats();
+
+        dai::ImgFrame frame;
+        frame.setType(dai::ImgFrame::Type::NV12);
+        frame.setWidth(1920);
+        frame.setHeight(1080);
+        frame.setData(std::vector<std::uint8_t>(1920 * 1080 * 3 / 2));
+
+        const auto start = steady_clock::now();
+        int numFrames = 0;
+        while(steady_clock::now() - start < seconds(5)) {
+            frame.setSequenceNum(numFrames++);
+            in->send(frame);
+        }
+
+        const auto stats = in->getStats();
+        const auto elapsed = duration<double>(steady_clock::now() - start).count();
+        std::cout << "Pipeline depth " << depth << ": " << (stats.numSent - before.numSent) / elapsed << " frames/s, "
+                  << (stats.bytesSent - before.bytesSent) / 1e6 / elapsed << " MB/s (link while writing: " << stats.writeMegabytesPerSecond
+                  << " MB/s, mean serialize time " << duration_cast<microseconds>(stats.serializeTime.mean()).count() << " us)" << std::endl;
+    }
+    return 0;
+}
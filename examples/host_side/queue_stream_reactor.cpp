@@ -0,0 +1,83 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Includes common necessary includes for development using depthai library
+#include "depthai/depthai.hpp"
+
+// Number of threads of this process (Linux only)
+static int getNumThreads() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line)) {
+        if(line.rfind("Threads:", 0) == 0) return std::stoi(line.substr(8));
+    }
+    return -1;
+}
+
+static dai::Pipeline createPipeline() {
+    dai::Pipeline pipeline;
+
+    auto camRgb = pipeline.create<dai::node::ColorCamera>();
+    auto left = pipeline.create<dai::node::MonoCamera>();
+    auto right = pipeline.create<dai::node::MonoCamera>();
+    camRgb->setPreviewSize(300, 300);
+    left->setCamera("left");
+    left->setResolution(dai::MonoCameraProperties::SensorResolution::THE_400_P);
+    right->setCamera("right");
+    right->setResolution(dai::MonoCameraProperties::SensorResolution::THE_400_P);
+
+    // A separate stream for each output
+    auto link = [&pipeline](dai::Node::Output& out, const std::string& name) {
+        auto xout = pipeline.create<dai::node::XLinkOut>();
+        xout->setStreamName(name);
+        out.link(xout->input);
+    };
+    link(camRgb->preview, "preview");
+    link(camRgb->video, "video");
+    link(camRgb->isp, "isp");
+    link(left->out, "left");
+    link(right->out, "right");
+
+    return pipeline;
+}
+
+// Receives from all queues for a while and reports message rate and latency
+static void benchmark(const std::string& mode, std::shared_ptr<dai::StreamReactor> reactor) {
+    // Reactor must be set before the pipeline is started
+    dai::Device device;
+    device.setOutputStreamReactor(std::move(reactor));
+    device.startPipeline(createPipeline());
+    for(const auto& name : device.getOutputQueueNames()) device.getOutputQueue(name, 4, false);
+
+    using namespace std::chrono;
+    const auto duration = seconds(10);
+    const auto start = steady_clock::now();
+    std::uint64_t numMessages = 0;
+    double latencySum = 0;
+    while(steady_clock::now() - start < duration) {
+        for(const auto& name : device.getQueueEvents()) {
+            for(const auto& frame : device.getOutputQueue(name)->tryGetAll<dai::ImgFrame>()) {
+                if(frame == nullptr) continue;
+                latencySum += duration_cast<microseconds>(steady_clock::now() - frame->getTimestamp()).count() / 1000.0;
+                numMessages++;
+            }
+        }
+    }
+
+    std::cout << mode << ": " << numMessages / duration.count() << " msg/s, average latency "
+              << (numMessages > 0 ? latencySum / numMessages : 0) << " ms, threads: " << getNumThreads() << std::endl;
+}
+
+int main() {
+    // A thread per output queue
+    benchmark("thread per queue", nullptr);
+
+    // Output queues read by two reactor threads
+    dai::StreamReactor::Config config;
+    config.numThreads = 2;
+    benchmark("stream reactor", std::make_shared<dai::StreamReactor>(config));
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 
 // Includes common necessary includes for development using depthai library
 #include "depthai/depthai.hpp"
+#include "depthai/device/DeviceGroup.hpp"
 
 std::shared_ptr<dai::Pipeline> createPipeline() {
     // Start defining a pipeline
@@ -29,12 +30,23 @@ int main(int argc, char** argv) {
     auto openVinoVersion = dai::OpenVINO::Version::VERSION_2021_4;
 
     std::map<std::string, std::shared_ptr<dai::DataOutputQueue>> qRgbMap;
-    std::vector<std::shared_ptr<dai::Device>> devices;
 
-    for(auto& deviceInfo : deviceInfoVec) {
-        auto device = std::make_shared<dai::Device>(openVinoVersion, deviceInfo, usbSpeed);
-        devices.push_back(device);
+    // Boot and connect to all devices concurrently
+    dai::Device::Config config;
+    config.version = openVinoVersion;
+    config.board.usb.maxSpeed = usbSpeed;
+    dai::DeviceGroup group(deviceInfoVec, config);
+    std::cout << "===Opened " << group.size() << " devices in " << std::chrono::duration_cast<std::chrono::milliseconds>(group.getStartupTime()).count()
+              << "ms" << std::endl;
+
+    for(std::size_t i = 0; i < group.size(); i++) {
+        auto device = group.getDevice(i);
+        const auto& deviceInfo = deviceInfoVec[i];
+        const auto timing = device->getStartupTiming();
         std::cout << "===Connected to " << deviceInfo.getMxId() << std::endl;
+        std::cout << "   >>> Startup: boot " << std::chrono::duration_cast<std::chrono::milliseconds>(timing.boot).count() << "ms, connect "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(timing.connect).count() << "ms, total "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(timing.total).count() << "ms" << std::endl;
         auto mxId = device->getMxId();
         auto cameras = device->getConnectedCameras();
         auto usbSpeed = device->getUsbSpeed();
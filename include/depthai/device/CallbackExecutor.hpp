@@ -0,0 +1,119 @@
+#pragma once
+
+// std
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// project
+#include "depthai/utility/ThreadPool.hpp"
+
+namespace dai {
+
+/**
+ * Executes queue callbacks, either inline on the calling (reading) thread,
+ * on a dedicated thread or on a thread pool. Tasks are executed in order, one at a time.
+ */
+class CallbackExecutor : public std::enable_shared_from_this<CallbackExecutor> {
+   public:
+    /// Where tasks are executed
+    enum class Mode {
+        /// On the thread scheduling the task
+        INLINE,
+        /// On a dedicated thread
+        THREAD,
+        /// On a (shared) thread pool
+        POOL
+    };
+
+    /// What happens when the number of pending tasks reaches 'maxPending'
+    enum class OverflowPolicy {
+        /// Block the thread scheduling the task until there is space
+        BLOCK,
+        /// Drop the oldest pending task
+        DROP_OLDEST,
+        /// Drop the task being scheduled
+        DROP_NEWEST
+    };
+
+    struct Config {
+        Mode mode = Mode::INLINE;
+        /// Maximum number of pending tasks (THREAD and POOL modes). 0 means unlimited
+        std::size_t maxPending = 16;
+        OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK;
+        /// Thread pool to use in POOL mode
+        std::shared_ptr<ThreadPool> pool;
+    };
+
+    struct Stats {
+        /// Number of tasks scheduled
+        std::uint64_t numScheduled = 0;
+        /// Number of tasks executed
+        std::uint64_t numExecuted = 0;
+        /// Number of tasks dropped due to overflow
+        std::uint64_t numDropped = 0;
+        /// Number of tasks currently waiting for execution
+        std::size_t numPending = 0;
+        /// Highest number of tasks waiting for execution at once
+        std::size_t maxNumPending = 0;
+    };
+
+    /**
+     * Creates an executor. Must be owned by a shared_ptr (eg. std::make_shared<CallbackExecutor>(config))
+     * @param config Executor configuration
+     */
+    explicit CallbackExecutor(Config config);
+
+    /**
+     * Stops the executor
+     */
+    ~CallbackExecutor();
+
+    /**
+     * Schedules a task for execution
+     * @param task Task to execute
+     * @returns False if task or an older pending task was dropped due to overflow, true otherwise
+     */
+    bool execute(std::function<void()> task);
+
+    /**
+     * Executes pending tasks, then stops the executor. Further tasks are dropped
+     */
+    void stop();
+
+    /**
+     * @returns Executor configuration
+     */
+    Config getConfig() const;
+
+    /**
+     * @returns Executor statistics
+     */
+    Stats getStats() const;
+
+   private:
+    // Shared with the dedicated thread, so it outlives the executor when it is destroyed from within a task
+    struct State {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::function<void()>> pending;
+        // Whether the pending tasks are being executed (by the thread pool)
+        bool draining{false};
+        std::thread::id drainingThread;
+        bool stopping{false};
+        Stats stats;
+    };
+
+    const Config config;
+    const std::shared_ptr<State> state;
+    std::thread thread;
+
+    static void run(State& state, std::function<void()>& task);
+    void drain();
+};
+
+}  // namespace dai
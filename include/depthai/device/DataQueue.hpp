@@ -2,12 +2,31 @@
 
 // std
 #include <atomic>
+#include <deque>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+    #if __has_include(<coroutine>)
+        #include <coroutine>
+        #define DEPTHAI_HAVE_COROUTINE_SUPPORT
+    #endif
+#endif
 
 // project
+#include "depthai/device/CallbackExecutor.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/utility/ConflatingQueue.hpp"
+#include "depthai/utility/EventNotifier.hpp"
 #include "depthai/utility/LockingQueue.hpp"
+#include "depthai/utility/MemoryBudget.hpp"
+#include "depthai/utility/MessagePool.hpp"
+#include "depthai/utility/QueueStats.hpp"
+#include "depthai/utility/RingQueue.hpp"
+#include "depthai/xlink/StreamReactor.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 
 // shared
@@ -24,21 +43,227 @@ class DataOutputQueue {
     /// Alias for callback id
     using CallbackId = int;
 
+    /// Underlying queue implementation
+    enum class QueueBackend {
+        /// Mutex guarded queue, shared by the reading thread and consumers
+        LOCKING,
+        /// Ring buffer, where the reading thread usually hands over messages without contending with consumers.
+        /// Not lock-free, consumers still serialize on a mutex, see RingQueue
+        RING,
+        /// Single slot holding only the latest message, which each new message overwrites.
+        /// Neither the reading thread nor consumers ever block each other. maxSize and blocking don't apply
+        CONFLATING
+    };
+
+    /// Which messages a full non-blocking queue drops to make space for a new one
+    enum class DropPolicy {
+        /// The oldest message
+        OLDEST,
+        /// For H.264/H.265 EncodedFrame streams: whole runs of P/B-frames back to their keyframe, oldest first.
+        /// Queued I-frames are never dropped, once only they are queued the incoming frame is dropped instead
+        /// (with the P/B-frames following it), so queued frames stay decodable
+        KEYFRAME_AWARE,
+        /// Decided by a dependency function, see setDropPolicy
+        CUSTOM
+    };
+
+    /// Execution statistics of a callback
+    struct CallbackStats {
+        /// Number of times the callback was called
+        std::uint64_t numCalls = 0;
+        /// Number of calls which threw an exception
+        std::uint64_t numExceptions = 0;
+        /// Total execution time
+        std::chrono::nanoseconds totalTime{0};
+        /// Longest execution time
+        std::chrono::nanoseconds maxTime{0};
+    };
+
+    /// Statistics of the queue
+    struct Stats {
+        /// Number of messages received from the device
+        std::uint64_t numReceived = 0;
+        /// Size of messages received from the device (data and metadata), in bytes
+        std::uint64_t bytesReceived = 0;
+        /// Statistics of the underlying queue, combined over all backends used
+        QueueStats queue;
+        /// Time spent parsing each received message
+        Histogram::Snapshot parseTime;
+        /// Time spent in each callback call
+        Histogram::Snapshot callbackTime;
+    };
+
    private:
+    friend class Device;
+    template <class T>
+    friend class TypedOutputQueue;
+
     LockingQueue<std::shared_ptr<ADatatype>> queue;
+    RingQueue<std::shared_ptr<ADatatype>> ringQueue;
+    ConflatingQueue<ADatatype> latestQueue;
+    std::atomic<QueueBackend> backend{QueueBackend::LOCKING};
+    std::atomic<DropPolicy> dropPolicy{DropPolicy::OLDEST};
+    // Guards switching the backend and moving messages between backends.
+    // Not held while pushing, as a full blocking queue waits for consumers which may be switching it
+    std::mutex pushMtx;
+    // Set while the reading thread pushes. Messages moved meanwhile are handed over in 'movedMessages' and pushed
+    // by the reading thread, so that a queue never has two producers at once. Both guarded by 'pushMtx'
+    bool pushing = false;
+    std::vector<std::shared_ptr<ADatatype>> movedMessages;
+    // Incremented on each backend switch, so the reading thread stops pushing to a queue switched away from
+    std::atomic<std::uint64_t> numSwitches{0};
+    // Moved messages which didn't fit into the new queue
+    std::atomic<std::uint64_t> numMoveDropped{0};
     std::thread readingThread;
+    // Reads instead of 'readingThread' if set
+    std::shared_ptr<StreamReactor> reactor;
+    StreamReactor::StreamId reactorStreamId{0};
+    std::shared_ptr<StreamProfiler> profiler;
     std::atomic<bool> running{true};
+    std::atomic<bool> zeroCopy{false};
+    std::atomic<bool> lazyMetadata{false};
+    // Accessed with std::atomic_load/std::atomic_store
+    std::shared_ptr<MessagePool> messagePool;
     std::string exceptionMessage{""};
     const std::string name{""};
     std::mutex callbacksMtx;
     std::unordered_map<CallbackId, std::function<void(std::string, std::shared_ptr<ADatatype>)>> callbacks;
-    CallbackId uniqueCallbackId{0};
+    std::unordered_map<CallbackId, CallbackStats> callbackStats;
+    std::atomic<std::size_t> numCallbacks{0};
+    std::atomic<CallbackId> uniqueCallbackId{0};
+    // Callbacks always called on the reading thread, regardless of executor
+    std::mutex internalCallbacksMtx;
+    std::unordered_map<CallbackId, std::function<void(std::string, std::shared_ptr<ADatatype>)>> internalCallbacks;
+    // Accessed with std::atomic_load/std::atomic_store. nullptr executes callbacks inline
+    std::shared_ptr<CallbackExecutor> callbackExecutor;
+    std::atomic<std::uint64_t> numReceived{0};
+    std::atomic<std::uint64_t> bytesReceived{0};
+    Histogram parseTime;
+    Histogram callbackTime;
+
+    // Waiting for a message without blocking a thread (getAsync/getAnyAsync).
+    // Waiters completed by another queue are dropped once reached or when a new waiter is added
+    struct AsyncGroup {
+        std::mutex mtx;
+        // Set once one of the waiters in the group was completed
+        bool done = false;
+    };
+    struct AsyncWaiter {
+        // Waiters on multiple queues share a group, only the first available message completes it
+        std::shared_ptr<AsyncGroup> group;
+        std::function<void(const std::string&, std::shared_ptr<ADatatype>, std::exception_ptr)> handler;
+    };
+    std::mutex asyncMtx;
+    std::deque<AsyncWaiter> asyncWaiters;
+    std::atomic<std::size_t> numAsyncWaiters{0};
+
+    // Pollable notification, created on first request and kept until the queue is destroyed
+    std::mutex notifierMtx;
+    std::unique_ptr<EventNotifier> notifier;
+    std::atomic<EventNotifier*> activeNotifier{nullptr};
+
+    // Packets read from the stream in one call, processed in order
+    struct PacketBatch {
+        std::vector<StreamPacketDesc> packets;
+        std::size_t next = 0;
+    };
+
+    // Message being received. A message group is complete once its members, following as separate packets, are received
+    struct ReceivedMessage {
+        std::shared_ptr<ADatatype> data;
+        std::vector<std::shared_ptr<ADatatype>> members;
+        std::size_t numMembers = 0;
+        std::uint64_t numBytes = 0;
+        std::chrono::steady_clock::duration parseDuration{0};
+
+        bool isComplete() const {
+            return data != nullptr && members.size() >= numMembers;
+        }
+    };
+    // Message being received by the reactor. Only accessed by the reactor's packet handler
+    ReceivedMessage reactorMessage;
+
+    void startReading(std::unique_ptr<PacketStream> stream);
+    // Members of a message group are taken from 'batch' first, then read from 'stream'
+    void processPacket(PacketStream& stream, StreamPacketDesc&& packet, PacketBatch& batch);
+    // Parses a packet, either a new message or the next member of the message group being received
+    void receivePacket(StreamPacketDesc&& packet, ReceivedMessage& msg);
+    // Hands a complete message out
+    void pushMessage(ReceivedMessage& msg);
+    void callCallbacks(const std::shared_ptr<ADatatype>& msg);
+    CallbackId addInternalCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback);
+    static std::size_t messageSize(const std::shared_ptr<ADatatype>& msg);
+    static bool isDependentFrame(const std::shared_ptr<ADatatype>& msg);
+    void addAsyncWaiter(AsyncWaiter waiter);
+    void dispatchAsyncWaiters();
+    void failAsyncWaiters();
 
     // const std::chrono::milliseconds READ_TIMEOUT{500};
 
+    // Calls 'f' with the queue of current backend
+    template <typename F>
+    auto withQueue(F&& f) -> decltype(f(queue)) {
+        return withQueue(backend.load(), std::forward<F>(f));
+    }
+
+    // Calls 'f' with the queue of given backend
+    template <typename F>
+    auto withQueue(QueueBackend queueBackend, F&& f) -> decltype(f(queue)) {
+        switch(queueBackend) {
+            case QueueBackend::RING:
+                return f(ringQueue);
+            case QueueBackend::CONFLATING:
+                return f(latestQueue);
+            case QueueBackend::LOCKING:
+                break;
+        }
+        return f(queue);
+    }
+
+    // Decodes deferred metadata before a message is handed out
+    template <class T>
+    static std::shared_ptr<T> prepare(std::shared_ptr<ADatatype> msg) {
+        if(msg) msg->decodeMetadata();
+        return std::dynamic_pointer_cast<T>(std::move(msg));
+    }
+
+    // Passes all queued messages to 'callback' as they are (without decoding metadata or casting)
+    bool consumeAll(std::function<void(std::shared_ptr<ADatatype>&)> callback) {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        return withQueue([&callback](auto& q) { return q.consumeAll(callback); });
+    }
+
+    bool waitAndConsumeAll(std::function<void(std::shared_ptr<ADatatype>&)> callback) {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        return withQueue([&callback](auto& q) { return q.waitAndConsumeAll(callback); });
+    }
+
+    template <typename Rep, typename Period>
+    bool waitAndConsumeAll(std::function<void(std::shared_ptr<ADatatype>&)> callback, std::chrono::duration<Rep, Period> timeout) {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        return withQueue([&callback, timeout](auto& q) { return q.waitAndConsumeAll(callback, timeout); });
+    }
+
+   protected:
+    /**
+     * Creates a queue which reads from a packet stream other than XLink, eg. an in-process stream for testing without a device
+     */
+    DataOutputQueue(std::unique_ptr<PacketStream> stream, const std::string& streamName, unsigned int maxSize = 16, bool blocking = true);
+
+    /**
+     * Creates a queue which is read by a (shared) stream reactor, from a packet stream other than XLink
+     */
+    DataOutputQueue(std::unique_ptr<PacketStream> stream, const std::string& streamName, std::shared_ptr<StreamReactor> reactor, unsigned int maxSize = 16);
+
    public:
     // DataOutputQueue constructor
     DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize = 16, bool blocking = true);
+    /**
+     * Creates a queue which is read by a (shared) stream reactor, instead of its own thread.
+     * As reactor threads read other streams too, the queue is never blocking (see setBlocking)
+     * and its callbacks never run on reactor threads (see setCallbackExecutor)
+     */
+    DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, std::shared_ptr<StreamReactor> reactor, unsigned int maxSize = 16);
     ~DataOutputQueue();
 
     /**
@@ -56,7 +281,8 @@ class DataOutputQueue {
     void close();
 
     /**
-     * Sets queue behavior when full (maxSize)
+     * Sets queue behavior when full (maxSize). A queue read by a stream reactor stays non-blocking,
+     * as blocking would stall other streams read by the same reactor thread
      *
      * @param blocking Specifies if block or overwrite the oldest message in the queue
      */
@@ -83,6 +309,143 @@ class DataOutputQueue {
      */
     unsigned int getMaxSize() const;
 
+    /**
+     * Sets maximum total size (in bytes) of messages in the queue, measured as data size plus a metadata estimate.
+     * Applies together with maxSize and follows the blocking behavior: either blocks or overwrites the oldest messages
+     * until the new message fits. A message larger than the limit is still accepted into an empty queue. Only applies to the LOCKING queue backend
+     *
+     * @param maxBytes Maximum number of bytes, 0 means no limit (default)
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum total size (in bytes) of messages in the queue
+     *
+     * @returns Maximum number of bytes, 0 if not limited
+     */
+    std::size_t getMaxBytes() const;
+
+    /**
+     * Sets a memory budget shared with other queues (eg. by all queues of a Device), capping their combined size.
+     * Messages are only added to the queue once they fit into the budget, following the blocking behavior
+     *
+     * @param budget Shared memory budget, or nullptr to not share one
+     */
+    void setMemoryBudget(std::shared_ptr<MemoryBudget> budget);
+
+    /**
+     * Gets the memory budget shared with other queues
+     *
+     * @returns Memory budget or nullptr if not set
+     */
+    std::shared_ptr<MemoryBudget> getMemoryBudget() const;
+
+    /**
+     * Gets total size (in bytes) of messages currently in the queue
+     *
+     * @returns Number of bytes
+     */
+    std::size_t getQueuedBytes() const;
+
+    /**
+     * Sets which messages are dropped when the queue is full and non-blocking. Only applies to the LOCKING queue backend
+     *
+     * @param policy Drop policy, OLDEST (default) or KEYFRAME_AWARE
+     */
+    void setDropPolicy(DropPolicy policy);
+
+    /**
+     * Sets a custom drop policy, given by a function telling whether a message depends on the messages before it.
+     * When the queue is full and non-blocking, whole runs of dependent messages are dropped (oldest first), and
+     * following dependent messages as well if that run reached the newest message, until an independent message arrives.
+     * Queued independent messages are never dropped, once there are no dependent messages left to drop the incoming message
+     * is dropped instead (with the dependent messages following it)
+     *
+     * @param dependsOnPrevious Function returning true if a message depends on the ones before it. Called on the reading thread, without holding the queue's lock
+     */
+    void setDropPolicy(std::function<bool(const std::shared_ptr<ADatatype>&)> dependsOnPrevious);
+
+    /**
+     * Gets which messages are dropped when the queue is full and non-blocking
+     *
+     * @returns Drop policy
+     */
+    DropPolicy getDropPolicy() const;
+
+    /**
+     * Sets whether received data is adopted from XLink packets instead of copied.
+     * Applies to Buffer, ImgFrame and EncodedFrame messages. Their data is then only copied
+     * if accessed through Buffer::getData (or getRaw), while Buffer::getDataView and
+     * ImgFrame::getFrame/getCvFrame access it in place
+     *
+     * @param zeroCopy Specifies if data should be adopted instead of copied
+     */
+    void setZeroCopy(bool zeroCopy);
+
+    /**
+     * Gets whether received data is adopted from XLink packets instead of copied
+     *
+     * @returns True if zero copy, false otherwise
+     */
+    bool getZeroCopy() const;
+
+    /**
+     * Sets a pool from which received messages are allocated. Messages return to the pool
+     * once released, so following messages reuse their allocations (including data capacity).
+     * A single pool can be shared between multiple queues
+     *
+     * @param pool Message pool, or nullptr to allocate each message anew (default)
+     */
+    void setMessagePool(std::shared_ptr<MessagePool> pool);
+
+    /**
+     * Gets the pool from which received messages are allocated
+     *
+     * @returns Message pool or nullptr if not set
+     */
+    std::shared_ptr<MessagePool> getMessagePool() const;
+
+    /**
+     * Sets whether metadata of received messages is decoded lazily, only once a message is
+     * retrieved from the queue (or passed to callbacks). Messages dropped by a full non-blocking
+     * queue are then never decoded, which saves time for large metadata (eg. ImgDetections, Tracklets, IMUData)
+     *
+     * @param lazy Specifies if metadata decoding should be deferred
+     */
+    void setLazyMetadata(bool lazy);
+
+    /**
+     * Gets whether metadata of received messages is decoded lazily
+     *
+     * @returns True if lazy, false otherwise
+     */
+    bool getLazyMetadata() const;
+
+    /**
+     * Sets the underlying queue implementation. Messages already in the queue are kept, unless they don't fit
+     * into the new queue (eg. a full blocking one), in which case they are dropped and counted in getStats().
+     * Never waits for consumers, so it can be called from a consumer thread.
+     * Should be set before consuming from the queue, as consumers already waiting
+     * for a message aren't moved over to the new backend
+     *
+     * @param backend Queue backend. Default: LOCKING
+     */
+    void setQueueBackend(QueueBackend backend);
+
+    /**
+     * Gets the underlying queue implementation
+     *
+     * @returns Queue backend
+     */
+    QueueBackend getQueueBackend() const;
+
+    /**
+     * Gets number of messages overwritten by a newer message before they were retrieved, while CONFLATING backend was set
+     *
+     * @returns Number of overwritten messages
+     */
+    std::uint64_t getNumOverwritten() const;
+
     /**
      * Gets queues name
      *
@@ -122,6 +485,188 @@ class DataOutputQueue {
      */
     bool removeCallback(CallbackId callbackId);
 
+    /**
+     * Sets how callbacks are executed: inline on the reading thread (default), on a dedicated thread
+     * or on a thread pool. Executing callbacks off the reading thread keeps slow callbacks from
+     * stalling reading from the device, at the cost of pending messages held by the executor
+     * (limited by 'maxPending' and handled by 'overflowPolicy' once reached).
+     * Callbacks of a queue read by a stream reactor run on the reactor's callback pool instead of inline,
+     * and overflowing drops the oldest pending callback instead of blocking
+     *
+     * @param config Callback executor configuration
+     */
+    void setCallbackExecutor(CallbackExecutor::Config config);
+
+    /**
+     * Gets callback executor configuration
+     *
+     * @returns Callback executor configuration
+     */
+    CallbackExecutor::Config getCallbackExecutor() const;
+
+    /**
+     * Gets callback executor statistics. Only tracked for THREAD and POOL modes
+     *
+     * @returns Callback executor statistics
+     */
+    CallbackExecutor::Stats getCallbackExecutorStats() const;
+
+    /**
+     * Gets statistics since the queue was created: received messages, how the queue handled them
+     * (including dropped messages and the high-water mark) and timing histograms of parsing,
+     * time spent in the queue and callbacks
+     *
+     * @returns Queue statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * Gets execution statistics of a callback
+     *
+     * @param callbackId Id of callback
+     * @returns Callback statistics
+     */
+    CallbackStats getCallbackStats(CallbackId callbackId);
+
+    /**
+     * Gets profiling counters of the underlying stream: packets and bytes read, time spent reading
+     * and latency of packets from the device. Only recorded while profiling is enabled (DEPTHAI_PROFILING=1)
+     *
+     * @returns Stream profiling counters
+     */
+    StreamProfilingData getProfilingData() const;
+
+    /// Handler of a message retrieved asynchronously. Either message or error (if the queue was closed) is set
+    using AsyncHandler = std::function<void(std::shared_ptr<ADatatype> message, std::exception_ptr error)>;
+
+    /// Handler of a message retrieved asynchronously from any of several queues, see getAnyAsync
+    using AnyAsyncHandler = std::function<void(std::string queueName, std::shared_ptr<ADatatype> message, std::exception_ptr error)>;
+
+    /**
+     * Retrieves the next message without blocking. If a message is available, the handler is called right away,
+     * otherwise once a message arrives, on the reading thread. Handlers should be short (eg. hand the message over to an executor),
+     * as reading from the device waits for them. Pending handlers are called with an error once the queue is closed
+     *
+     * @param handler Handler called exactly once, with the message or an error
+     */
+    void getAsync(AsyncHandler handler);
+
+    /**
+     * Retrieves the next message without blocking a thread
+     *
+     * @returns Future of the message, which holds an exception if the queue is closed before a message arrives
+     */
+    std::future<std::shared_ptr<ADatatype>> getAsync();
+
+    /**
+     * Retrieves the next message from whichever of the queues receives one first, without blocking.
+     * Only a single message is retrieved, other queues are left untouched. See getAsync for when the handler is called
+     *
+     * @param queues Queues to wait on
+     * @param handler Handler called exactly once, with queue name and message, or an error if one of the queues is closed
+     */
+    static void getAnyAsync(const std::vector<std::shared_ptr<DataOutputQueue>>& queues, AnyAsyncHandler handler);
+
+    /**
+     * Retrieves the next message from whichever of the queues receives one first, without blocking a thread
+     *
+     * @param queues Queues to wait on
+     * @returns Future of queue name and message, which holds an exception if one of the queues is closed before a message arrives
+     */
+    static std::future<std::pair<std::string, std::shared_ptr<ADatatype>>> getAnyAsync(const std::vector<std::shared_ptr<DataOutputQueue>>& queues);
+
+    /**
+     * Gets a file descriptor which is readable while messages are available, for use with epoll, poll or select.
+     * After handling it, call clearNotification - the descriptor then stays readable only if messages remain.
+     * It also becomes readable once the queue is closed. Created on first call, owned by the queue.
+     * Backed by an eventfd on Linux and a pipe on other POSIX platforms, not supported on Windows (throws)
+     *
+     * @returns File descriptor
+     */
+    int getNotificationFd();
+
+    /**
+     * Resets the file descriptor returned by getNotificationFd, unless messages are still available or the queue is closed
+     */
+    void clearNotification();
+
+#ifdef DEPTHAI_HAVE_COROUTINE_SUPPORT
+    /// Awaitable of the next message of a queue, see next()
+    class NextAwaitable {
+        DataOutputQueue& queue;
+        std::shared_ptr<ADatatype> message;
+        std::exception_ptr error;
+        // Set by whichever of await_suspend and the handler finishes first
+        std::atomic<bool> finished{false};
+
+       public:
+        explicit NextAwaitable(DataOutputQueue& queue) : queue(queue) {}
+        bool await_ready() const noexcept {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            queue.getAsync([this, handle](std::shared_ptr<ADatatype> msg, std::exception_ptr err) {
+                message = std::move(msg);
+                error = err;
+                if(finished.exchange(true)) handle.resume();
+            });
+            // Don't suspend if the handler was already called
+            return !finished.exchange(true);
+        }
+        std::shared_ptr<ADatatype> await_resume() {
+            if(error) std::rethrow_exception(error);
+            return std::move(message);
+        }
+    };
+
+    /// Awaitable of the next message of any of several queues, see nextAny()
+    class AnyAwaitable {
+        std::vector<std::shared_ptr<DataOutputQueue>> queues;
+        std::pair<std::string, std::shared_ptr<ADatatype>> result;
+        std::exception_ptr error;
+        std::atomic<bool> finished{false};
+
+       public:
+        explicit AnyAwaitable(std::vector<std::shared_ptr<DataOutputQueue>> queues) : queues(std::move(queues)) {}
+        bool await_ready() const noexcept {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            getAnyAsync(queues, [this, handle](std::string name, std::shared_ptr<ADatatype> msg, std::exception_ptr err) {
+                result = {std::move(name), std::move(msg)};
+                error = err;
+                if(finished.exchange(true)) handle.resume();
+            });
+            return !finished.exchange(true);
+        }
+        std::pair<std::string, std::shared_ptr<ADatatype>> await_resume() {
+            if(error) std::rethrow_exception(error);
+            return std::move(result);
+        }
+    };
+
+    /**
+     * Awaits the next message (C++20 coroutines), eg. auto msg = co_await queue->next();
+     * If the message isn't available right away, the coroutine is resumed on the reading thread, see getAsync
+     *
+     * @returns Awaitable of the message, which throws if the queue is closed
+     */
+    NextAwaitable next() {
+        return NextAwaitable(*this);
+    }
+
+    /**
+     * Awaits the next message of whichever queue receives one first (C++20 coroutines),
+     * eg. auto [name, msg] = co_await DataOutputQueue::nextAny(queues);
+     *
+     * @param queues Queues to wait on
+     * @returns Awaitable of queue name and message, which throws if one of the queues is closed
+     */
+    static AnyAwaitable nextAny(std::vector<std::shared_ptr<DataOutputQueue>> queues) {
+        return AnyAwaitable(std::move(queues));
+    }
+#endif
+
     /**
      * Check whether front of the queue has message of type T
      * @returns True if queue isn't empty and the first element is of type T, false otherwise
@@ -130,7 +675,7 @@ class DataOutputQueue {
     bool has() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(queue.front(val) && dynamic_cast<T*>(val.get())) {
+        if(withQueue([&](auto& q) { return q.front(val); }) && dynamic_cast<T*>(val.get())) {
             return true;
         }
         return false;
@@ -142,7 +687,7 @@ class DataOutputQueue {
      */
     bool has() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
-        return !queue.empty();
+        return withQueue([](auto& q) { return !q.empty(); });
     }
 
     /**
@@ -154,8 +699,8 @@ class DataOutputQueue {
     std::shared_ptr<T> tryGet() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.tryPop(val)) return nullptr;
-        return std::dynamic_pointer_cast<T>(val);
+        if(!withQueue([&](auto& q) { return q.tryPop(val); })) return nullptr;
+        return prepare<T>(std::move(val));
     }
 
     /**
@@ -176,10 +721,10 @@ class DataOutputQueue {
     std::shared_ptr<T> get() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.waitAndPop(val)) {
+        if(!withQueue([&](auto& q) { return q.waitAndPop(val); })) {
             throw std::runtime_error(exceptionMessage.c_str());
         }
-        return std::dynamic_pointer_cast<T>(val);
+        return prepare<T>(std::move(val));
     }
 
     /**
@@ -200,8 +745,8 @@ class DataOutputQueue {
     std::shared_ptr<T> front() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.front(val)) return nullptr;
-        return std::dynamic_pointer_cast<T>(val);
+        if(!withQueue([&](auto& q) { return q.front(val); })) return nullptr;
+        return prepare<T>(std::move(val));
     }
 
     /**
@@ -224,12 +769,12 @@ class DataOutputQueue {
     std::shared_ptr<T> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.tryWaitAndPop(val, timeout)) {
+        if(!withQueue([&](auto& q) { return q.tryWaitAndPop(val, timeout); })) {
             hasTimedout = true;
             return nullptr;
         }
         hasTimedout = false;
-        return std::dynamic_pointer_cast<T>(val);
+        return prepare<T>(std::move(val));
     }
 
     /**
@@ -254,11 +799,12 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        queue.consumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        auto consume = [&messages](std::shared_ptr<ADatatype>& msg) {
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
-            messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
-        });
+            messages.push_back(prepare<T>(std::move(msg)));
+        };
+        withQueue([&](auto& q) { return q.consumeAll(consume); });
 
         return messages;
     }
@@ -283,11 +829,12 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        queue.waitAndConsumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        auto consume = [&messages](std::shared_ptr<ADatatype>& msg) {
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
-            messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
-        });
+            messages.push_back(prepare<T>(std::move(msg)));
+        };
+        withQueue([&](auto& q) { return q.waitAndConsumeAll(consume); });
 
         return messages;
     }
@@ -314,13 +861,12 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        hasTimedout = !queue.waitAndConsumeAll(
-            [&messages](std::shared_ptr<ADatatype>& msg) {
-                // dynamic pointer cast may return nullptr
-                // in which case that message in vector will be nullptr
-                messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
-            },
-            timeout);
+        auto consume = [&messages](std::shared_ptr<ADatatype>& msg) {
+            // dynamic pointer cast may return nullptr
+            // in which case that message in vector will be nullptr
+            messages.push_back(prepare<T>(std::move(msg)));
+        };
+        hasTimedout = !withQueue([&](auto& q) { return q.waitAndConsumeAll(consume, timeout); });
 
         return messages;
     }
@@ -339,15 +885,82 @@ class DataOutputQueue {
 };
 
 /**
- * Access to send messages through XLink stream
+ * Access to send messages through XLink stream.
+ *
+ * Messages are serialized on one thread and written on another. Besides up to maxSize queued messages,
+ * up to pipelineDepth serialized messages, one being serialized and one being written are in flight,
+ * ie. maxSize + 4 messages with the default pipeline depth. A blocking send() therefore only blocks
+ * once all of these are taken, and messages sent meanwhile may still be written long after send() returned
  */
 class DataInputQueue {
+   public:
+    /// Statistics of the queue
+    struct Stats {
+        /// Number of messages written to the device
+        std::uint64_t numSent = 0;
+        /// Size of messages written to the device (data and metadata), in bytes
+        std::uint64_t bytesSent = 0;
+        /// Statistics of the underlying queue, combined for conflating and non-conflating mode
+        QueueStats queue;
+        /// Time spent serializing each message
+        Histogram::Snapshot serializeTime;
+        /// Time spent writing each message to the device
+        Histogram::Snapshot writeTime;
+        /// Messages written per second, from the start of the first write to the end of the latest one
+        double messagesPerSecond = 0;
+        /// Megabytes (10^6 bytes) written per second, from the start of the first write to the end of the latest one
+        double megabytesPerSecond = 0;
+        /// Megabytes (10^6 bytes) written per second spent writing, ie. throughput of the link while busy
+        double writeMegabytesPerSecond = 0;
+    };
+
+    /// Default number of serialized messages waiting to be written, see setPipelineDepth
+    static constexpr unsigned DEFAULT_PIPELINE_DEPTH = 2;
+
+   private:
+    // Message with serialized metadata, ready to be written
+    struct SerializedMessage {
+        std::shared_ptr<RawBuffer> data;
+        std::vector<std::uint8_t> metadata;
+        // Members of a message group, written after the group itself
+        std::vector<std::shared_ptr<RawBuffer>> aux;
+        std::vector<std::vector<std::uint8_t>> auxMetadata;
+    };
+
     LockingQueue<std::shared_ptr<RawBuffer>> queue;
+    ConflatingQueue<RawBuffer> latestQueue;
+    std::atomic<bool> conflating{false};
+    // Held while sending and while switching conflating, so a message never lands in the queue switched away from
+    std::timed_mutex sendMtx;
+    LockingQueue<SerializedMessage> pipeline;
+    std::thread serializingThread;
     std::thread writingThread;
+    std::shared_ptr<StreamProfiler> profiler;
     std::atomic<bool> running{true};
     std::string exceptionMessage;
     const std::string name;
     std::atomic<std::size_t> maxDataSize{device::XLINK_USB_BUFFER_MAX_SIZE};
+    std::atomic<std::uint64_t> numSent{0};
+    std::atomic<std::uint64_t> bytesSent{0};
+    Histogram serializeTime;
+    Histogram writeTime;
+    // Start of the first write and end of the latest one, in steady_clock nanoseconds
+    std::atomic<std::int64_t> firstWriteStart{0};
+    std::atomic<std::int64_t> lastWriteEnd{0};
+
+    void startWriting(std::unique_ptr<PacketStream> stream);
+    bool pop(std::shared_ptr<RawBuffer>& data);
+    SerializedMessage serialize(std::shared_ptr<RawBuffer> data);
+
+   protected:
+    /**
+     * Creates a queue which writes to a packet stream other than XLink, eg. an in-process stream for testing without a device
+     */
+    DataInputQueue(std::unique_ptr<PacketStream> stream,
+                   const std::string& streamName,
+                   unsigned int maxSize = 16,
+                   bool blocking = true,
+                   std::size_t maxDataSize = device::XLINK_USB_BUFFER_MAX_SIZE);
 
    public:
     DataInputQueue(const std::shared_ptr<XLinkConnection> conn,
@@ -413,6 +1026,101 @@ class DataInputQueue {
      */
     unsigned int getMaxSize() const;
 
+    /**
+     * Sets maximum total size (in bytes) of messages in the queue, measured as data size plus a metadata estimate.
+     * Applies together with maxSize and follows the blocking behavior: either blocks or overwrites the oldest messages
+     * until the new message fits. A message larger than the limit is still accepted into an empty queue
+     *
+     * @param maxBytes Maximum number of bytes, 0 means no limit (default)
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum total size (in bytes) of messages in the queue
+     *
+     * @returns Maximum number of bytes, 0 if not limited
+     */
+    std::size_t getMaxBytes() const;
+
+    /**
+     * Sets a memory budget shared with other queues (eg. by all queues of a Device), capping their combined size.
+     * Messages are only added to the queue once they fit into the budget, following the blocking behavior
+     *
+     * @param budget Shared memory budget, or nullptr to not share one
+     */
+    void setMemoryBudget(std::shared_ptr<MemoryBudget> budget);
+
+    /**
+     * Gets the memory budget shared with other queues
+     *
+     * @returns Memory budget or nullptr if not set
+     */
+    std::shared_ptr<MemoryBudget> getMemoryBudget() const;
+
+    /**
+     * Gets total size (in bytes) of messages currently in the queue
+     *
+     * @returns Number of bytes
+     */
+    std::size_t getQueuedBytes() const;
+
+    /**
+     * Sets whether only the latest message is kept for sending. Each sent message then overwrites
+     * the one still waiting to be written to the device, and sending never blocks. maxSize and blocking don't apply.
+     * Waits for sends in progress (eg. blocked on a full queue) to complete first
+     *
+     * @param conflating Specifies if only the latest message should be kept
+     */
+    void setConflating(bool conflating);
+
+    /**
+     * Gets whether only the latest message is kept for sending
+     *
+     * @returns True if conflating, false otherwise
+     */
+    bool getConflating() const;
+
+    /**
+     * Gets number of messages overwritten by a newer message before they were written to the device, while conflating
+     *
+     * @returns Number of overwritten messages
+     */
+    std::uint64_t getNumOverwritten() const;
+
+    /**
+     * Sets maximum number of messages serialized ahead, waiting to be written to the device.
+     * Messages are serialized on a separate thread, overlapping with the write of previous messages.
+     * Serialized messages are no longer counted by the queue (maxSize, maxBytes and memory budget),
+     * so up to maxSize + depth + 2 messages are in flight before send() blocks. Lower it to tighten back-pressure
+     *
+     * @param depth Maximum number of serialized messages waiting to be written, at least 1
+     */
+    void setPipelineDepth(unsigned depth);
+
+    /**
+     * Gets maximum number of messages serialized ahead
+     *
+     * @returns Pipeline depth
+     */
+    unsigned getPipelineDepth() const;
+
+    /**
+     * Gets statistics since the queue was created: sent messages, how the queue handled them
+     * (including dropped messages and the high-water mark) and timing histograms of time spent
+     * in the queue, serializing and writing, as well as throughput
+     *
+     * @returns Queue statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * Gets profiling counters of the underlying stream: packets and bytes written and time spent writing.
+     * Only recorded while profiling is enabled (DEPTHAI_PROFILING=1)
+     *
+     * @returns Stream profiling counters
+     */
+    StreamProfilingData getProfilingData() const;
+
     /**
      * Gets queues name
      *
@@ -11,6 +11,8 @@
 
 // project
 #include "DataQueue.hpp"
+#include "QueueEventDispatcher.hpp"
+#include "TypedOutputQueue.hpp"
 #include "depthai/device/DeviceBase.hpp"
 
 namespace dai {
@@ -96,6 +98,22 @@ class Device : public DeviceBase {
     /// Maximum number of elements in event queue
     static constexpr std::size_t EVENT_QUEUE_MAXIMUM_SIZE{2048};
 
+    /**
+     * Sets a stream reactor, which reads output streams of pipelines started on this device from then on,
+     * instead of a thread per output queue. Eg. create the device without a pipeline, set the reactor and then start the pipeline.
+     * The same reactor may be set on several devices. Pass nullptr to restore a thread per output queue (default)
+     *
+     * @param reactor Stream reactor reading output queues
+     */
+    void setOutputStreamReactor(std::shared_ptr<StreamReactor> reactor);
+
+    /**
+     * Gets the stream reactor used for output queues of pipelines started on this device from then on
+     *
+     * @returns Stream reactor or nullptr if each output queue uses its own thread
+     */
+    std::shared_ptr<StreamReactor> getOutputStreamReactor() const;
+
     /**
      * Gets an output queue corresponding to stream name. If it doesn't exist it throws
      *
@@ -114,6 +132,64 @@ class Device : public DeviceBase {
      */
     std::shared_ptr<DataOutputQueue> getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking = true);
 
+    /**
+     * Gets a typed view of an output queue corresponding to stream name, if it exists, otherwise it throws.
+     * Messages are retrieved as T without a dynamic cast per message, eg. getOutputQueue<ImgFrame>("rgb")
+     *
+     * @param name Queue/stream name, created by XLinkOut node
+     * @returns Typed view of DataOutputQueue
+     */
+    template <class T>
+    TypedOutputQueue<T> getOutputQueue(const std::string& name) {
+        return TypedOutputQueue<T>(getOutputQueue(name));
+    }
+
+    /**
+     * Gets a typed view of an output queue corresponding to stream name, if it exists, otherwise it throws. Also sets queue options
+     *
+     * @param name Queue/stream name, set in XLinkOut node
+     * @param maxSize Maximum number of messages in queue
+     * @param blocking Queue behavior once full. True specifies blocking and false overwriting of oldest messages. Default: true
+     * @returns Typed view of DataOutputQueue
+     */
+    template <class T>
+    TypedOutputQueue<T> getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking = true) {
+        return TypedOutputQueue<T>(getOutputQueue(name, maxSize, blocking));
+    }
+
+    /**
+     * Sets how callbacks of all output queues are executed, including queues created by a later startPipeline call.
+     * In POOL mode without a specified pool, queues share a thread pool owned by the device
+     *
+     * @param config Callback executor configuration
+     */
+    void setCallbackExecutor(CallbackExecutor::Config config);
+
+    /**
+     * Sets a cap on the combined size of messages held by all input and output queues of this device,
+     * measured as data size plus a metadata estimate. Queues wait for (or overwrite their oldest messages to make)
+     * space according to their blocking behavior. Each queue still accepts a single message when empty.
+     * Applies to existing queues and those of pipelines started later. Without a limit, queues don't account their messages at all
+     *
+     * @param maxBytes Maximum number of bytes, 0 means no limit (default)
+     */
+    void setQueueMemoryLimit(std::size_t maxBytes);
+
+    /**
+     * Gets the cap on the combined size of messages held by all queues of this device
+     *
+     * @returns Maximum number of bytes, 0 if not limited
+     */
+    std::size_t getQueueMemoryLimit() const;
+
+    /**
+     * Gets the combined size of messages currently held by all queues of this device.
+     * Only tracked while a limit is set, see setQueueMemoryLimit
+     *
+     * @returns Number of bytes, 0 if not limited
+     */
+    std::size_t getQueueMemoryUsage() const;
+
     /**
      * Get all available output queue names
      *
@@ -216,11 +292,14 @@ class Device : public DeviceBase {
     std::unordered_map<std::string, std::shared_ptr<DataOutputQueue>> outputQueueMap;
     std::unordered_map<std::string, std::shared_ptr<DataInputQueue>> inputQueueMap;
     std::unordered_map<std::string, DataOutputQueue::CallbackId> callbackIdMap;
+    CallbackExecutor::Config callbackExecutorConfig;
+    std::shared_ptr<ThreadPool> callbackPool;
+    std::shared_ptr<StreamReactor> outputStreamReactor;
+    // Shared by all queues
+    std::shared_ptr<MemoryBudget> queueMemoryBudget = std::make_shared<MemoryBudget>();
 
     // Event queue
-    std::mutex eventMtx;
-    std::condition_variable eventCv;
-    std::deque<std::string> eventQueue;
+    QueueEventDispatcher queueEvents{EVENT_QUEUE_MAXIMUM_SIZE};
 
     bool startPipelineImpl(const Pipeline& pipeline) override;
     void closeImpl() override;
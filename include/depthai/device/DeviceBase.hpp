@@ -76,6 +76,26 @@ class DeviceBase {
         tl::optional<LogLevel> logLevel;
     };
 
+    /**
+     * Time taken by phases of device startup
+     */
+    struct StartupTiming {
+        /// Resolving a partially specified DeviceInfo to a connected device
+        std::chrono::nanoseconds search{0};
+        /// Preparing firmware with board configuration
+        std::chrono::nanoseconds firmware{0};
+        /// Booting firmware, through bootloader or USB ROM. Zero if device was already booted
+        std::chrono::nanoseconds boot{0};
+        /// Finding the booted device and connecting to it
+        std::chrono::nanoseconds connect{0};
+        /// Starting RPC and service threads, including initial timesync
+        std::chrono::nanoseconds setup{0};
+        /// Starting the pipeline given to the constructor, if any
+        std::chrono::nanoseconds pipeline{0};
+        /// Whole startup
+        std::chrono::nanoseconds total{0};
+    };
+
     // static API
 
     /**
@@ -463,6 +483,13 @@ class DeviceBase {
      */
     DeviceInfo getDeviceInfo() const;
 
+    /**
+     * Get time taken by phases of device startup
+     *
+     * @returns Startup timing breakdown
+     */
+    StartupTiming getStartupTiming() const;
+
     /**
      * Get device name if available
      * @returns device name or empty string if not available
@@ -955,6 +982,7 @@ class DeviceBase {
 
     DeviceInfo deviceInfo = {};
     tl::optional<Version> bootloaderVersion;
+    StartupTiming startupTiming;
 
     // Log callback
     int uniqueCallbackId = 0;
@@ -0,0 +1,107 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// project
+#include "depthai/device/Device.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/xlink/XLinkConnection.hpp"
+
+// libraries
+#include "tl/optional.hpp"
+
+namespace dai {
+
+/**
+ * Opens multiple devices at once. Firmware is prepared once for the whole group, after which devices are booted,
+ * connected to and started concurrently, each on its own thread, so opening N devices takes about as long as the slowest one.
+ */
+class DeviceGroup {
+   public:
+    /**
+     * Opens devices concurrently, booting them with the same configuration.
+     * If any device fails to open, the others are closed and an exception listing the failures is thrown
+     *
+     * @param devices Devices to open
+     * @param config Config with which the devices are booted
+     */
+    DeviceGroup(const std::vector<DeviceInfo>& devices, Device::Config config);
+
+    /**
+     * Opens devices concurrently and starts the pipeline on each.
+     * If any device fails to open, the others are closed and an exception listing the failures is thrown
+     *
+     * @param devices Devices to open
+     * @param pipeline Pipeline to be executed on each device
+     */
+    DeviceGroup(const std::vector<DeviceInfo>& devices, const Pipeline& pipeline);
+
+    DeviceGroup(const DeviceGroup&) = delete;
+    DeviceGroup& operator=(const DeviceGroup&) = delete;
+
+    /**
+     * Closes all devices concurrently
+     */
+    ~DeviceGroup();
+
+    /**
+     * Get number of devices in the group
+     *
+     * @returns Number of devices
+     */
+    std::size_t size() const;
+
+    /**
+     * Get a device, in the order given to the constructor
+     *
+     * @param index Index of the device
+     * @returns Device
+     */
+    std::shared_ptr<Device> getDevice(std::size_t index) const;
+
+    /**
+     * Get all devices, in the order given to the constructor
+     *
+     * @returns Devices
+     */
+    const std::vector<std::shared_ptr<Device>>& getDevices() const;
+
+    /**
+     * Get time taken by phases of startup of each device, in the order given to the constructor
+     *
+     * @returns Startup timing breakdowns
+     */
+    std::vector<DeviceBase::StartupTiming> getStartupTimings() const;
+
+    /**
+     * Get time taken to prepare the firmware shared by the group, before devices were opened
+     *
+     * @returns Firmware preparation time
+     */
+    std::chrono::nanoseconds getFirmwarePreparationTime() const;
+
+    /**
+     * Get time taken to open the whole group
+     *
+     * @returns Total startup time
+     */
+    std::chrono::nanoseconds getStartupTime() const;
+
+    /**
+     * Closes all devices concurrently
+     */
+    void close();
+
+   private:
+    std::vector<std::shared_ptr<Device>> devices;
+    std::chrono::nanoseconds firmwarePreparationTime{0};
+    std::chrono::nanoseconds startupTime{0};
+
+    void open(const std::vector<DeviceInfo>& devicesToOpen, const Device::Config& config, tl::optional<const Pipeline&> pipeline);
+};
+
+}  // namespace dai
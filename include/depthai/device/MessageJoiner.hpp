@@ -0,0 +1,157 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "depthai/utility/Histogram.hpp"
+
+namespace dai {
+
+/**
+ * Joins messages of multiple streams on the host by timestamp, into MessageGroups (named by stream).
+ * Host side counterpart of the Sync node, for output queues of one or more devices.
+ *
+ * Messages are buffered per stream, ordered by timestamp. Once every stream has a message, the latest of the oldest
+ * messages is taken as reference and each stream contributes its message nearest to it (found by binary search).
+ * If all of them are within threshold, they form a group. Otherwise messages too old to ever match are dropped and
+ * matching is retried. Messages of a stream older than its last grouped message are dropped as well.
+ */
+class MessageJoiner {
+   public:
+    /// Which timestamp messages are joined by
+    enum class TimestampSource {
+        /// Buffer::getTimestampDevice, device's monotonic clock. Only comparable between streams of a single device
+        DEVICE,
+        /// Buffer::getTimestamp, synchronized to host time
+        HOST
+    };
+
+    /// What happens to a message which waited for other streams longer than the timeout
+    enum class TimeoutPolicy {
+        /// Drop it
+        DROP,
+        /// Emit it in a group together with matching messages of streams which have one, without the other streams
+        EMIT_PARTIAL
+    };
+
+    struct Config {
+        /// Maximum interval between the first and the last message of a group
+        std::chrono::nanoseconds threshold = std::chrono::milliseconds(10);
+        TimestampSource timestampSource = TimestampSource::DEVICE;
+        /// Maximum number of buffered messages per stream, oldest are dropped beyond it
+        std::size_t maxBufferSize = 8;
+        /// How long a message waits for other streams (since it was pushed), checked whenever a message is pushed. 0 waits indefinitely
+        std::chrono::milliseconds timeout{0};
+        TimeoutPolicy timeoutPolicy = TimeoutPolicy::DROP;
+        /// Maximum number of groups waiting to be retrieved, oldest are dropped beyond it
+        unsigned maxGroups = 4;
+    };
+
+    struct Stats {
+        /// Number of groups emitted, including partial groups
+        std::uint64_t numGroups = 0;
+        /// Number of groups emitted without some of the streams, after a timeout
+        std::uint64_t numPartialGroups = 0;
+        /// Number of messages which didn't make it into any group
+        std::uint64_t numDropped = 0;
+        /// Interval between the first and the last message of each group
+        Histogram::Snapshot interval;
+    };
+
+    /**
+     * @param streams Names of streams to join, which are also names of messages in emitted groups
+     */
+    explicit MessageJoiner(std::vector<std::string> streams);
+
+    /**
+     * @param streams Names of streams to join, which are also names of messages in emitted groups
+     * @param config Joining configuration
+     */
+    MessageJoiner(std::vector<std::string> streams, Config config);
+    MessageJoiner(const MessageJoiner&) = delete;
+    MessageJoiner& operator=(const MessageJoiner&) = delete;
+
+    /**
+     * Removes callbacks from added queues
+     */
+    ~MessageJoiner();
+
+    /**
+     * Joins messages received by an output queue, by adding a callback to it
+     *
+     * @param queue Output queue
+     * @param stream Stream name the messages belong to. Defaults to queue name
+     */
+    void addQueue(const std::shared_ptr<DataOutputQueue>& queue, const std::string& stream = "");
+
+    /**
+     * Adds a message of a stream, possibly completing a group
+     *
+     * @param stream Stream name
+     * @param msg Message, deriving from Buffer
+     */
+    void push(const std::string& stream, std::shared_ptr<ADatatype> msg);
+
+    /**
+     * Sets a callback called with each emitted group, in sequence order, on a thread pushing messages.
+     * Groups completed while another thread is handing groups out are handed out by that thread.
+     * Groups are also available through get/tryGet
+     *
+     * @param callback Callback or nullptr
+     */
+    void setCallback(std::function<void(std::shared_ptr<MessageGroup>)> callback);
+
+    /**
+     * Try to retrieve a group. If none available, return immediately with nullptr
+     *
+     * @returns Group or nullptr if none available
+     */
+    std::shared_ptr<MessageGroup> tryGet();
+
+    /**
+     * Block until a group is available
+     *
+     * @returns Group
+     */
+    std::shared_ptr<MessageGroup> get();
+
+    /**
+     * Block until a group is available with a timeout
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Group or nullptr if timeout occurred
+     */
+    std::shared_ptr<MessageGroup> get(std::chrono::milliseconds timeout, bool& hasTimedout);
+
+    /**
+     * Gets statistics since the joiner was created
+     *
+     * @returns Joining statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * Gets names of joined streams
+     *
+     * @returns Stream names
+     */
+    std::vector<std::string> getStreams() const;
+
+   private:
+    struct State;
+    // Shared with queue callbacks, which may still run while the joiner is destroyed
+    std::shared_ptr<State> state;
+    std::vector<std::pair<std::weak_ptr<DataOutputQueue>, DataOutputQueue::CallbackId>> queueCallbacks;
+};
+
+}  // namespace dai
@@ -0,0 +1,102 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Dispatches "message received" events of output queues to threads waiting on a subset of queues (Device::getQueueEvents).
+ *
+ * Queues are registered once and referred to by integer ids. Pending events are kept per queue (ordered by a global
+ * sequence number), so waiting on some queues never scans events of others. Each waiting thread has its own condition
+ * variable and an event only wakes a single waiter interested in its queue, instead of all of them.
+ */
+class QueueEventDispatcher {
+   public:
+    using QueueId = std::size_t;
+
+    /**
+     * @param maxEvents Maximum number of pending events, over all queues. Oldest events are discarded beyond it
+     */
+    explicit QueueEventDispatcher(std::size_t maxEvents);
+    QueueEventDispatcher(const QueueEventDispatcher&) = delete;
+    QueueEventDispatcher& operator=(const QueueEventDispatcher&) = delete;
+
+    /**
+     * Registers a queue. Registering the same name again returns the existing id
+     *
+     * @param name Queue name
+     * @returns Id of the queue
+     */
+    QueueId addQueue(const std::string& name);
+
+    /**
+     * Unregisters all queues and discards their pending events. Waiting threads aren't woken
+     */
+    void clear();
+
+    /**
+     * Looks up a queue id
+     *
+     * @param name Queue name
+     * @param[out] id Id of the queue, if registered
+     * @returns True if the queue is registered, false otherwise
+     */
+    bool findQueue(const std::string& name, QueueId& id) const;
+
+    /**
+     * Adds an event for given queue and wakes a thread waiting on it (if any)
+     *
+     * @param id Id of the queue which received a message
+     */
+    void push(QueueId id);
+
+    /**
+     * Removes pending events of given queues, in the order they were pushed.
+     * Blocks until at least one event is available or timeout expires
+     *
+     * @param ids Ids of queues of interest
+     * @param maxNumEvents Maximum number of events to remove
+     * @param timeout Timeout after which return regardless. If negative then wait is indefinite
+     * @returns Names of queues which received messages, one per event. Empty if timeout expired
+     */
+    std::vector<std::string> wait(const std::vector<QueueId>& ids, std::size_t maxNumEvents, std::chrono::microseconds timeout);
+
+    /**
+     * @returns Number of pending events, over all queues
+     */
+    std::size_t getNumPending() const;
+
+   private:
+    struct Waiter {
+        // Indexed by queue id
+        std::vector<bool> interest;
+        std::condition_variable cv;
+        bool signaled = false;
+    };
+
+    const std::size_t maxEvents;
+    mutable std::mutex mtx;
+    std::unordered_map<std::string, QueueId> ids;
+    std::vector<std::string> names;
+    // Sequence numbers of pending events, per queue
+    std::vector<std::deque<std::uint64_t>> pending;
+    std::size_t numPending = 0;
+    std::uint64_t sequence = 0;
+    std::vector<Waiter*> waiters;
+
+    void discardOldest();
+    void notifyOne(QueueId id);
+    void collect(const std::vector<QueueId>& ids, std::size_t maxNumEvents, std::vector<std::string>& events);
+};
+
+}  // namespace dai
@@ -0,0 +1,260 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/pipeline/datatype/ADatatype.hpp"
+
+namespace dai {
+
+/**
+ * Statically typed view of a DataOutputQueue, for streams carrying messages of type T (eg. ImgFrame).
+ *
+ * Instead of a dynamic cast per message, the message type (DatatypeEnum) is checked once when first received
+ * and following messages of the same type are cast statically. Receiving a message which isn't a T throws,
+ * after the message was removed from the queue (batch getters first retrieve the remaining messages).
+ * getAll/tryGetAll can also fill a caller provided vector, to avoid allocating one per call.
+ * Views are cheap to copy, multiple views can share the same queue.
+ */
+template <class T>
+class TypedOutputQueue {
+    static_assert(std::is_base_of<ADatatype, T>::value, "T must be a message type (derived from ADatatype)");
+
+    std::shared_ptr<DataOutputQueue> queue;
+    // Last message type verified to be a T, -1 if none yet
+    mutable std::atomic<std::int32_t> checkedType{-1};
+
+    // Returns whether 'msg' is a T, remembering its type if so
+    bool check(const ADatatype& msg) const {
+        const auto type = static_cast<std::int32_t>(msg.raw->getType());
+        if(type == checkedType.load(std::memory_order_relaxed)) return true;
+        if(dynamic_cast<const T*>(&msg) == nullptr) return false;
+        checkedType.store(type, std::memory_order_relaxed);
+        return true;
+    }
+
+    void throwMismatch(std::int32_t type) const {
+        throw std::runtime_error("Queue '" + queue->getName() + "' received a message of type " + std::to_string(type)
+                                 + ", which doesn't match the type of the queue view");
+    }
+
+    std::shared_ptr<T> cast(std::shared_ptr<ADatatype>&& msg) const {
+        if(msg == nullptr) return nullptr;
+        if(!check(*msg)) throwMismatch(static_cast<std::int32_t>(msg->raw->getType()));
+        return std::static_pointer_cast<T>(std::move(msg));
+    }
+
+    // Returns a callback which appends messages to 'messages'. Doesn't throw, as the queue only removes messages
+    // once they were consumed. Messages of another type are dropped instead, the first one's type stored in 'mismatchedType'
+    std::function<void(std::shared_ptr<ADatatype>&)> appendTo(std::vector<std::shared_ptr<T>>& messages, std::int32_t& mismatchedType) const {
+        return [this, &messages, &mismatchedType](std::shared_ptr<ADatatype>& msg) {
+            if(!check(*msg)) {
+                if(mismatchedType < 0) mismatchedType = static_cast<std::int32_t>(msg->raw->getType());
+                return;
+            }
+            msg->decodeMetadata();
+            messages.push_back(std::static_pointer_cast<T>(std::move(msg)));
+        };
+    }
+
+   public:
+    /**
+     * Creates a typed view of a queue
+     * @param queue Output queue carrying messages of type T
+     */
+    explicit TypedOutputQueue(std::shared_ptr<DataOutputQueue> queue) : queue(std::move(queue)) {
+        if(this->queue == nullptr) throw std::invalid_argument("DataOutputQueue passed is not valid (nullptr)");
+    }
+
+    TypedOutputQueue(const TypedOutputQueue& other) : queue(other.queue), checkedType(other.checkedType.load()) {}
+
+    TypedOutputQueue& operator=(const TypedOutputQueue& other) {
+        queue = other.queue;
+        checkedType = other.checkedType.load();
+        return *this;
+    }
+
+    /**
+     * Gets the underlying (untyped) queue
+     */
+    const std::shared_ptr<DataOutputQueue>& getQueue() const {
+        return queue;
+    }
+
+    /**
+     * Gets queues name
+     *
+     * @returns Queue name
+     */
+    std::string getName() const {
+        return queue->getName();
+    }
+
+    /**
+     * Check whether front of the queue has a message (isn't empty)
+     * @returns True if queue isn't empty, false otherwise
+     */
+    bool has() const {
+        return queue->has();
+    }
+
+    /**
+     * Try to retrieve a message from the queue. If no message available, return immediately with nullptr
+     *
+     * @returns Message or nullptr if no message available
+     */
+    std::shared_ptr<T> tryGet() const {
+        return cast(queue->tryGet());
+    }
+
+    /**
+     * Block until a message is available.
+     *
+     * @returns Message
+     */
+    std::shared_ptr<T> get() const {
+        return cast(queue->get());
+    }
+
+    /**
+     * Block until a message is available with a timeout.
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Message or nullptr if timeout occurred
+     */
+    template <typename Rep, typename Period>
+    std::shared_ptr<T> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) const {
+        return cast(queue->get(timeout, hasTimedout));
+    }
+
+    /**
+     * Gets first message in the queue.
+     *
+     * @returns Message or nullptr if no message available
+     */
+    std::shared_ptr<T> front() const {
+        return cast(queue->front());
+    }
+
+    /**
+     * Try to retrieve all messages in the queue, appending them to 'messages'.
+     * Messages of another type are removed as well and reported by throwing, after all others were appended.
+     * Reusing the same vector (after clearing it) avoids an allocation per call
+     *
+     * @param[out] messages Vector to which messages are appended
+     * @returns Number of messages retrieved
+     */
+    std::size_t tryGetAll(std::vector<std::shared_ptr<T>>& messages) const {
+        const auto size = messages.size();
+        std::int32_t mismatchedType = -1;
+        queue->consumeAll(appendTo(messages, mismatchedType));
+        if(mismatchedType >= 0) throwMismatch(mismatchedType);
+        return messages.size() - size;
+    }
+
+    /**
+     * Try to retrieve all messages in the queue.
+     *
+     * @returns Vector of messages
+     */
+    std::vector<std::shared_ptr<T>> tryGetAll() const {
+        std::vector<std::shared_ptr<T>> messages;
+        tryGetAll(messages);
+        return messages;
+    }
+
+    /**
+     * Block until at least one message in the queue, then retrieve all messages, appending them to 'messages'.
+     * Messages of another type are removed as well and reported by throwing, after all others were appended.
+     * Reusing the same vector (after clearing it) avoids an allocation per call
+     *
+     * @param[out] messages Vector to which messages are appended
+     * @returns Number of messages retrieved
+     */
+    std::size_t getAll(std::vector<std::shared_ptr<T>>& messages) const {
+        const auto size = messages.size();
+        std::int32_t mismatchedType = -1;
+        queue->waitAndConsumeAll(appendTo(messages, mismatchedType));
+        if(mismatchedType >= 0) throwMismatch(mismatchedType);
+        return messages.size() - size;
+    }
+
+    /**
+     * Block until at least one message in the queue.
+     * Then return all messages from the queue.
+     *
+     * @returns Vector of messages
+     */
+    std::vector<std::shared_ptr<T>> getAll() const {
+        std::vector<std::shared_ptr<T>> messages;
+        getAll(messages);
+        return messages;
+    }
+
+    /**
+     * Block for maximum timeout duration, then retrieve all messages, appending them to 'messages'.
+     * Messages of another type are removed as well and reported by throwing, after all others were appended.
+     *
+     * @param[out] messages Vector to which messages are appended
+     * @param timeout Maximum duration to block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Number of messages retrieved
+     */
+    template <typename Rep, typename Period>
+    std::size_t getAll(std::vector<std::shared_ptr<T>>& messages, std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) const {
+        const auto size = messages.size();
+        std::int32_t mismatchedType = -1;
+        hasTimedout = !queue->waitAndConsumeAll(appendTo(messages, mismatchedType), timeout);
+        if(mismatchedType >= 0) throwMismatch(mismatchedType);
+        return messages.size() - size;
+    }
+
+    /**
+     * Block for maximum timeout duration.
+     * Then return all messages from the queue.
+     * @param timeout Maximum duration to block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Vector of messages
+     */
+    template <typename Rep, typename Period>
+    std::vector<std::shared_ptr<T>> getAll(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) const {
+        std::vector<std::shared_ptr<T>> messages;
+        getAll(messages, timeout, hasTimedout);
+        return messages;
+    }
+
+    /**
+     * Adds a callback on message received
+     *
+     * @param callback Callback function with message pointer
+     * @returns Callback id
+     */
+    DataOutputQueue::CallbackId addCallback(std::function<void(std::shared_ptr<T>)> callback) const {
+        // Captures a copy of the view, which stays valid as long as the callback
+        auto view = *this;
+        return queue->addCallback([view, callback = std::move(callback)](std::shared_ptr<ADatatype> msg) { callback(view.cast(std::move(msg))); });
+    }
+
+    /**
+     * Removes a callback
+     *
+     * @param callbackId Id of callback to be removed
+     * @returns True if callback was removed, false otherwise
+     */
+    bool removeCallback(DataOutputQueue::CallbackId callbackId) const {
+        return queue->removeCallback(callbackId);
+    }
+};
+
+}  // namespace dai
@@ -3,13 +3,16 @@
 #include <algorithm>
 #include <exception>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "depthai-shared/common/TensorInfo.hpp"
+#include "depthai/utility/Memory.hpp"
 #include "depthai/utility/Path.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
@@ -27,6 +30,15 @@ class OpenVINO {
          * @param data In memory blob
          */
         Blob(std::vector<uint8_t> data);
+        /**
+         * @brief Construct a new Blob referencing memory (eg. MappedFile), without copying it.
+         * Memory is referenced for as long as the Blob, or a Pipeline it was given to, exists.
+         * A mapped file must not be truncated or rewritten meanwhile, as accessing it would then fail (SIGBUS).
+         * 'data' is left empty, use getData() to access the blob
+         *
+         * @param memory Memory holding the blob
+         */
+        Blob(std::shared_ptr<Memory> memory);
         /**
          * @brief Construct a new Blob by loading from a filesystem path
          *
@@ -34,6 +46,11 @@ class OpenVINO {
          */
         Blob(const dai::Path& path);
 
+        /**
+         * @returns Blob data, either from 'memory' if set or from 'data'
+         */
+        span<const uint8_t> getData() const;
+
         /// OpenVINO version
         Version version;
         /// Map of input names to additional information
@@ -48,6 +65,8 @@ class OpenVINO {
         uint32_t numSlices = 0;
         /// Blob data
         std::vector<uint8_t> data;
+        /// Memory holding blob data instead of 'data' (eg. a mapped file)
+        std::shared_ptr<Memory> memory;
     };
 
     /// Main OpenVINO version
@@ -2,10 +2,13 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "depthai-shared/pipeline/Assets.hpp"
+#include "depthai/utility/Memory.hpp"
 #include "depthai/utility/Path.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
@@ -17,8 +20,77 @@ struct Asset {
     explicit Asset(std::string k) : key(std::move(k)) {}
     const std::string key;
     std::vector<std::uint8_t> data;
+    /// Memory holding the asset data instead of 'data' (eg. a mapped file). Referenced, not copied
+    std::shared_ptr<Memory> memory;
     std::uint32_t alignment = 1;
     std::string getRelativeUri();
+
+    /**
+     * @returns Asset data, either from 'memory' if set or from 'data'
+     */
+    span<const std::uint8_t> getData() const;
+
+    /**
+     * @returns Size of asset data in bytes
+     */
+    std::size_t getSize() const;
+};
+
+/**
+ * @brief Serialized asset storage, which references asset data instead of copying it
+ *
+ * Assets are kept alive by the storage. Padding between them is not stored, but produced when reading.
+ * Identical assets (eg. same blob used by multiple nodes) are stored once, found by size and content hash.
+ */
+class AssetStorage {
+    struct Entry {
+        std::shared_ptr<const Asset> asset;
+        std::size_t offset;
+        std::uint32_t hash;
+        bool hashed;
+    };
+    std::vector<Entry> entries;
+    std::unordered_multimap<std::size_t, std::size_t> entriesBySize;
+    std::vector<std::uint8_t> padding;
+    std::size_t storageSize = 0;
+    std::size_t deduplicatedSize = 0;
+
+   public:
+    /**
+     * Appends an asset at the next offset satisfying its alignment.
+     * If an identical asset with compatible alignment is already stored, its offset is returned instead
+     * @param asset Asset to append
+     * @returns Offset of the asset in storage
+     */
+    std::size_t append(std::shared_ptr<const Asset> asset);
+
+    /**
+     * @returns Number of bytes not stored, because identical assets were already present
+     */
+    std::size_t getDeduplicatedSize() const;
+
+    /**
+     * @returns Size of storage in bytes, including padding
+     */
+    std::size_t size() const;
+
+    /**
+     * @returns True if storage is empty
+     */
+    bool empty() const;
+
+    /**
+     * Retrieves a range of storage as segments referencing asset data (and padding)
+     * @param offset Offset of the range
+     * @param size Size of the range
+     * @returns Segments which together make up the range
+     */
+    std::vector<span<const std::uint8_t>> getSegments(std::size_t offset, std::size_t size) const;
+
+    /**
+     * @returns Copy of whole storage in a contiguous buffer
+     */
+    std::vector<std::uint8_t> toVector() const;
 };
 
 class AssetsMutable : public Assets {
@@ -77,6 +149,18 @@ class AssetManager /*: public Assets*/ {
     std::shared_ptr<dai::Asset> set(const std::string& key, const std::vector<std::uint8_t>& data, int alignment = 64);
     std::shared_ptr<dai::Asset> set(const std::string& key, std::vector<std::uint8_t>&& data, int alignment = 64);
 
+    /**
+     * Adds asset referencing memory (eg. MappedFile) under specified key, without copying it.
+     * Memory is referenced for as long as the asset, or a Pipeline holding it, exists.
+     * A mapped file must not be truncated or rewritten meanwhile, as accessing it would then fail (SIGBUS).
+     *
+     * @param key Key under which the asset should be stored
+     * @param memory Memory holding asset data
+     * @param alignment [Optional] alignment of asset data in asset storage. Default is 64B
+     * @returns Shared pointer to asset
+     */
+    std::shared_ptr<dai::Asset> set(const std::string& key, std::shared_ptr<Memory> memory, int alignment = 64);
+
     /**
      * @returns Asset assigned to the specified key or a nullptr otherwise
      */
@@ -110,6 +194,8 @@ class AssetManager /*: public Assets*/ {
 
     /// Serializes
     void serialize(AssetsMutable& assets, std::vector<std::uint8_t>& assetStorage, std::string prefix = "") const;
+    /// Serializes, referencing asset data in storage instead of copying it
+    void serialize(AssetsMutable& assets, AssetStorage& assetStorage, std::string prefix = "") const;
 };
 
 }  // namespace dai
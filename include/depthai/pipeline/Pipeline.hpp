@@ -53,6 +53,7 @@ class PipelineImpl {
     std::shared_ptr<Node> getNode(Node::Id id);
 
     void serialize(PipelineSchema& schema, Assets& assets, std::vector<std::uint8_t>& assetStorage, SerializationType type = DEFAULT_SERIALIZATION_TYPE) const;
+    void serialize(PipelineSchema& schema, Assets& assets, AssetStorage& assetStorage, SerializationType type = DEFAULT_SERIALIZATION_TYPE) const;
     nlohmann::json serializeToJson() const;
     void remove(std::shared_ptr<Node> node);
 
@@ -131,6 +132,11 @@ class Pipeline {
         impl()->serialize(schema, assets, assetStorage);
     }
 
+    /// Serializes pipeline, referencing asset data in 'assetStorage' instead of copying it
+    void serialize(PipelineSchema& schema, Assets& assets, AssetStorage& assetStorage) const {
+        impl()->serialize(schema, assets, assetStorage);
+    }
+
     /// Returns whole pipeline represented as JSON
     nlohmann::json serializeToJson() const {
         return impl()->serializeToJson();
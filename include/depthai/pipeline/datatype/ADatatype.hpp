@@ -4,6 +4,8 @@
 #include <vector>
 
 #include "depthai-shared/datatype/RawBuffer.hpp"
+#include "depthai/utility/DeferredMetadata.hpp"
+#include "depthai/utility/Memory.hpp"
 
 namespace dai {
 
@@ -11,14 +13,53 @@ namespace dai {
 class ADatatype {
    protected:
     friend class DataInputQueue;
+    friend class DataOutputQueue;
     friend class StreamMessageParser;
+    friend class MessageGroup;
+    template <class T>
+    friend class TypedOutputQueue;
     std::shared_ptr<RawBuffer> raw;
+    // Memory backing 'raw->data' when message was received without copying its data
+    std::shared_ptr<AdoptedMemory> adopted;
+    // Metadata decoded into 'raw' on first access, when message was parsed lazily
+    std::shared_ptr<DeferredMetadata> deferred;
+
+    /**
+     * Decodes deferred metadata (if any) into 'raw'
+     */
+    void decodeMetadata() const {
+        if(deferred) deferred->decode(*raw);
+    }
+
+    /**
+     * Copies adopted memory (if any) into 'raw->data'
+     */
+    void copyAdoptedData() const {
+        if(adopted) adopted->copyTo(raw->data);
+    }
+
+    /**
+     * Discards adopted memory (if any), as 'raw->data' is about to be replaced
+     */
+    void discardAdoptedData() const {
+        if(adopted) adopted->discard();
+    }
+
+    /**
+     * @returns View of message data, without copying adopted memory
+     */
+    span<std::uint8_t> getRawDataView() const {
+        if(adopted) return adopted->view(raw->data);
+        return {raw->data.data(), raw->data.size()};
+    }
 
    public:
     explicit ADatatype(std::shared_ptr<RawBuffer> r) : raw(std::move(r)) {}
     virtual ~ADatatype() = default;
     virtual std::shared_ptr<dai::RawBuffer> serialize() const = 0;
     std::shared_ptr<RawBuffer> getRaw() const {
+        decodeMetadata();
+        copyAdoptedData();
         return raw;
     }
 };
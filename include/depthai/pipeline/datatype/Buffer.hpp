@@ -26,6 +26,13 @@ class Buffer : public ADatatype {
      */
     std::vector<std::uint8_t>& getData() const;
 
+    /**
+     * @brief Get non-owning view of internal buffer.
+     * Unlike getData(), doesn't copy data of messages received without copying (see DataOutputQueue::setZeroCopy)
+     * @returns View of internal buffer, valid for the lifetime of this message or until data is modified
+     */
+    span<const std::uint8_t> getDataView() const;
+
     /**
      * @param data Copies data to internal buffer
      */
@@ -34,8 +34,7 @@ class MessageGroup : public Buffer {
     template <typename T>
     void add(const std::string& name, const T& value) {
         static_assert(std::is_base_of<ADatatype, T>::value, "T must derive from ADatatype");
-        group[name] = std::make_shared<T>(value);
-        rawGrp.group[name] = {value.getRaw(), 0};
+        add(name, std::static_pointer_cast<ADatatype>(std::make_shared<T>(value)));
     }
 
     // Iterators
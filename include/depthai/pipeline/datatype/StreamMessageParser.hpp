@@ -10,6 +10,8 @@
 #include "depthai-shared/datatype/DatatypeEnum.hpp"
 #include "depthai-shared/datatype/RawMessageGroup.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/utility/MessagePool.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
 
 // shared
 #include "depthai-shared/datatype/RawBuffer.hpp"
@@ -22,7 +24,32 @@ class StreamMessageParser {
    public:
     static std::shared_ptr<RawBuffer> parseMessage(streamPacketDesc_t* const packet);
     static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet);
-    static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& type);
+    /**
+     * Parses a message, copying its data
+     * @param pool Optional pool to acquire Raw* objects from
+     * @param lazyMetadata Keep metadata serialized until first accessed through getRaw or when handed out by DataOutputQueue
+     */
+    static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet,
+                                                              DatatypeEnum& type,
+                                                              const std::shared_ptr<MessagePool>& pool = nullptr,
+                                                              bool lazyMetadata = false);
+    /**
+     * Parses a message, taking ownership of the packet.
+     * Data of Buffer, ImgFrame and EncodedFrame messages isn't copied, but adopted from the packet instead
+     * @param pool Optional pool to acquire Raw* objects from
+     * @param lazyMetadata Keep metadata serialized until first accessed through getRaw or when handed out by DataOutputQueue
+     */
+    static std::shared_ptr<ADatatype> parseMessageToADatatype(StreamPacketDesc&& packet);
+    static std::shared_ptr<ADatatype> parseMessageToADatatype(StreamPacketDesc&& packet,
+                                                              DatatypeEnum& type,
+                                                              const std::shared_ptr<MessagePool>& pool = nullptr,
+                                                              bool lazyMetadata = false);
+    /**
+     * Serializes everything that follows message data in a packet (metadata, type, metadata size and marker).
+     * Sending data followed by the serialized metadata as a single packet equals sending serializeMessage
+     */
+    static std::vector<std::uint8_t> serializeMetadata(const std::shared_ptr<const RawBuffer>& data);
+    static std::vector<std::uint8_t> serializeMetadata(const RawBuffer& data);
     static std::vector<std::uint8_t> serializeMessage(const std::shared_ptr<const RawBuffer>& data);
     static std::vector<std::uint8_t> serializeMessage(const RawBuffer& data);
     static std::vector<std::uint8_t> serializeMessage(const std::shared_ptr<const ADatatype>& data);
@@ -0,0 +1,213 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "depthai/utility/QueueStats.hpp"
+
+namespace dai {
+
+/**
+ * Queue which only keeps the latest element, with the same interface as LockingQueue.
+ *
+ * Pushing atomically swaps the new element into a single slot, overwriting (and counting) the previous one
+ * if it wasn't consumed yet. Pushing never blocks and popping never waits for the producer:
+ * both are a single atomic exchange of the slot (std::atomic_exchange on a shared_ptr, which standard libraries
+ * guard with a short internal lock). Peeking (front) reads the slot in place, so it never appears empty meanwhile.
+ * A mutex/condition variable is only used to sleep while the slot is empty.
+ * maxSize and blocking are accepted for interface compatibility, but the queue always behaves as
+ * a non-blocking queue of size 1.
+ */
+template <typename T>
+class ConflatingQueue {
+   public:
+    ConflatingQueue() = default;
+    ConflatingQueue(const ConflatingQueue&) = delete;
+    ConflatingQueue& operator=(const ConflatingQueue&) = delete;
+
+    void setMaxSize(unsigned) {}
+
+    void setBlocking(bool) {}
+
+    unsigned getMaxSize() const {
+        return 1;
+    }
+
+    bool getBlocking() const {
+        return false;
+    }
+
+    /**
+     * @returns Number of elements overwritten before they were consumed
+     */
+    std::uint64_t getNumOverwritten() const {
+        return numOverwritten;
+    }
+
+    /**
+     * @returns Statistics since the queue was created. Element sizes aren't measured
+     */
+    QueueStats getStats() const {
+        QueueStats stats;
+        stats.numPushed = numPushed;
+        stats.numPopped = numPopped;
+        stats.numDropped = numOverwritten;
+        stats.maxQueued = stats.numPushed > 0 ? 1 : 0;
+        stats.dwellTime = dwellTime.getSnapshot();
+        return stats;
+    }
+
+    void destruct() {
+        std::unique_lock<std::mutex> lock(waitMtx);
+        if(!destructed) {
+            destructed = true;
+            signalPop.notify_all();
+            signalPush.notify_all();
+        }
+    }
+
+    template <typename Rep, typename Period>
+    bool waitAndConsumeAll(std::function<void(std::shared_ptr<T>&)> callback, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(true) {
+            if(!waitPush(deadline)) return false;
+            if(destructed) return false;
+            if(consumeAll(callback)) return true;
+        }
+    }
+
+    bool waitAndConsumeAll(std::function<void(std::shared_ptr<T>&)> callback) {
+        while(true) {
+            waitPush();
+            if(destructed) return false;
+            if(consumeAll(callback)) return true;
+        }
+    }
+
+    bool consumeAll(std::function<void(std::shared_ptr<T>&)> callback) {
+        std::shared_ptr<T> value;
+        if(!tryPop(value)) return false;
+        callback(value);
+        return true;
+    }
+
+    bool push(std::shared_ptr<T> const& data) {
+        if(destructed) return false;
+        numPushed++;
+        auto element = std::make_shared<Element>();
+        element->value = data;
+        element->pushed = std::chrono::steady_clock::now();
+        if(std::atomic_exchange(&slot, std::move(element)) != nullptr) numOverwritten++;
+
+        // Only touch the mutex if a consumer is sleeping
+        if(numWaitingConsumers > 0) {
+            std::lock_guard<std::mutex> lock(waitMtx);
+            signalPush.notify_all();
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPush(std::shared_ptr<T> const& data, std::chrono::duration<Rep, Period>) {
+        // Never waits
+        return push(data);
+    }
+
+    bool empty() const {
+        return std::atomic_load(&slot) == nullptr;
+    }
+
+    bool front(std::shared_ptr<T>& value) {
+        // Shares ownership of the element, so it stays valid even if it's popped or overwritten meanwhile
+        const auto element = std::atomic_load(&slot);
+        if(element == nullptr) return false;
+        value = element->value;
+        return true;
+    }
+
+    bool tryPop(std::shared_ptr<T>& value) {
+        const auto taken = std::atomic_exchange(&slot, std::shared_ptr<Element>());
+        if(taken == nullptr) return false;
+        value = std::move(taken->value);
+        dwellTime.record(std::chrono::steady_clock::now() - taken->pushed);
+        numPopped++;
+
+        if(numWaitingProducers > 0) {
+            std::lock_guard<std::mutex> lock(waitMtx);
+            signalPop.notify_all();
+        }
+        return true;
+    }
+
+    bool waitAndPop(std::shared_ptr<T>& value) {
+        while(true) {
+            waitPush();
+            if(destructed) return false;
+            if(tryPop(value)) return true;
+        }
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPop(std::shared_ptr<T>& value, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(true) {
+            if(!waitPush(deadline)) return false;
+            if(destructed) return false;
+            if(tryPop(value)) return true;
+        }
+    }
+
+    void waitEmpty() {
+        if(empty()) return;
+        std::unique_lock<std::mutex> lock(waitMtx);
+        numWaitingProducers++;
+        signalPop.wait(lock, [this]() { return empty() || destructed; });
+        numWaitingProducers--;
+    }
+
+   private:
+    struct Element {
+        std::shared_ptr<T> value;
+        std::chrono::steady_clock::time_point pushed;
+    };
+
+    // Latest element. Accessed with std::atomic_load/std::atomic_exchange, as a whole, so readers never see a partially written element
+    std::shared_ptr<Element> slot;
+    std::atomic<std::uint64_t> numOverwritten{0};
+    std::atomic<std::uint64_t> numPushed{0};
+    std::atomic<std::uint64_t> numPopped{0};
+    Histogram dwellTime;
+    std::atomic<bool> destructed{false};
+
+    // Only used to sleep when there is nothing to do
+    std::mutex waitMtx;
+    std::condition_variable signalPop;
+    std::condition_variable signalPush;
+    std::atomic<int> numWaitingConsumers{0};
+    std::atomic<int> numWaitingProducers{0};
+
+    // Sleeps until the slot isn't empty or the queue is destructed
+    void waitPush() {
+        if(!empty() || destructed) return;
+        std::unique_lock<std::mutex> lock(waitMtx);
+        numWaitingConsumers++;
+        signalPush.wait(lock, [this]() { return !empty() || destructed; });
+        numWaitingConsumers--;
+    }
+
+    // Returns false if deadline passed before the slot wasn't empty (or the queue was destructed)
+    bool waitPush(std::chrono::steady_clock::time_point deadline) {
+        if(!empty() || destructed) return true;
+        std::unique_lock<std::mutex> lock(waitMtx);
+        numWaitingConsumers++;
+        bool pred = signalPush.wait_until(lock, deadline, [this]() { return !empty() || destructed; });
+        numWaitingConsumers--;
+        return pred;
+    }
+};
+
+}  // namespace dai
@@ -0,0 +1,53 @@
+#pragma once
+
+// std
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// shared
+#include "depthai-shared/datatype/RawBuffer.hpp"
+
+namespace dai {
+
+/**
+ * Serialized message metadata, decoded into its message on first access instead of when received.
+ * Messages which are never accessed (eg. dropped by a non-blocking queue) don't pay for decoding.
+ */
+class DeferredMetadata {
+   public:
+    /// Decodes serialized metadata into a Raw* object of the matching type
+    using Decoder = void (*)(std::uint8_t* metadata, std::size_t size, RawBuffer& raw);
+
+   private:
+    std::mutex mtx;
+    std::vector<std::uint8_t> metadata;
+    Decoder decoder;
+    bool decoded{false};
+
+   public:
+    DeferredMetadata(const std::uint8_t* data, std::size_t size, Decoder decoder) : metadata(data, data + size), decoder(decoder) {}
+
+    /**
+     * Decodes metadata into 'raw' if not yet done
+     * @param raw Raw object of the message which deferred decoding
+     */
+    void decode(RawBuffer& raw) {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(decoded) return;
+        decoder(metadata.data(), metadata.size(), raw);
+        decoded = true;
+        // Serialized form isn't needed anymore
+        std::vector<std::uint8_t>().swap(metadata);
+    }
+
+    /**
+     * @returns True if metadata was already decoded
+     */
+    bool isDecoded() {
+        std::unique_lock<std::mutex> lock(mtx);
+        return decoded;
+    }
+};
+
+}  // namespace dai
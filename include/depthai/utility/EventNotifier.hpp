@@ -0,0 +1,44 @@
+#pragma once
+
+// std
+#include <atomic>
+
+namespace dai {
+
+/**
+ * File descriptor which can be polled (eg. with epoll, poll or select) for notifications.
+ * Backed by an eventfd on Linux and a pipe on other POSIX platforms. Not supported on Windows.
+ * Repeated notifications without clearing only cost an atomic operation, not a system call.
+ */
+class EventNotifier {
+    int readFd{-1};
+    int writeFd{-1};
+    std::atomic<bool> signaled{false};
+
+   public:
+    /**
+     * Creates a notifier. Throws if not supported on this platform
+     */
+    EventNotifier();
+    ~EventNotifier();
+
+    EventNotifier(const EventNotifier&) = delete;
+    EventNotifier& operator=(const EventNotifier&) = delete;
+
+    /**
+     * @returns File descriptor, which is readable while notified
+     */
+    int getFd() const;
+
+    /**
+     * Makes the file descriptor readable, if not already
+     */
+    void notify();
+
+    /**
+     * Makes the file descriptor not readable, until notified again
+     */
+    void clear();
+};
+
+}  // namespace dai
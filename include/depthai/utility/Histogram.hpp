@@ -0,0 +1,147 @@
+#pragma once
+
+// std
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace dai {
+
+/**
+ * Histogram of durations, which can be recorded concurrently without locking.
+ * Buckets are log-linear: each power of two range of nanoseconds is split into 4 buckets,
+ * so recorded durations are resolved to within 25%
+ */
+class Histogram {
+   public:
+    /// Number of buckets, covering the whole range of std::uint64_t nanoseconds
+    static constexpr std::size_t NUM_BUCKETS = 252;
+
+    /// Histogram contents at some point in time
+    struct Snapshot {
+        /// Number of recorded durations
+        std::uint64_t count = 0;
+        /// Sum of recorded durations
+        std::chrono::nanoseconds total{0};
+        /// Shortest recorded duration
+        std::chrono::nanoseconds min{0};
+        /// Longest recorded duration
+        std::chrono::nanoseconds max{0};
+        /// Number of recorded durations per bucket, see Histogram::bucketLowerBound
+        std::array<std::uint64_t, NUM_BUCKETS> buckets{};
+
+        /**
+         * @returns Mean of recorded durations, 0 if none
+         */
+        std::chrono::nanoseconds mean() const {
+            if(count == 0) return std::chrono::nanoseconds(0);
+            return total / count;
+        }
+
+        /**
+         * Estimates a percentile from buckets, as the upper bound of the bucket containing it (capped by max)
+         *
+         * @param percentile Percentile between 0 and 100
+         * @returns Estimated duration, 0 if none recorded
+         */
+        std::chrono::nanoseconds percentile(double percentile) const {
+            if(count == 0) return std::chrono::nanoseconds(0);
+            const auto rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(count - 1));
+            std::uint64_t seen = 0;
+            for(std::size_t i = 0; i < NUM_BUCKETS; i++) {
+                seen += buckets[i];
+                if(seen > rank) {
+                    const auto upper = std::chrono::nanoseconds(bucketUpperBound(i));
+                    return upper < max ? upper : max;
+                }
+            }
+            return max;
+        }
+
+        /**
+         * Adds durations recorded by another histogram
+         */
+        void merge(const Snapshot& other) {
+            if(other.count == 0) return;
+            min = count == 0 ? other.min : std::min(min, other.min);
+            max = std::max(max, other.max);
+            count += other.count;
+            total += other.total;
+            for(std::size_t i = 0; i < NUM_BUCKETS; i++) buckets[i] += other.buckets[i];
+        }
+    };
+
+    /**
+     * Records a duration. Negative durations are recorded as 0
+     */
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> duration) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        const std::uint64_t value = ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+
+        buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(value, std::memory_order_relaxed);
+        auto currentMin = min.load(std::memory_order_relaxed);
+        while(value < currentMin && !min.compare_exchange_weak(currentMin, value, std::memory_order_relaxed)) {
+        }
+        auto currentMax = max.load(std::memory_order_relaxed);
+        while(value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+        }
+        // Count last, so a concurrent snapshot doesn't see a count without its bucket
+        count.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @returns Current contents. Durations recorded concurrently may be partially included
+     */
+    Snapshot getSnapshot() const {
+        Snapshot snapshot;
+        snapshot.count = count.load(std::memory_order_acquire);
+        if(snapshot.count == 0) return snapshot;
+        snapshot.total = std::chrono::nanoseconds(total.load(std::memory_order_relaxed));
+        snapshot.min = std::chrono::nanoseconds(min.load(std::memory_order_relaxed));
+        snapshot.max = std::chrono::nanoseconds(max.load(std::memory_order_relaxed));
+        for(std::size_t i = 0; i < NUM_BUCKETS; i++) snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /**
+     * @returns Smallest duration (in nanoseconds) recorded into given bucket
+     */
+    static constexpr std::uint64_t bucketLowerBound(std::size_t index) {
+        return index < 4 ? index : (4 + index % 4) << (index / 4 - 1);
+    }
+
+    /**
+     * @returns Largest duration (in nanoseconds) recorded into given bucket
+     */
+    static constexpr std::uint64_t bucketUpperBound(std::size_t index) {
+        return index < 4 ? index : bucketLowerBound(index) + ((std::uint64_t(1) << (index / 4 - 1)) - 1);
+    }
+
+    /**
+     * @returns Bucket into which given duration (in nanoseconds) is recorded
+     */
+    static std::size_t bucketIndex(std::uint64_t ns) {
+        if(ns < 4) return static_cast<std::size_t>(ns);
+        // Position of the most significant bit, at least 2
+        std::size_t msb = 2;
+        while(msb < 63 && (ns >> (msb + 1)) != 0) msb++;
+        // Next two bits select the bucket within the power of two range
+        const auto sub = static_cast<std::size_t>((ns >> (msb - 2)) & 3);
+        return (msb - 1) * 4 + sub;
+    }
+
+   private:
+    std::array<std::atomic<std::uint64_t>, NUM_BUCKETS> buckets{};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> min{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> max{0};
+};
+
+}  // namespace dai
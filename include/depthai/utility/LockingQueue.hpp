@@ -1,10 +1,18 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
-#include <queue>
+
+#include "depthai/utility/MemoryBudget.hpp"
+#include "depthai/utility/QueueStats.hpp"
 
 namespace dai {
 
@@ -38,15 +46,102 @@ class LockingQueue {
         return blocking;
     }
 
+    /**
+     * Sets maximum total size (in bytes) of queued elements, as measured by the size function.
+     * Applies together with maxSize and the blocking policy. An empty queue always accepts an element,
+     * so an element larger than the limit doesn't block the queue forever
+     *
+     * @param bytes Maximum number of bytes, 0 means no limit
+     */
+    void setMaxBytes(std::size_t bytes) {
+        std::unique_lock<std::mutex> lock(guard);
+        maxBytes = bytes;
+    }
+
+    std::size_t getMaxBytes() const {
+        std::unique_lock<std::mutex> lock(guard);
+        return maxBytes;
+    }
+
+    /**
+     * Sets function measuring size (in bytes) of an element. Without it, elements have a size of 0
+     */
+    void setSizeFunction(std::function<std::size_t(const T&)> function) {
+        std::unique_lock<std::mutex> lock(guard);
+        sizeOf = std::move(function);
+    }
+
+    /**
+     * Sets a memory budget shared with other queues. Queued elements acquire their size from it,
+     * and pushing waits for (or drops elements to make) space in it, according to the blocking policy
+     *
+     * @param memoryBudget Shared memory budget or nullptr
+     */
+    void setMemoryBudget(std::shared_ptr<MemoryBudget> memoryBudget) {
+        std::unique_lock<std::mutex> lock(guard);
+        // Move already queued bytes over
+        if(budget) budget->release(queuedBytes);
+        budget = std::move(memoryBudget);
+        if(budget) budget->acquire(queuedBytes);
+    }
+
+    /**
+     * Sets function telling whether an element depends on the elements preceding it (eg. a P-frame on the frames
+     * back to its keyframe). A full non-blocking queue then drops whole runs of dependent elements, oldest first,
+     * instead of the oldest element. Queued independent elements are never dropped: once no dependent elements
+     * are queued, the incoming element is dropped instead. Following a dropped element (incoming, or the newest
+     * one as part of a run), incoming dependent elements are dropped as well until an independent one arrives.
+     * The function is called before the queue is locked, so it may be costly (eg. parse the element).
+     *
+     * @param function Dependency function, or nullptr to always drop the oldest element
+     */
+    void setDependencyFunction(std::function<bool(const T&)> function) {
+        std::shared_ptr<const std::function<bool(const T&)>> dependency;
+        if(function) dependency = std::make_shared<const std::function<bool(const T&)>>(std::move(function));
+        std::unique_lock<std::mutex> lock(guard);
+        std::atomic_store(&dependsOnPrevious, std::move(dependency));
+        brokenChain = false;
+    }
+
+    std::shared_ptr<MemoryBudget> getMemoryBudget() const {
+        std::unique_lock<std::mutex> lock(guard);
+        return budget;
+    }
+
+    /**
+     * @returns Total size (in bytes) of queued elements
+     */
+    std::size_t getBytes() const {
+        std::unique_lock<std::mutex> lock(guard);
+        return queuedBytes;
+    }
+
+    /**
+     * @returns Statistics since the queue was created
+     */
+    QueueStats getStats() const {
+        QueueStats snapshot;
+        {
+            std::unique_lock<std::mutex> lock(guard);
+            snapshot = stats;
+        }
+        snapshot.dwellTime = dwellTime.getSnapshot();
+        return snapshot;
+    }
+
     void destruct() {
         std::unique_lock<std::mutex> lock(guard);
         if(!destructed) {
             signalPop.notify_all();
             signalPush.notify_all();
             destructed = true;
+            // Also wake a push waiting for space in the memory budget
+            if(budget) budget->notifyChange();
         }
     }
-    ~LockingQueue() = default;
+    ~LockingQueue() {
+        if(budget) budget->release(queuedBytes);
+    }
 
     template <typename Rep, typename Period>
     bool waitAndConsumeAll(std::function<void(T&)> callback, std::chrono::duration<Rep, Period> timeout) {
@@ -60,8 +155,8 @@ class LockingQueue {
 
             // Continue here if and only if queue has any elements
             while(!queue.empty()) {
-                callback(queue.front());
-                queue.pop();
+                callback(queue.front().value);
+                pop(false);
             }
         }
 
@@ -78,8 +173,8 @@ class LockingQueue {
             if(destructed) return false;
 
             while(!queue.empty()) {
-                callback(queue.front());
-                queue.pop();
+                callback(queue.front().value);
+                pop(false);
             }
         }
 
@@ -94,8 +189,8 @@ class LockingQueue {
             if(queue.empty()) return false;
 
             while(!queue.empty()) {
-                callback(queue.front());
-                queue.pop();
+                callback(queue.front().value);
+                pop(false);
             }
         }
 
@@ -104,27 +199,43 @@ class LockingQueue {
     }
 
     bool push(T const& data) {
+        // Evaluated before locking, as it may be costly
+        const auto dependency = std::atomic_load(&dependsOnPrevious);
+        const bool isDependent = dependency && (*dependency)(data);
         {
             std::unique_lock<std::mutex> lock(guard);
+            const std::size_t bytes = sizeOf ? sizeOf(data) : 0;
             if(maxSize == 0) {
                 // necessary if maxSize was changed
                 while(!queue.empty()) {
-                    queue.pop();
+                    pop(true);
                 }
+                // The element is dropped as well
+                stats.numPushed++;
+                stats.bytesPushed += bytes;
+                stats.numDropped++;
+                stats.bytesDropped += bytes;
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
-                }
+                if(!makeRoom(dependency != nullptr, isDependent, bytes)) return true;
             } else {
-                signalPop.wait(lock, [this]() { return queue.size() < maxSize || destructed; });
+                while(!destructed) {
+                    const auto budgetVersion = budget ? budget->getVersion() : 0;
+                    if(admit(bytes)) break;
+                    waitSpace(lock, bytes, budgetVersion, std::chrono::steady_clock::time_point::max());
+                }
                 if(destructed) return false;
             }
 
-            queue.push(data);
+            queue.push_back({data, bytes, isDependent, std::chrono::steady_clock::now()});
+            queuedBytes += bytes;
+            stats.numPushed++;
+            stats.bytesPushed += bytes;
+            stats.maxQueued = std::max(stats.maxQueued, queue.size());
+            stats.maxQueuedBytes = std::max(stats.maxQueuedBytes, queuedBytes);
         }
         signalPush.notify_all();
         return true;
@@ -132,29 +243,46 @@ class LockingQueue {
 
     template <typename Rep, typename Period>
     bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> timeout) {
+        // Evaluated before locking, as it may be costly
+        const auto dependency = std::atomic_load(&dependsOnPrevious);
+        const bool isDependent = dependency && (*dependency)(data);
         {
             std::unique_lock<std::mutex> lock(guard);
+            const std::size_t bytes = sizeOf ? sizeOf(data) : 0;
             if(maxSize == 0) {
                 // necessary if maxSize was changed
                 while(!queue.empty()) {
-                    queue.pop();
+                    pop(true);
                 }
+                // The element is dropped as well
+                stats.numPushed++;
+                stats.bytesPushed += bytes;
+                stats.numDropped++;
+                stats.bytesDropped += bytes;
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
-                }
+                if(!makeRoom(dependency != nullptr, isDependent, bytes)) return true;
             } else {
                 // First checks predicate, then waits
-                bool pred = signalPop.wait_for(lock, timeout, [this]() { return queue.size() < maxSize || destructed; });
-                if(!pred) return false;
+                const auto deadline = deadlineAfter(timeout);
+                while(!destructed) {
+                    const auto budgetVersion = budget ? budget->getVersion() : 0;
+                    if(admit(bytes)) break;
+                    if(std::chrono::steady_clock::now() >= deadline) return false;
+                    waitSpace(lock, bytes, budgetVersion, deadline);
+                }
                 if(destructed) return false;
             }
 
-            queue.push(data);
+            queue.push_back({data, bytes, isDependent, std::chrono::steady_clock::now()});
+            queuedBytes += bytes;
+            stats.numPushed++;
+            stats.bytesPushed += bytes;
+            stats.maxQueued = std::max(stats.maxQueued, queue.size());
+            stats.maxQueuedBytes = std::max(stats.maxQueuedBytes, queuedBytes);
         }
         signalPush.notify_all();
         return true;
@@ -171,7 +299,7 @@ class LockingQueue {
             return false;
         }
 
-        value = queue.front();
+        value = queue.front().value;
         return true;
     }
 
@@ -182,8 +310,8 @@ class LockingQueue {
                 return false;
             }
 
-            value = std::move(queue.front());
-            queue.pop();
+            value = std::move(queue.front().value);
+            pop(false);
         }
         signalPop.notify_all();
         return true;
@@ -197,8 +325,8 @@ class LockingQueue {
             if(queue.empty()) return false;
             if(destructed) return false;
 
-            value = std::move(queue.front());
-            queue.pop();
+            value = std::move(queue.front().value);
+            pop(false);
         }
         signalPop.notify_all();
         return true;
@@ -214,8 +342,8 @@ class LockingQueue {
             if(!pred) return false;
             if(destructed) return false;
 
-            value = std::move(queue.front());
-            queue.pop();
+            value = std::move(queue.front().value);
+            pop(false);
         }
         signalPop.notify_all();
         return true;
@@ -227,13 +355,128 @@ class LockingQueue {
     }
 
    private:
+    struct Element {
+        T value;
+        std::size_t bytes;
+        // Depends on preceding elements, see setDependencyFunction
+        bool dependent;
+        std::chrono::steady_clock::time_point pushed;
+    };
+
     unsigned maxSize = std::numeric_limits<unsigned>::max();
     bool blocking = true;
-    std::queue<T> queue;
+    std::deque<Element> queue;
     mutable std::mutex guard;
     bool destructed{false};
     std::condition_variable signalPop;
     std::condition_variable signalPush;
+    std::size_t maxBytes = 0;
+    std::size_t queuedBytes = 0;
+    std::function<std::size_t(const T&)> sizeOf;
+    std::shared_ptr<MemoryBudget> budget;
+    // Accessed with std::atomic_load/std::atomic_store, as it's called without holding 'guard'
+    std::shared_ptr<const std::function<bool(const T&)>> dependsOnPrevious;
+    // Set once a dependent element was dropped with all elements after it, until an independent element is pushed
+    bool brokenChain = false;
+    QueueStats stats;
+    Histogram dwellTime;
+
+    // Whether an element of given size can be pushed now. If so, its size is acquired from the memory budget
+    bool admit(std::size_t bytes) {
+        if(queue.size() >= maxSize) return false;
+        // An empty queue always accepts an element
+        if(queue.empty()) {
+            if(budget) budget->acquire(bytes);
+            return true;
+        }
+        if(maxBytes != 0 && queuedBytes + bytes > maxBytes) return false;
+        return budget == nullptr || budget->tryAcquire(bytes);
+    }
+
+    // Removes the oldest element, either consumed or dropped
+    void pop(bool dropped) {
+        const auto bytes = queue.front().bytes;
+        if(dropped) {
+            stats.numDropped++;
+            stats.bytesDropped += bytes;
+        } else {
+            stats.numPopped++;
+            dwellTime.record(std::chrono::steady_clock::now() - queue.front().pushed);
+        }
+        queue.pop_front();
+        queuedBytes -= bytes;
+        if(budget) budget->release(bytes);
+    }
+
+    // Drops elements until one of given size fits (non blocking). Returns false if the element itself is dropped instead
+    bool makeRoom(bool tracksDependencies, bool isDependent, std::size_t bytes) {
+        if(!tracksDependencies) {
+            while(!admit(bytes)) pop(true);
+            return true;
+        }
+
+        bool fits = false;
+        // Otherwise whatever it depends on was dropped
+        if(!isDependent || !brokenChain) {
+            while(!(fits = admit(bytes)) && dropRun()) {
+                // The dropped run reached the newest element, which it depends on
+                if(isDependent && brokenChain) break;
+            }
+        }
+        // Dependent elements following a dropped one are dropped as well
+        brokenChain = !fits;
+        if(fits) return true;
+
+        stats.numPushed++;
+        stats.bytesPushed += bytes;
+        stats.numDropped++;
+        stats.bytesDropped += bytes;
+        return false;
+    }
+
+    // Drops the oldest run of dependent elements. Returns false if there are none
+    bool dropRun() {
+        auto first = std::find_if(queue.begin(), queue.end(), [](const Element& e) { return e.dependent; });
+        if(first == queue.end()) return false;
+        auto last = std::find_if(first, queue.end(), [](const Element& e) { return !e.dependent; });
+        if(last == queue.end()) brokenChain = true;
+
+        for(auto it = first; it != last; ++it) {
+            stats.numDropped++;
+            stats.bytesDropped += it->bytes;
+            queuedBytes -= it->bytes;
+            if(budget) budget->release(it->bytes);
+        }
+        queue.erase(first, last);
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    static std::chrono::steady_clock::time_point deadlineAfter(std::chrono::duration<Rep, Period> timeout) {
+        const auto now = std::chrono::steady_clock::now();
+        // Avoid overflow for very long timeouts
+        if(timeout >= std::chrono::duration_cast<std::chrono::duration<Rep, Period>>(std::chrono::steady_clock::time_point::max() - now)) {
+            return std::chrono::steady_clock::time_point::max();
+        }
+        return now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    }
+
+    // Waits for space for an element of given size, until deadline. 'budgetVersion' is the budget's version before it was found full
+    void waitSpace(std::unique_lock<std::mutex>& lock, std::size_t bytes, std::uint64_t budgetVersion, std::chrono::steady_clock::time_point deadline) {
+        if(budget && queue.size() < maxSize && (maxBytes == 0 || queuedBytes + bytes <= maxBytes)) {
+            // Only the shared budget is full, which is released by other queues too
+            const auto memoryBudget = budget;
+            lock.unlock();
+            memoryBudget->waitChange(budgetVersion, deadline);
+            lock.lock();
+            return;
+        }
+        if(deadline == std::chrono::steady_clock::time_point::max()) {
+            signalPop.wait(lock);
+        } else {
+            signalPop.wait_until(lock, deadline);
+        }
+    }
 };
 
 }  // namespace dai
@@ -0,0 +1,52 @@
+#pragma once
+
+// std
+#include <cstdint>
+
+// project
+#include "depthai/utility/Memory.hpp"
+#include "depthai/utility/Path.hpp"
+#include "depthai/utility/span.hpp"
+
+namespace dai {
+
+/**
+ * Contents of a file mapped into memory. Pages are read from the file on first access and shared with
+ * other mappings of the same file, instead of the whole file being copied into an allocated buffer.
+ * The mapping is private (copy-on-write), so writes through getData() are never carried to the file.
+ * The file must not be truncated or rewritten while mapped, also by other processes. Accessing pages past the
+ * new end of file raises SIGBUS, and rewritten pages not yet read may show the new contents.
+ * Keep this in mind when handing a MappedFile to long lived objects, such as a Blob or an asset of a Pipeline.
+ */
+class MappedFile : public Memory {
+   public:
+    /**
+     * Maps a file. Throws if the file can't be opened or mapped
+     *
+     * @param path Path to the file
+     */
+    explicit MappedFile(const dai::Path& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() override;
+
+    /**
+     * @returns Span over the file contents
+     */
+    span<std::uint8_t> getData() override;
+
+    /**
+     * @returns Span over the file contents
+     */
+    span<const std::uint8_t> getData() const;
+
+   private:
+    std::uint8_t* mapped = nullptr;
+    std::size_t size = 0;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+}  // namespace dai
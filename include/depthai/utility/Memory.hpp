@@ -0,0 +1,87 @@
+#pragma once
+
+// std
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// project
+#include "depthai/utility/span.hpp"
+
+namespace dai {
+
+/**
+ * Abstract memory region, owned and released by the implementation
+ */
+class Memory {
+   public:
+    virtual ~Memory() = default;
+
+    /**
+     * @returns Span over the memory region
+     */
+    virtual span<std::uint8_t> getData() = 0;
+
+    /**
+     * @returns Size of the memory region in bytes
+     */
+    std::size_t getSize() {
+        return getData().size();
+    }
+};
+
+/**
+ * Memory adopted by a message in place of its data vector.
+ * The contents are only copied into the data vector once a (mutable) vector reference is requested,
+ * views can be taken without copying. The adopted memory stays alive until the message is destroyed,
+ * so views taken before the copy remain valid.
+ */
+class AdoptedMemory {
+    std::mutex mtx;
+    std::shared_ptr<Memory> memory;
+    bool copied{false};
+
+   public:
+    explicit AdoptedMemory(std::shared_ptr<Memory> mem) : memory(std::move(mem)) {}
+
+    /**
+     * Copies adopted memory into 'data' if not yet done
+     * @param data Data vector of the message which adopted the memory
+     */
+    void copyTo(std::vector<std::uint8_t>& data) {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(copied) return;
+        auto region = memory->getData();
+        data.assign(region.begin(), region.end());
+        copied = true;
+    }
+
+    /**
+     * Marks adopted memory as superseded by the message data vector, without copying it
+     */
+    void discard() {
+        std::unique_lock<std::mutex> lock(mtx);
+        copied = true;
+    }
+
+    /**
+     * @param data Data vector of the message which adopted the memory
+     * @returns View of the adopted memory, or of 'data' if it was already copied into
+     */
+    span<std::uint8_t> view(std::vector<std::uint8_t>& data) {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(copied) return {data.data(), data.size()};
+        return memory->getData();
+    }
+
+    /**
+     * @returns True if adopted memory was already copied into the message data vector
+     */
+    bool isCopied() {
+        std::unique_lock<std::mutex> lock(mtx);
+        return copied;
+    }
+};
+
+}  // namespace dai
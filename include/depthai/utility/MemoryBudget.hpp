@@ -0,0 +1,126 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace dai {
+
+/**
+ * Memory budget (in bytes) shared between multiple queues, to cap their combined size.
+ * Queues acquire the size of each element they hold and release it once the element is removed
+ */
+class MemoryBudget {
+    std::atomic<std::size_t> maxBytes;
+    std::atomic<std::size_t> usedBytes{0};
+    // Incremented (and waiters notified) whenever space may have become available
+    std::mutex changeMtx;
+    std::condition_variable changeCv;
+    std::uint64_t version = 0;
+
+   public:
+    /**
+     * @param maxBytes Maximum number of bytes held by all queues together. 0 means no limit
+     */
+    explicit MemoryBudget(std::size_t maxBytes = 0) : maxBytes(maxBytes) {}
+
+    /**
+     * Sets maximum number of bytes. Already acquired bytes are kept, even if over the new limit
+     *
+     * @param maxBytes Maximum number of bytes held by all queues together. 0 means no limit
+     */
+    void setMaxBytes(std::size_t maxBytes) {
+        this->maxBytes = maxBytes;
+        notifyChange();
+    }
+
+    /**
+     * @returns Maximum number of bytes, or 0 if not limited
+     */
+    std::size_t getMaxBytes() const {
+        return maxBytes;
+    }
+
+    /**
+     * @returns Number of bytes currently acquired
+     */
+    std::size_t getUsedBytes() const {
+        return usedBytes;
+    }
+
+    /**
+     * Acquires bytes if they fit into the budget
+     *
+     * @param bytes Number of bytes to acquire
+     * @returns True if acquired, false if that would exceed the limit
+     */
+    bool tryAcquire(std::size_t bytes) {
+        const std::size_t max = maxBytes;
+        auto used = usedBytes.load();
+        do {
+            if(max != 0 && used + bytes > max) return false;
+        } while(!usedBytes.compare_exchange_weak(used, used + bytes));
+        return true;
+    }
+
+    /**
+     * Acquires bytes regardless of the limit
+     *
+     * @param bytes Number of bytes to acquire
+     */
+    void acquire(std::size_t bytes) {
+        usedBytes += bytes;
+    }
+
+    /**
+     * Releases previously acquired bytes
+     *
+     * @param bytes Number of bytes to release
+     */
+    void release(std::size_t bytes) {
+        usedBytes -= bytes;
+        notifyChange();
+    }
+
+    /**
+     * @returns Version of the budget, which changes whenever space may have become available
+     */
+    std::uint64_t getVersion() {
+        std::unique_lock<std::mutex> lock(changeMtx);
+        return version;
+    }
+
+    /**
+     * Wakes threads waiting for a change, eg. once a waiting queue is destructed
+     */
+    void notifyChange() {
+        {
+            std::unique_lock<std::mutex> lock(changeMtx);
+            version++;
+        }
+        changeCv.notify_all();
+    }
+
+    /**
+     * Waits until the budget changes from given version (see getVersion), or until deadline
+     *
+     * @param fromVersion Version observed before finding there is no space
+     * @param deadline Time point after which to return regardless
+     * @returns True if changed, false on timeout
+     */
+    bool waitChange(std::uint64_t fromVersion, std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(changeMtx);
+        const auto changed = [this, fromVersion]() { return version != fromVersion; };
+        if(deadline == std::chrono::steady_clock::time_point::max()) {
+            changeCv.wait(lock, changed);
+            return true;
+        }
+        return changeCv.wait_until(lock, deadline, changed);
+    }
+};
+
+}  // namespace dai
@@ -0,0 +1,148 @@
+#pragma once
+
+// std
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+// shared
+#include "depthai-shared/datatype/DatatypeEnum.hpp"
+#include "depthai-shared/datatype/RawBuffer.hpp"
+
+namespace dai {
+
+/**
+ * Pool of Raw* message objects.
+ * Objects acquired from the pool return to it (instead of being freed) once the last reference is dropped,
+ * keeping the capacity of their data buffer, so that following messages of the same type can reuse them.
+ * Can be shared between multiple queues, or used per queue (see DataOutputQueue::setMessagePool).
+ */
+class MessagePool : public std::enable_shared_from_this<MessagePool> {
+   public:
+    /// Pool limits
+    struct Config {
+        /// Maximum number of idle objects kept per message type
+        std::size_t maxPooledPerType = 8;
+        /// Objects with larger data capacity (in bytes) are freed instead of pooled. 0 means no limit
+        std::size_t maxDataCapacity = 0;
+    };
+
+    /// Pool statistics
+    struct Stats {
+        /// Number of objects handed out
+        std::uint64_t numAcquired = 0;
+        /// Number of objects handed out which were reused from the pool
+        std::uint64_t numReused = 0;
+        /// Number of objects returned to the pool
+        std::uint64_t numReturned = 0;
+        /// Number of objects freed instead of returned, due to pool limits
+        std::uint64_t numDiscarded = 0;
+        /// Number of idle objects currently in the pool
+        std::size_t numPooled = 0;
+        /// Data capacity (in bytes) of idle objects currently in the pool
+        std::size_t pooledDataCapacity = 0;
+    };
+
+   private:
+    struct TypePool {
+        DatatypeEnum datatype = DatatypeEnum::Buffer;
+        std::function<void(RawBuffer&)> reset;
+        std::vector<std::unique_ptr<RawBuffer>> idle;
+        Stats stats;
+    };
+
+    mutable std::mutex mtx;
+    Config config;
+    std::unordered_map<std::type_index, TypePool> pools;
+
+    void release(std::type_index type, RawBuffer* obj);
+
+   public:
+    /**
+     * Creates a message pool with default limits. Must be owned by a shared_ptr (eg. std::make_shared<MessagePool>())
+     */
+    MessagePool();
+
+    /**
+     * Creates a message pool. Must be owned by a shared_ptr (eg. std::make_shared<MessagePool>(config))
+     * @param config Pool limits
+     */
+    explicit MessagePool(Config config);
+
+    /**
+     * Sets pool limits. Applied to objects returning to the pool from then on
+     */
+    void setConfig(Config config);
+
+    /**
+     * Gets pool limits
+     */
+    Config getConfig() const;
+
+    /**
+     * @returns Statistics summed over all message types
+     */
+    Stats getStats() const;
+
+    /**
+     * @param datatype Message type
+     * @returns Statistics of specified message type
+     */
+    Stats getStats(DatatypeEnum datatype) const;
+
+    /**
+     * Frees all idle objects
+     */
+    void clear();
+
+    /**
+     * Acquires an object of type T, either reused from the pool or newly created.
+     * Reused objects are reset to default state, with empty data which keeps its capacity
+     *
+     * @returns Object which returns to this pool once the last reference is dropped
+     */
+    template <typename T>
+    std::shared_ptr<T> acquire() {
+        const std::type_index type(typeid(T));
+        std::unique_ptr<RawBuffer> obj;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            auto& pool = pools[type];
+            if(!pool.reset) {
+                pool.datatype = T().getType();
+                pool.reset = [](RawBuffer& buffer) {
+                    // Reset metadata, but keep data capacity
+                    auto& t = static_cast<T&>(buffer);
+                    auto data = std::move(t.data);
+                    t = T();
+                    data.clear();
+                    t.data = std::move(data);
+                };
+            }
+            pool.stats.numAcquired++;
+            if(!pool.idle.empty()) {
+                obj = std::move(pool.idle.back());
+                pool.idle.pop_back();
+                pool.stats.numReused++;
+                pool.stats.numPooled--;
+                pool.stats.pooledDataCapacity -= obj->data.capacity();
+            }
+        }
+        if(!obj) obj = std::make_unique<T>();
+
+        std::weak_ptr<MessagePool> weakPool = shared_from_this();
+        return std::shared_ptr<T>(static_cast<T*>(obj.release()), [weakPool, type](T* p) {
+            if(auto pool = weakPool.lock()) {
+                pool->release(type, p);
+            } else {
+                delete p;
+            }
+        });
+    }
+};
+
+}  // namespace dai
@@ -1,5 +1,12 @@
 #pragma once
 
+// std
+#include <chrono>
+#include <cstdint>
+
+// project
+#include "depthai/utility/Histogram.hpp"
+
 namespace dai {
 
 struct ProfilingData {
@@ -7,4 +14,32 @@ struct ProfilingData {
     long long numBytesRead;
 };
 
+/**
+ * Profiling counters of a single XLink stream. Only recorded while profiling is enabled (DEPTHAI_PROFILING=1, see StreamProfiler::setEnabled)
+ */
+struct StreamProfilingData {
+    /// Number of packets read
+    std::uint64_t numPacketsRead = 0;
+    /// Size of packets read, in bytes
+    std::uint64_t numBytesRead = 0;
+    /// Number of packets written
+    std::uint64_t numPacketsWritten = 0;
+    /// Size of packets written, in bytes
+    std::uint64_t numBytesWritten = 0;
+    /// Duration of each read call which returned a packet, including time waiting for it
+    Histogram::Snapshot readTime;
+    /// Duration of each write call which wrote a packet
+    Histogram::Snapshot writeTime;
+    /// Total time spent in read calls which returned a packet. Reads which timed out aren't counted, as they measure idle waiting
+    std::chrono::nanoseconds readBlockedTime{0};
+    /// Total time spent in write calls, including ones which timed out
+    std::chrono::nanoseconds writeBlockedTime{0};
+    /**
+     * Time from when the remote sent a packet until it was received, for each packet read.
+     * Remote and host clocks are independent, so it includes their offset (negative values are recorded as 0):
+     * compare it between streams and over time, rather than as an absolute value
+     */
+    Histogram::Snapshot latency;
+};
+
 }  // namespace dai
@@ -0,0 +1,49 @@
+#pragma once
+
+// std
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// project
+#include "depthai/utility/Histogram.hpp"
+
+namespace dai {
+
+/**
+ * Statistics of a queue (LockingQueue, RingQueue or ConflatingQueue)
+ */
+struct QueueStats {
+    /// Number of elements pushed
+    std::uint64_t numPushed = 0;
+    /// Number of elements popped by consumers
+    std::uint64_t numPopped = 0;
+    /// Number of elements dropped or overwritten before being popped
+    std::uint64_t numDropped = 0;
+    /// Size of pushed elements, in bytes. Only tracked when the queue measures element size
+    std::uint64_t bytesPushed = 0;
+    /// Size of dropped elements, in bytes. Only tracked when the queue measures element size
+    std::uint64_t bytesDropped = 0;
+    /// Largest number of elements in the queue at once (high-water mark)
+    std::size_t maxQueued = 0;
+    /// Largest size of elements in the queue at once, in bytes. Only tracked when the queue measures element size
+    std::size_t maxQueuedBytes = 0;
+    /// Time elements spent in the queue, from push to pop
+    Histogram::Snapshot dwellTime;
+
+    /**
+     * Adds statistics of another queue
+     */
+    void merge(const QueueStats& other) {
+        numPushed += other.numPushed;
+        numPopped += other.numPopped;
+        numDropped += other.numDropped;
+        bytesPushed += other.bytesPushed;
+        bytesDropped += other.bytesDropped;
+        maxQueued = std::max(maxQueued, other.maxQueued);
+        maxQueuedBytes = std::max(maxQueuedBytes, other.maxQueuedBytes);
+        dwellTime.merge(other.dwellTime);
+    }
+};
+
+}  // namespace dai
@@ -0,0 +1,353 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "depthai/utility/QueueStats.hpp"
+
+namespace dai {
+
+/**
+ * Bounded ring buffer queue with the same semantics as LockingQueue, for a single producer thread.
+ *
+ * Elements are handed over through atomic head/tail indices, so a regular push doesn't contend with consumers.
+ * The queue isn't lock-free though: consumers are serialized among themselves by a mutex (so multiple consumer
+ * threads are supported), which the producer takes as well when it drops the oldest elements or grows storage,
+ * and a mutex/condition variable is used to sleep while the queue is empty (or full when blocking).
+ * Storage grows on demand up to maxSize, so a large maxSize doesn't preallocate.
+ */
+template <typename T>
+class RingQueue {
+   public:
+    RingQueue() : RingQueue(std::numeric_limits<unsigned>::max()) {}
+    explicit RingQueue(unsigned maxSize, bool blocking = true) : buffer(INITIAL_CAPACITY), pushTimes(INITIAL_CAPACITY), maxSize(maxSize), blocking(blocking) {}
+
+    void setMaxSize(unsigned sz) {
+        maxSize = sz;
+        // Let a producer waiting for space recheck
+        notifyProducer(true);
+    }
+
+    void setBlocking(bool bl) {
+        blocking = bl;
+        notifyProducer(true);
+    }
+
+    unsigned getMaxSize() const {
+        return maxSize;
+    }
+
+    bool getBlocking() const {
+        return blocking;
+    }
+
+    /**
+     * @returns Statistics since the queue was created. Element sizes aren't measured
+     */
+    QueueStats getStats() const {
+        QueueStats stats;
+        stats.numPushed = numPushed;
+        stats.numPopped = numPopped;
+        stats.numDropped = numDropped;
+        stats.maxQueued = maxQueued;
+        stats.dwellTime = dwellTime.getSnapshot();
+        return stats;
+    }
+
+    void destruct() {
+        std::unique_lock<std::mutex> lock(waitMtx);
+        if(!destructed) {
+            destructed = true;
+            signalPop.notify_all();
+            signalPush.notify_all();
+        }
+    }
+    ~RingQueue() = default;
+
+    template <typename Rep, typename Period>
+    bool waitAndConsumeAll(std::function<void(T&)> callback, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(true) {
+            if(!waitPush(deadline)) return false;
+            if(destructed) return false;
+            if(consumeAll(callback)) return true;
+        }
+    }
+
+    bool waitAndConsumeAll(std::function<void(T&)> callback) {
+        while(true) {
+            waitPush();
+            if(destructed) return false;
+            if(consumeAll(callback)) return true;
+        }
+    }
+
+    bool consumeAll(std::function<void(T&)> callback) {
+        {
+            std::lock_guard<std::mutex> lock(consumerMtx);
+            auto h = head.load(std::memory_order_relaxed);
+            const auto t = tail.load(std::memory_order_acquire);
+            if(h == t) return false;
+
+            const auto now = std::chrono::steady_clock::now();
+            for(; h != t; h++) {
+                auto& slot = buffer[h & (buffer.size() - 1)];
+                dwellTime.record(now - pushTimes[h & (buffer.size() - 1)]);
+                callback(slot);
+                slot = T();
+                numPopped++;
+                head.store(h + 1);
+            }
+        }
+
+        notifyProducer();
+        return true;
+    }
+
+    bool push(T const& data) {
+        const unsigned max = maxSize;
+        if(max == 0) {
+            // necessary if maxSize was changed
+            clear();
+            // The element is dropped as well
+            numPushed++;
+            numDropped++;
+            return true;
+        }
+        if(!blocking) {
+            // if non blocking, remove as many oldest elements as necessary, so next one will fit
+            // necessary if maxSize was changed
+            while(size() >= max) {
+                dropOldest();
+            }
+        } else if(size() >= max) {
+            std::unique_lock<std::mutex> lock(waitMtx);
+            numWaitingProducers++;
+            signalPop.wait(lock, [this]() { return size() < maxSize || !blocking || destructed; });
+            numWaitingProducers--;
+            if(destructed) return false;
+            lock.unlock();
+            // Blocking or max size could have been changed in the meantime
+            return push(data);
+        }
+
+        produce(data);
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> timeout) {
+        const unsigned max = maxSize;
+        if(max == 0) {
+            // necessary if maxSize was changed
+            clear();
+            numPushed++;
+            numDropped++;
+            return true;
+        }
+        if(!blocking) {
+            while(size() >= max) {
+                dropOldest();
+            }
+        } else if(size() >= max) {
+            std::unique_lock<std::mutex> lock(waitMtx);
+            numWaitingProducers++;
+            bool pred = signalPop.wait_for(lock, timeout, [this]() { return size() < maxSize || destructed; });
+            numWaitingProducers--;
+            if(!pred) return false;
+            if(destructed) return false;
+        }
+
+        produce(data);
+        return true;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    bool front(T& value) {
+        std::lock_guard<std::mutex> lock(consumerMtx);
+        const auto h = head.load(std::memory_order_relaxed);
+        if(h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = buffer[h & (buffer.size() - 1)];
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        if(!pop(value, false)) return false;
+        notifyProducer();
+        return true;
+    }
+
+    bool waitAndPop(T& value) {
+        while(true) {
+            waitPush();
+            if(destructed) return false;
+            if(tryPop(value)) return true;
+        }
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPop(T& value, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(true) {
+            if(!waitPush(deadline)) return false;
+            if(destructed) return false;
+            if(tryPop(value)) return true;
+        }
+    }
+
+    void waitEmpty() {
+        if(empty()) return;
+        std::unique_lock<std::mutex> lock(waitMtx);
+        numWaitingProducers++;
+        signalPop.wait(lock, [this]() { return empty() || destructed; });
+        numWaitingProducers--;
+    }
+
+   private:
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+    // Capacity is a power of two. Grown (by the producer only) while holding consumerMtx
+    std::vector<T> buffer;
+    // When elements in 'buffer' were pushed
+    std::vector<std::chrono::steady_clock::time_point> pushTimes;
+    // Monotonic indices, position in buffer is index modulo capacity
+    // Separated to not share a cache line between producer and consumers
+    std::atomic<std::size_t> head{0};
+    char padHead[64 - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> tail{0};
+    char padTail[64 - sizeof(std::atomic<std::size_t>)];
+
+    std::atomic<unsigned> maxSize;
+    std::atomic<bool> blocking;
+    std::atomic<bool> destructed{false};
+
+    // Serializes consumers (and the producer when it drops or relocates elements)
+    mutable std::mutex consumerMtx;
+
+    // Only used to sleep when there is nothing to do
+    std::mutex waitMtx;
+    std::condition_variable signalPop;
+    std::condition_variable signalPush;
+    std::atomic<int> numWaitingConsumers{0};
+    std::atomic<int> numWaitingProducers{0};
+
+    // Statistics
+    std::atomic<std::uint64_t> numPushed{0};
+    std::atomic<std::uint64_t> numPopped{0};
+    std::atomic<std::uint64_t> numDropped{0};
+    std::atomic<std::size_t> maxQueued{0};
+    Histogram dwellTime;
+
+    std::size_t size() const {
+        // Load head first, so tail is never behind it
+        const auto h = head.load();
+        return tail.load() - h;
+    }
+
+    void produce(T const& data) {
+        const auto t = tail.load(std::memory_order_relaxed);
+        if(t - head.load() >= buffer.size()) {
+            grow();
+        }
+        buffer[t & (buffer.size() - 1)] = data;
+        pushTimes[t & (buffer.size() - 1)] = std::chrono::steady_clock::now();
+        tail.store(t + 1);
+
+        // Only the producer updates these
+        numPushed.store(numPushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        const auto queued = size();
+        if(queued > maxQueued.load(std::memory_order_relaxed)) maxQueued.store(queued, std::memory_order_relaxed);
+
+        // Only touch the mutex if a consumer is sleeping
+        if(numWaitingConsumers > 0) {
+            std::lock_guard<std::mutex> lock(waitMtx);
+            signalPush.notify_all();
+        }
+    }
+
+    void grow() {
+        std::lock_guard<std::mutex> lock(consumerMtx);
+        std::vector<T> larger(buffer.size() * 2);
+        std::vector<std::chrono::steady_clock::time_point> largerTimes(larger.size());
+        const auto t = tail.load(std::memory_order_relaxed);
+        for(auto i = head.load(std::memory_order_relaxed); i != t; i++) {
+            larger[i & (larger.size() - 1)] = std::move(buffer[i & (buffer.size() - 1)]);
+            largerTimes[i & (larger.size() - 1)] = pushTimes[i & (buffer.size() - 1)];
+        }
+        buffer = std::move(larger);
+        pushTimes = std::move(largerTimes);
+    }
+
+    bool pop(T& value, bool dropped) {
+        std::lock_guard<std::mutex> lock(consumerMtx);
+        const auto h = head.load(std::memory_order_relaxed);
+        if(h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        auto& slot = buffer[h & (buffer.size() - 1)];
+        value = std::move(slot);
+        slot = T();
+        if(dropped) {
+            numDropped++;
+        } else {
+            numPopped++;
+            dwellTime.record(std::chrono::steady_clock::now() - pushTimes[h & (buffer.size() - 1)]);
+        }
+        head.store(h + 1);
+        return true;
+    }
+
+    void dropOldest() {
+        T dropped;
+        pop(dropped, true);
+    }
+
+    void clear() {
+        T dropped;
+        while(pop(dropped, true)) {
+        }
+    }
+
+    void notifyProducer(bool force = false) {
+        if(force || numWaitingProducers > 0) {
+            std::lock_guard<std::mutex> lock(waitMtx);
+            signalPop.notify_all();
+        }
+    }
+
+    // Sleeps until the queue isn't empty or is destructed
+    void waitPush() {
+        if(!empty() || destructed) return;
+        std::unique_lock<std::mutex> lock(waitMtx);
+        numWaitingConsumers++;
+        signalPush.wait(lock, [this]() { return !empty() || destructed; });
+        numWaitingConsumers--;
+    }
+
+    // Returns false if deadline passed before the queue wasn't empty (or was destructed)
+    bool waitPush(std::chrono::steady_clock::time_point deadline) {
+        if(!empty() || destructed) return true;
+        std::unique_lock<std::mutex> lock(waitMtx);
+        numWaitingConsumers++;
+        bool pred = signalPush.wait_until(lock, deadline, [this]() { return !empty() || destructed; });
+        numWaitingConsumers--;
+        return pred;
+    }
+};
+
+template <typename T>
+constexpr std::size_t RingQueue<T>::INITIAL_CAPACITY;
+
+}  // namespace dai
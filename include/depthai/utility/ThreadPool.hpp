@@ -0,0 +1,50 @@
+#pragma once
+
+// std
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Work-stealing thread pool.
+ * Each worker has its own task deque, idle workers steal tasks from the others.
+ * Tasks submitted from a worker thread are queued to that worker.
+ */
+class ThreadPool {
+   public:
+    /**
+     * Creates a thread pool
+     * @param numThreads Number of worker threads. 0 selects the number of hardware threads
+     */
+    explicit ThreadPool(unsigned numThreads = 0);
+
+    /**
+     * Runs remaining tasks, then stops worker threads
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queues a task for execution on one of the worker threads
+     * @param task Task to execute. Exceptions thrown by the task are logged
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @returns Number of worker threads
+     */
+    unsigned getNumThreads() const;
+
+   private:
+    // Shared with worker threads, so the pool can also be destroyed from within a task
+    struct State;
+    std::shared_ptr<State> state;
+    std::vector<std::thread> threads;
+};
+
+}  // namespace dai
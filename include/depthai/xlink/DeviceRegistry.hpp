@@ -0,0 +1,172 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// project
+#include "depthai/xlink/XLinkConnection.hpp"
+
+// libraries
+#include <XLink/XLinkPublicDefines.h>
+
+namespace dai {
+
+/**
+ * Keeps a view of connected devices, updated by background scans, and notifies about changes.
+ * Each protocol is scanned by its own thread, so a slow search (eg. TCP/IP broadcast) doesn't delay others.
+ *
+ * Scans run at a short interval while someone waits for a device, at a longer one while callbacks are registered
+ * and not at all otherwise. Waiting returns as soon as a scan finds a suitable device, instead of polling at a fixed rate.
+ *
+ * Only devices found by searching all of a protocol are seen, so TCP/IP devices outside of broadcast reach aren't.
+ * Connecting to a device by name (eg. its IP address) therefore searches for it directly instead.
+ */
+class DeviceRegistry {
+   public:
+    /// Change of a connected device
+    enum class Event {
+        /// Device was found
+        ADDED,
+        /// Device is no longer found
+        REMOVED,
+        /// Device was found in another state (eg. after booting), or with another name or status
+        STATE_CHANGED
+    };
+
+    /// Called on a scanning thread, for each change of a device
+    using Callback = std::function<void(Event event, const DeviceInfo& device)>;
+    using CallbackId = std::uint64_t;
+    /// Finds all devices connected using a protocol
+    using Scanner = std::function<std::vector<DeviceInfo>(XLinkProtocol_t protocol)>;
+    /// Selects a device from devices found, returns whether one was selected
+    using Selector = std::function<bool(const std::vector<DeviceInfo>& devices, DeviceInfo& selected)>;
+
+    struct Config {
+        /// Protocols scanned in parallel
+        std::vector<XLinkProtocol_t> protocols{X_LINK_USB_VSC, X_LINK_PCIE, X_LINK_TCP_IP};
+        /// Interval between scans while someone waits for a device
+        std::chrono::milliseconds activeScanInterval{10};
+        /// Interval between scans while callbacks are registered
+        std::chrono::milliseconds idleScanInterval{1000};
+        /// Finds devices. Defaults to XLinkConnection::getAllConnectedDevices, including invalid devices
+        Scanner scanner;
+    };
+
+    /**
+     * Gets the registry shared by the process, created on first use with default configuration
+     */
+    static std::shared_ptr<DeviceRegistry> getInstance();
+
+    /**
+     * Checks whether a device matches a description. Empty name and mxid and 'ANY' state, protocol and platform match any device
+     *
+     * @param device Device to check
+     * @param pattern Description to match
+     * @param matchName Whether name has to match as well
+     * @returns True if device matches
+     */
+    static bool matches(const DeviceInfo& device, const DeviceInfo& pattern, bool matchName = true);
+
+    /**
+     * Creates a registry with default configuration and starts scanning
+     */
+    DeviceRegistry();
+
+    /**
+     * Creates a registry and starts scanning
+     * @param config Registry configuration
+     */
+    explicit DeviceRegistry(Config config);
+    DeviceRegistry(const DeviceRegistry&) = delete;
+    DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+
+    /**
+     * Stops scanning, waiting for scans in progress
+     */
+    ~DeviceRegistry();
+
+    /**
+     * Gets devices found by the latest scans, which may be outdated if nobody waits for a device or has a callback registered
+     *
+     * @returns Devices found
+     */
+    std::vector<DeviceInfo> getDevices() const;
+
+    /**
+     * Adds a callback, called for each change found by following scans. Devices already found aren't reported, see getDevices
+     *
+     * @param callback Callback
+     * @returns Callback id, to remove the callback with
+     */
+    CallbackId addCallback(Callback callback);
+
+    /**
+     * Removes a callback. Can be called from within a callback, also to remove itself.
+     * A callback removed while an event is being reported may still be called for that event
+     *
+     * @param callbackId Id of the callback to remove
+     * @returns True if removed, false if no such callback
+     */
+    bool removeCallback(CallbackId callbackId);
+
+    /**
+     * Waits until a device is selected from devices found by scans started after the call, so devices which are already gone
+     * aren't returned. Devices of each protocol are considered as soon as its scan finishes.
+     * Every protocol is scanned at least once, even if that takes longer than the timeout
+     *
+     * @param select Selects a device. Called with the registry locked
+     * @param timeout Maximum time to wait
+     * @returns Tuple of whether a device was selected and the device
+     */
+    std::tuple<bool, DeviceInfo> waitForDevice(Selector select, std::chrono::milliseconds timeout);
+
+    /**
+     * Waits until a device matching a description is found, see 'matches' and waitForDevice(Selector, timeout)
+     *
+     * @param pattern Description of the device
+     * @param timeout Maximum time to wait
+     * @param nameHintOnly Prefer a device with matching name, but accept others if there is none
+     * @returns Tuple of whether a device was found and the device
+     */
+    std::tuple<bool, DeviceInfo> waitForDevice(const DeviceInfo& pattern, std::chrono::milliseconds timeout, bool nameHintOnly = false);
+
+   private:
+    struct ProtocolState {
+        XLinkProtocol_t protocol;
+        std::vector<DeviceInfo> devices;
+        // Scans are numbered from 1. Number of the latest started, completed and successfully completed scan
+        std::uint64_t numStarted = 0;
+        std::uint64_t numCompleted = 0;
+        std::uint64_t numFound = 0;
+        bool scanRequested = true;
+    };
+
+    const Config config;
+    mutable std::mutex mtx;
+    // Signaled once a scan completes
+    std::condition_variable scannedCv;
+    // Wakes scanning threads
+    std::condition_variable scanCv;
+    std::vector<ProtocolState> protocols;
+    std::size_t numWaiters = 0;
+    bool running = true;
+    std::vector<std::thread> scanningThreads;
+
+    std::mutex callbacksMtx;
+    std::map<CallbackId, Callback> callbacks;
+    CallbackId uniqueCallbackId = 0;
+    std::size_t numCallbacks = 0;
+
+    void scan(std::size_t index);
+};
+
+}  // namespace dai
@@ -0,0 +1,142 @@
+#pragma once
+
+// Std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// project
+#include "depthai/utility/ThreadPool.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
+
+namespace dai {
+
+/**
+ * Reads from many XLink (or other packet) streams using a small, fixed number of threads,
+ * instead of a thread per stream. Each thread services its streams in turn. Once none of them
+ * has a packet available, the thread waits in a blocking timeout read on one of them (in turn), so
+ * a thread with a single stream simply blocks in reads of it.
+ *
+ * Handlers run on the reactor threads, so a handler which blocks delays other streams serviced by the same thread.
+ * Packets belonging together (eg. members of a message group) are therefore gathered across handler calls, not waited for.
+ * Output queues read by a reactor are therefore never blocking, and run their callbacks on the reactor's callback pool.
+ */
+class StreamReactor {
+   public:
+    /// Id of a registered stream
+    using StreamId = std::uint64_t;
+    /// Called for each packet received. Shouldn't wait for further packets of the stream, see class description
+    using PacketHandler = std::function<void(PacketStream& stream, StreamPacketDesc&& packet)>;
+    /// Called once, when reading from the stream or the packet handler throws. The stream is removed afterwards
+    using ErrorHandler = std::function<void(const std::exception& ex)>;
+
+    struct Config {
+        /// Number of reactor threads
+        unsigned numThreads = 2;
+        /// Timeout of the blocking read a thread waits in once none of its streams has a packet available.
+        /// Bounds the latency added to the thread's other streams meanwhile
+        std::chrono::milliseconds readTimeout{1};
+        /// Number of threads of the pool running callbacks of queues read by the reactor
+        unsigned numCallbackThreads = 1;
+    };
+
+    struct Stats {
+        /// Number of packets read
+        std::uint64_t numPackets = 0;
+        /// Number of passes over streams which read no packets
+        std::uint64_t numIdlePasses = 0;
+        /// Number of registered streams
+        std::size_t numStreams = 0;
+    };
+
+    /**
+     * Creates a reactor with default configuration
+     */
+    StreamReactor();
+
+    /**
+     * Creates a reactor
+     * @param config Reactor configuration
+     */
+    explicit StreamReactor(Config config);
+
+    /**
+     * Stops reactor threads. All streams should be removed beforehand
+     */
+    ~StreamReactor();
+
+    StreamReactor(const StreamReactor&) = delete;
+    StreamReactor& operator=(const StreamReactor&) = delete;
+
+    /**
+     * Registers a stream to be read from. Streams are assigned to the least loaded thread
+     *
+     * @param stream Stream to take ownership of
+     * @param onPacket Packet handler
+     * @param onError Error handler
+     * @returns Id of the registered stream
+     */
+    StreamId add(XLinkStream&& stream, PacketHandler onPacket, ErrorHandler onError);
+
+    /**
+     * Registers a packet stream other than XLink to be read from, eg. an in-process stream for testing without a device
+     *
+     * @param stream Stream to take ownership of
+     * @param onPacket Packet handler
+     * @param onError Error handler
+     * @returns Id of the registered stream
+     */
+    StreamId add(std::unique_ptr<PacketStream> stream, PacketHandler onPacket, ErrorHandler onError);
+
+    /**
+     * Unregisters a stream, closing it. Waits for its handler to finish, unless called from the handler itself
+     *
+     * @param id Id of the registered stream
+     */
+    void remove(StreamId id);
+
+    /**
+     * @returns Reactor configuration
+     */
+    Config getConfig() const;
+
+    /**
+     * @returns Reactor statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * @returns Thread pool running callbacks of queues read by the reactor
+     */
+    std::shared_ptr<ThreadPool> getCallbackPool() const;
+
+   private:
+    struct Entry;
+    struct Worker {
+        std::mutex mtx;
+        std::vector<std::shared_ptr<Entry>> entries;
+        // Incremented on each change of 'entries'
+        std::uint64_t version{0};
+        // Notified once a stream is added or the reactor stops
+        std::condition_variable cv;
+        std::thread thread;
+    };
+
+    const Config config;
+    std::shared_ptr<ThreadPool> callbackPool;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<StreamId> nextId{0};
+    std::atomic<bool> running{true};
+    std::atomic<std::uint64_t> numPackets{0};
+    std::atomic<std::uint64_t> numIdlePasses{0};
+
+    void run(Worker& worker);
+};
+
+}  // namespace dai
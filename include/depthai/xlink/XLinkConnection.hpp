@@ -61,6 +61,16 @@ class XLinkConnection {
      */
     static std::vector<DeviceInfo> getAllConnectedDevices(XLinkDeviceState_t state = X_LINK_ANY_STATE, bool skipInvalidDevices = true);
 
+    /**
+     * Returns information of all devices connected using a protocol, with given state
+     *
+     * @param state State which the devices should be in
+     * @param skipInvalidDevices whether or not to skip over devices that cannot be successfully communicated with
+     * @param protocol Protocol used to search for devices. Devices aren't searched for if DEPTHAI_PROTOCOL specifies another protocol
+     * @returns Vector of connected device information
+     */
+    static std::vector<DeviceInfo> getAllConnectedDevices(XLinkDeviceState_t state, bool skipInvalidDevices, XLinkProtocol_t protocol);
+
     /**
      * Returns information of first device with given state
      * @param state State which the device should be in
@@ -126,6 +136,20 @@ class XLinkConnection {
      */
     ProfilingData getProfilingData();
 
+    /**
+     * Get time taken to find the unbooted device and boot it
+     *
+     * @returns Boot time, zero if device was already booted
+     */
+    std::chrono::nanoseconds getBootTime() const;
+
+    /**
+     * Get time taken to find the booted device and connect to it
+     *
+     * @returns Connect time
+     */
+    std::chrono::nanoseconds getConnectTime() const;
+
    private:
     friend struct XLinkReadError;
     friend struct XLinkWriteError;
@@ -147,6 +171,9 @@ class XLinkConnection {
 
     DeviceInfo deviceInfo;
 
+    std::chrono::nanoseconds bootTime{0};
+    std::chrono::nanoseconds connectTime{0};
+
     // closed
     mutable std::mutex closedMtx;
     bool closed{false};
@@ -19,7 +19,12 @@
 #include <XLink/XLinkPublicDefines.h>
 #include <XLink/XLinkTime.h>
 
+#include "tl/optional.hpp"
+
 // project
+#include "depthai/utility/Histogram.hpp"
+#include "depthai/utility/Memory.hpp"
+#include "depthai/utility/ProfilingData.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 
 namespace dai {
@@ -34,7 +39,109 @@ class StreamPacketDesc : public streamPacketDesc_t {
     ~StreamPacketDesc() noexcept;
 };
 
-class XLinkStream {
+/**
+ * Memory which takes ownership of a received packet.
+ * Packet is released (XLinkDeallocateMoveData) once the last reference is dropped
+ */
+class StreamPacketMemory : public Memory {
+    StreamPacketDesc packet;
+    std::size_t size;
+
+   public:
+    /**
+     * @param packet Packet to take ownership of
+     * @param size Number of bytes, from start of the packet, to expose
+     */
+    StreamPacketMemory(StreamPacketDesc&& packet, std::size_t size);
+    span<std::uint8_t> getData() override;
+};
+
+/**
+ * Records profiling counters of a stream, concurrently with reading them.
+ * Streams only record them while profiling is enabled (see setEnabled)
+ */
+class StreamProfiler {
+    std::atomic<std::uint64_t> numPacketsRead{0};
+    std::atomic<std::uint64_t> numBytesRead{0};
+    std::atomic<std::uint64_t> numPacketsWritten{0};
+    std::atomic<std::uint64_t> numBytesWritten{0};
+    std::atomic<std::int64_t> readBlockedNs{0};
+    std::atomic<std::int64_t> writeBlockedNs{0};
+    Histogram readTime;
+    Histogram writeTime;
+    Histogram latency;
+
+   public:
+    /**
+     * Enables or disables profiling of all streams. Disabled by default, unless DEPTHAI_PROFILING=1
+     * @param enabled Whether streams record profiling counters
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @returns Whether streams record profiling counters
+     */
+    static bool isEnabled();
+
+    /**
+     * Records a read call
+     * @param duration Duration of the call
+     * @param packet Packet read or nullptr if none (timeout or error)
+     */
+    void recordRead(std::chrono::steady_clock::duration duration, const streamPacketDesc_t* packet);
+
+    /**
+     * Records a write call
+     * @param duration Duration of the call
+     * @param size Size of the packet
+     * @param written Whether the packet was written
+     */
+    void recordWrite(std::chrono::steady_clock::duration duration, std::size_t size, bool written);
+
+    /**
+     * @returns Counters recorded so far
+     */
+    StreamProfilingData getData() const;
+};
+
+/**
+ * Packet based stream, as used by data queues.
+ * Implemented by XLinkStream, other implementations let queues run over another transport (eg. in-process, for tests)
+ */
+class PacketStream {
+   public:
+    virtual ~PacketStream() = default;
+
+    /**
+     * Blocking vectored write, segments are sent as a single packet
+     * @param segments Segments of the packet
+     */
+    virtual void write(const std::vector<span<const std::uint8_t>>& segments) = 0;
+
+    /**
+     * Waits up to timeout for a packet
+     * @param packet Packet read
+     * @param timeout Maximum time to wait
+     * @returns True if a packet was read, false on timeout
+     */
+    virtual bool readMove(StreamPacketDesc& packet, std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * Waits up to timeout for a packet, then drains packets already pending without waiting
+     * @param packets Packets read are appended to it
+     * @param timeout Maximum time to wait for the first packet
+     * @param maxNumPackets Maximum number of packets appended
+     * @returns Number of packets appended (0 on timeout)
+     */
+    virtual std::size_t readMoveMany(std::vector<StreamPacketDesc>& packets, std::chrono::milliseconds timeout, std::size_t maxNumPackets = SIZE_MAX) = 0;
+
+    /**
+     * @returns Profiler of this stream, which stays valid after the stream is destroyed
+     */
+    virtual std::shared_ptr<StreamProfiler> getProfiler() const = 0;
+};
+
+class XLinkStream : public PacketStream {
     // static
     constexpr static int STREAM_OPEN_RETRIES = 5;
     constexpr static std::chrono::milliseconds WAIT_FOR_STREAM_RETRY{50};
@@ -42,6 +149,17 @@ class XLinkStream {
     std::shared_ptr<XLinkConnection> connection;
     std::string streamName;
     streamId_t streamId{INVALID_STREAM_ID};
+    // Reused for gathering trailing segments of vectored writes (usually metadata), see shrinkGatherBuffer
+    std::vector<std::uint8_t> gatherBuffer;
+    // Shared, so counters can be read while another thread uses the stream
+    std::shared_ptr<StreamProfiler> profiler{std::make_shared<StreamProfiler>()};
+
+    // Profiled XLink calls
+    XLinkError_t readMoveData(StreamPacketDesc& packet);
+    XLinkError_t readMoveData(StreamPacketDesc& packet, std::chrono::milliseconds timeout);
+    XLinkError_t writeData(const std::uint8_t* data, std::size_t size);
+    XLinkError_t writeData(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout);
+    XLinkError_t writeData(const std::uint8_t* data1, std::size_t size1, const std::uint8_t* data2, std::size_t size2);
 
    public:
     XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std::string& name, std::size_t maxWriteSize);
@@ -55,6 +173,17 @@ class XLinkStream {
     void write(const void* data, std::size_t size);
     void write(const std::uint8_t* data, std::size_t size);
     void write(const std::vector<std::uint8_t>& data);
+    /**
+     * Blocking vectored write, segments are sent as a single packet.
+     * The first segment (eg. message data) is sent in place, along with the second one. Any further segments
+     * are copied together with the second one into a buffer, which is reused across writes
+     * @param segments Segments of the packet
+     */
+    void write(const std::vector<span<const std::uint8_t>>& segments) override;
+    /**
+     * Releases the buffer used for gathering segments of vectored writes
+     */
+    void shrinkGatherBuffer();
     std::vector<std::uint8_t> read();
     std::vector<std::uint8_t> read(XLinkTimespec& timestampReceived);
     void read(std::vector<std::uint8_t>& data);
@@ -69,8 +198,12 @@ class XLinkStream {
     bool write(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout);
     bool write(const std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout);
     bool read(std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout);
-    bool readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout);
-    // TODO optional<StreamPacketDesc> readMove(timeout) -or- tuple<bool, StreamPacketDesc> readMove(timeout)
+    bool readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout) override;
+    // returns nullopt on timeout
+    tl::optional<StreamPacketDesc> readMove(std::chrono::milliseconds timeout);
+    // waits up to timeout for a packet, then drains packets already pending without waiting.
+    // Appends at most maxNumPackets to 'packets' and returns the number appended (0 on timeout)
+    std::size_t readMoveMany(std::vector<StreamPacketDesc>& packets, std::chrono::milliseconds timeout, std::size_t maxNumPackets = SIZE_MAX) override;
 
     // deprecated use readMove() instead; readRaw leads to memory violations and/or memory leaks
     [[deprecated("use readMove()")]] streamPacketDesc_t* readRaw();
@@ -80,6 +213,16 @@ class XLinkStream {
     [[deprecated]] void readRawRelease();
 
     streamId_t getStreamId() const;
+
+    /**
+     * @returns Profiling counters of this stream
+     */
+    StreamProfilingData getProfilingData() const;
+
+    /**
+     * @returns Profiler of this stream, which stays valid after the stream is moved or destroyed
+     */
+    std::shared_ptr<StreamProfiler> getProfiler() const override;
 };
 
 struct XLinkError : public std::runtime_error {
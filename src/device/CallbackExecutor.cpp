@@ -0,0 +1,162 @@
+#include "depthai/device/CallbackExecutor.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+// libraries
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+CallbackExecutor::CallbackExecutor(Config cfg) : config(std::move(cfg)), state(std::make_shared<State>()) {
+    if(config.mode == Mode::POOL && config.pool == nullptr) {
+        throw std::invalid_argument("CallbackExecutor in POOL mode requires a thread pool");
+    }
+
+    if(config.mode == Mode::THREAD) {
+        // Only touches the shared state, as the executor might be destroyed by one of the tasks
+        thread = std::thread([state = state]() {
+            std::unique_lock<std::mutex> lock(state->mtx);
+            while(true) {
+                state->cv.wait(lock, [&state]() { return !state->pending.empty() || state->stopping; });
+                // Execute pending tasks before stopping
+                if(state->pending.empty()) return;
+
+                auto task = std::move(state->pending.front());
+                state->pending.pop_front();
+                state->stats.numPending = state->pending.size();
+                lock.unlock();
+                state->cv.notify_all();
+
+                run(*state, task);
+                lock.lock();
+            }
+        });
+    }
+}
+
+CallbackExecutor::~CallbackExecutor() {
+    stop();
+    // Destroyed from within a task on its own thread, which keeps the shared state alive until it finishes
+    if(thread.joinable()) thread.detach();
+}
+
+bool CallbackExecutor::execute(std::function<void()> task) {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    if(state->stopping) {
+        state->stats.numDropped++;
+        return false;
+    }
+    state->stats.numScheduled++;
+
+    if(config.mode == Mode::INLINE) {
+        lock.unlock();
+        run(*state, task);
+        return true;
+    }
+
+    bool dropped = false;
+    if(config.maxPending != 0 && state->pending.size() >= config.maxPending) {
+        switch(config.overflowPolicy) {
+            case OverflowPolicy::BLOCK:
+                state->cv.wait(lock, [this]() { return state->pending.size() < config.maxPending || state->stopping; });
+                if(state->stopping) {
+                    state->stats.numDropped++;
+                    return false;
+                }
+                break;
+            case OverflowPolicy::DROP_OLDEST:
+                while(state->pending.size() >= config.maxPending) {
+                    state->pending.pop_front();
+                    state->stats.numDropped++;
+                }
+                dropped = true;
+                break;
+            case OverflowPolicy::DROP_NEWEST:
+                state->stats.numDropped++;
+                return false;
+        }
+    }
+
+    state->pending.push_back(std::move(task));
+    state->stats.numPending = state->pending.size();
+    state->stats.maxNumPending = std::max(state->stats.maxNumPending, state->stats.numPending);
+
+    // Pending tasks are executed by a single pool task at a time, to keep them in order
+    bool schedule = false;
+    if(config.mode == Mode::POOL && !state->draining) {
+        state->draining = true;
+        schedule = true;
+    }
+    lock.unlock();
+
+    if(schedule) {
+        auto self = shared_from_this();
+        config.pool->submit([self]() { self->drain(); });
+    } else {
+        state->cv.notify_all();
+    }
+    return !dropped;
+}
+
+void CallbackExecutor::stop() {
+    {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        state->stopping = true;
+    }
+    state->cv.notify_all();
+
+    if(thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+        thread.join();
+    }
+
+    if(config.mode == Mode::POOL) {
+        // Wait for the pool to execute pending tasks, unless called from one of them
+        std::unique_lock<std::mutex> lock(state->mtx);
+        if(state->drainingThread != std::this_thread::get_id()) {
+            state->cv.wait(lock, [this]() { return !state->draining; });
+        }
+    }
+}
+
+CallbackExecutor::Config CallbackExecutor::getConfig() const {
+    return config;
+}
+
+CallbackExecutor::Stats CallbackExecutor::getStats() const {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    return state->stats;
+}
+
+void CallbackExecutor::run(State& state, std::function<void()>& task) {
+    try {
+        task();
+    } catch(const std::exception& ex) {
+        logger::error("Callback task threw an exception: {}", ex.what());
+    }
+
+    std::unique_lock<std::mutex> lock(state.mtx);
+    state.stats.numExecuted++;
+}
+
+void CallbackExecutor::drain() {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->drainingThread = std::this_thread::get_id();
+    while(!state->pending.empty()) {
+        auto task = std::move(state->pending.front());
+        state->pending.pop_front();
+        state->stats.numPending = state->pending.size();
+        lock.unlock();
+        state->cv.notify_all();
+
+        run(*state, task);
+        lock.lock();
+    }
+    state->drainingThread = std::thread::id();
+    state->draining = false;
+    lock.unlock();
+    state->cv.notify_all();
+}
+
+}  // namespace dai
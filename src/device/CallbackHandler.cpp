@@ -6,6 +6,11 @@
 
 namespace dai {
 
+namespace {
+// Bounds how long the thread takes to notice destruction
+constexpr std::chrono::milliseconds READ_TIMEOUT{100};
+}  // namespace
+
 void CallbackHandler::setCallback(std::function<std::shared_ptr<RawBuffer>(std::shared_ptr<RawBuffer>)> cb) {
     callback = std::move(cb);
 }
@@ -21,17 +26,18 @@ CallbackHandler::CallbackHandler(std::shared_ptr<XLinkConnection> conn,
             XLinkStream stream(connection, streamName, device::XLINK_USB_BUFFER_MAX_SIZE);
 
             while(running) {
-                // Blocking -- parse packet
-                auto packet = stream.readMove();
-                const auto data = StreamMessageParser::parseMessage(&packet);
+                // Timeout -- parse packet
+                auto packet = stream.readMove(READ_TIMEOUT);
+                if(!packet) continue;
+                const auto data = StreamMessageParser::parseMessage(&*packet);
 
                 // CALLBACK
                 auto toSend = callback(std::move(data));
 
-                auto serialized = StreamMessageParser::serializeMessage(toSend);
+                auto serialized = StreamMessageParser::serializeMetadata(toSend);
 
                 // Write packet back
-                stream.write(serialized);
+                stream.write({toSend->data, serialized});
             }
 
         } catch(const std::exception&) {
@@ -42,9 +48,9 @@ CallbackHandler::CallbackHandler(std::shared_ptr<XLinkConnection> conn,
 }
 
 CallbackHandler::~CallbackHandler() {
-    // detach from thread, because currently no way to unblock underlying XLinkReadData
+    // reads time out, so the thread notices shortly and can be joined
     running = false;
-    t.detach();
+    if(t.joinable()) t.join();
 }
 
 }  // namespace dai
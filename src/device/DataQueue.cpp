@@ -1,6 +1,7 @@
 #include "depthai/device/DataQueue.hpp"
 
 // std
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <memory>
@@ -9,6 +10,7 @@
 #include "depthai-shared/datatype/DatatypeEnum.hpp"
 #include "depthai-shared/datatype/RawMessageGroup.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/pipeline/datatype/EncodedFrame.hpp"
 #include "depthai/xlink/XLinkStream.hpp"
 #include "pipeline/datatype/MessageGroup.hpp"
 #include "pipeline/datatype/StreamMessageParser.hpp"
@@ -25,76 +27,55 @@
 
 namespace dai {
 
+namespace {
+// Size of deserialized metadata isn't tracked, so a rough estimate is counted for each message
+constexpr std::size_t METADATA_SIZE_ESTIMATE = 1024;
+// Bounds how long the reading thread takes to notice closing
+constexpr std::chrono::milliseconds READ_TIMEOUT{100};
+}  // namespace
+
 // DATA OUTPUT QUEUE
 DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize, bool blocking)
-    : queue(maxSize, blocking), name(streamName) {
+    : queue(maxSize, blocking), ringQueue(maxSize, blocking), name(streamName) {
+    queue.setSizeFunction(messageSize);
+
     // Create stream first and then pass to thread
     // Open stream with 1B write size (no writing will happen here)
-    XLinkStream stream(std::move(conn), name, 1);
+    startReading(std::make_unique<XLinkStream>(std::move(conn), name, 1));
+}
+
+DataOutputQueue::DataOutputQueue(std::unique_ptr<PacketStream> stream, const std::string& streamName, unsigned int maxSize, bool blocking)
+    : queue(maxSize, blocking), ringQueue(maxSize, blocking), name(streamName) {
+    if(stream == nullptr) throw std::invalid_argument("PacketStream passed is not valid (nullptr)");
+    queue.setSizeFunction(messageSize);
+    startReading(std::move(stream));
+}
+
+void DataOutputQueue::startReading(std::unique_ptr<PacketStream> stream) {
+    profiler = stream->getProfiler();
 
     // Creates a thread which reads from connection into the queue
     readingThread = std::thread([this, stream = std::move(stream)]() mutable {
         std::uint64_t numPacketsRead = 0;
+        PacketBatch batch;
         try {
             while(running) {
-                // Blocking -- parse packet and gather timing information
-                auto packet = stream.readMove();
-                DatatypeEnum type;
-                const auto t1Parse = std::chrono::steady_clock::now();
-                const auto data = StreamMessageParser::parseMessageToADatatype(&packet, type);
-                if(type == DatatypeEnum::MessageGroup) {
-                    auto msgGrp = std::static_pointer_cast<MessageGroup>(data);
-                    unsigned int size = msgGrp->getNumMessages();
-                    std::vector<std::shared_ptr<ADatatype>> packets;
-                    packets.reserve(size);
-                    for(unsigned int i = 0; i < size; ++i) {
-                        auto dpacket = stream.readMove();
-                        packets.push_back(StreamMessageParser::parseMessageToADatatype(&dpacket));
-                    }
-                    auto rawMsgGrp = std::static_pointer_cast<RawMessageGroup>(data->getRaw());
-                    for(auto& msg : rawMsgGrp->group) {
-                        msgGrp->add(msg.first, packets[msg.second.index]);
-                    }
-                }
-                const auto t2Parse = std::chrono::steady_clock::now();
-
-                // Trace level debugging
-                if(logger::get_level() == spdlog::level::trace) {
-                    std::vector<std::uint8_t> metadata;
-                    DatatypeEnum type;
-                    data->getRaw()->serialize(metadata, type);
-                    logger::trace("Received message from device ({}) - parsing time: {}, data size: {}, object type: {} object data: {}",
-                                  name,
-                                  std::chrono::duration_cast<std::chrono::microseconds>(t2Parse - t1Parse),
-                                  data->getRaw()->data.size(),
-                                  static_cast<std::int32_t>(type),
-                                  spdlog::to_hex(metadata));
-                }
-
-                // Add 'data' to queue
-                if(!queue.push(data)) {
-                    throw std::runtime_error(fmt::format("Underlying queue destructed"));
-                }
-
-                // Increment numPacketsRead
-                numPacketsRead++;
-
-                // Call callbacks
-                {
-                    std::unique_lock<std::mutex> l(callbacksMtx);
-                    for(const auto& kv : callbacks) {
-                        const auto& callback = kv.second;
-                        try {
-                            callback(name, data);
-                        } catch(const std::exception& ex) {
-                            logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
-                        }
-                    }
+                // Timeout -- take all pending packets, then parse them and gather timing information
+                batch.packets.clear();
+                batch.next = 0;
+                stream->readMoveMany(batch.packets, READ_TIMEOUT);
+                // Message groups consume their members from the batch, advancing 'next' past them
+                while(running && batch.next < batch.packets.size()) {
+                    StreamPacketDesc packet = std::move(batch.packets[batch.next++]);
+                    processPacket(*stream, std::move(packet), batch);
+
+                    // Increment numPacketsRead
+                    numPacketsRead++;
                 }
             }
 
         } catch(const std::exception& ex) {
-            exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
+            if(running) exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
         }
 
         // Close the queue
@@ -102,6 +83,186 @@ DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, co
     });
 }
 
+DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn,
+                                 const std::string& streamName,
+                                 std::shared_ptr<StreamReactor> streamReactor,
+                                 unsigned int maxSize)
+    // Open stream with 1B write size (no writing will happen here)
+    : DataOutputQueue(std::make_unique<XLinkStream>(std::move(conn), streamName, 1), streamName, std::move(streamReactor), maxSize) {}
+
+DataOutputQueue::DataOutputQueue(std::unique_ptr<PacketStream> stream,
+                                 const std::string& streamName,
+                                 std::shared_ptr<StreamReactor> streamReactor,
+                                 unsigned int maxSize)
+    : queue(maxSize, false), ringQueue(maxSize, false), reactor(std::move(streamReactor)), name(streamName) {
+    if(stream == nullptr) throw std::invalid_argument("PacketStream passed is not valid (nullptr)");
+    if(reactor == nullptr) throw std::invalid_argument("StreamReactor passed is not valid (nullptr)");
+    queue.setSizeFunction(messageSize);
+    // Callbacks run off the reactor threads
+    setCallbackExecutor({});
+    profiler = stream->getProfiler();
+
+    // Reactor threads read from connection into the queue
+    reactorStreamId = reactor->add(
+        std::move(stream),
+        [this](PacketStream&, StreamPacketDesc&& packet) {
+            // Members of a message group follow as separate packets. They are gathered across calls instead of
+            // waited for, which would stall other streams read by the same reactor thread
+            receivePacket(std::move(packet), reactorMessage);
+            if(!reactorMessage.isComplete()) return;
+            ReceivedMessage msg = std::move(reactorMessage);
+            reactorMessage = ReceivedMessage();
+            pushMessage(msg);
+        },
+        [this](const std::exception& ex) {
+            if(running) exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
+            close();
+        });
+}
+
+void DataOutputQueue::processPacket(PacketStream& stream, StreamPacketDesc&& packet, PacketBatch& batch) {
+    ReceivedMessage msg;
+    receivePacket(std::move(packet), msg);
+    while(!msg.isComplete()) {
+        StreamPacketDesc member;
+        if(batch.next < batch.packets.size()) {
+            // Read together with the group
+            member = std::move(batch.packets[batch.next++]);
+        } else {
+            // Messages of the group follow shortly, but keep noticing closing while waiting for them
+            while(!stream.readMove(member, READ_TIMEOUT)) {
+                if(!running) throw std::runtime_error(fmt::format("Queue {} closed while reading a message group", name));
+            }
+        }
+        receivePacket(std::move(member), msg);
+    }
+    pushMessage(msg);
+}
+
+void DataOutputQueue::receivePacket(StreamPacketDesc&& packet, ReceivedMessage& msg) {
+    DatatypeEnum type;
+    const auto pool = std::atomic_load(&messagePool);
+    const auto t1Parse = std::chrono::steady_clock::now();
+    msg.numBytes += packet.length;
+    if(msg.data == nullptr) {
+        const bool lazy = lazyMetadata;
+        msg.data = zeroCopy ? StreamMessageParser::parseMessageToADatatype(std::move(packet), type, pool, lazy)
+                            : StreamMessageParser::parseMessageToADatatype(&packet, type, pool, lazy);
+        if(type == DatatypeEnum::MessageGroup) {
+            msg.numMembers = std::static_pointer_cast<MessageGroup>(msg.data)->getNumMessages();
+            msg.members.reserve(msg.numMembers);
+        }
+    } else {
+        msg.members.push_back(zeroCopy ? StreamMessageParser::parseMessageToADatatype(std::move(packet), type, pool)
+                                       : StreamMessageParser::parseMessageToADatatype(&packet, type, pool));
+    }
+    msg.parseDuration += std::chrono::steady_clock::now() - t1Parse;
+}
+
+void DataOutputQueue::pushMessage(ReceivedMessage& msg) {
+    const auto data = std::move(msg.data);
+    if(msg.numMembers > 0) {
+        // Members are adopted without copying, so only take the group's own raw message
+        auto msgGrp = std::static_pointer_cast<MessageGroup>(data);
+        data->decodeMetadata();
+        auto rawMsgGrp = std::static_pointer_cast<RawMessageGroup>(data->raw);
+        for(auto& member : rawMsgGrp->group) {
+            msgGrp->add(member.first, msg.members[member.second.index]);
+        }
+    }
+    numReceived++;
+    bytesReceived += msg.numBytes;
+    parseTime.record(msg.parseDuration);
+
+    // Trace level debugging
+    if(logger::get_level() == spdlog::level::trace) {
+        std::vector<std::uint8_t> metadata;
+        DatatypeEnum type;
+        data->getRaw()->serialize(metadata, type);
+        logger::trace("Received message from device ({}) - parsing time: {}, data size: {}, object type: {} object data: {}",
+                      name,
+                      std::chrono::duration_cast<std::chrono::microseconds>(msg.parseDuration),
+                      data->getRaw()->data.size(),
+                      static_cast<std::int32_t>(type),
+                      spdlog::to_hex(metadata));
+    }
+
+    // Add 'data' to queue, without holding 'pushMtx' while a full blocking queue waits for consumers.
+    // Messages moved by setQueueBackend meanwhile are pushed here as well, keeping this the only producer
+    std::vector<std::shared_ptr<ADatatype>> pending;
+    QueueBackend pushBackend;
+    std::uint64_t pushSwitches;
+    {
+        std::unique_lock<std::mutex> lock(pushMtx);
+        pushBackend = backend;
+        pushSwitches = numSwitches;
+        pending.swap(movedMessages);
+        pushing = true;
+    }
+    pending.push_back(data);
+    bool pushed = true;
+    while(true) {
+        // Stops once the backend is switched, the rest then follows the moved messages
+        std::size_t numPushed = 0;
+        while(pushed && numPushed < pending.size() && numSwitches == pushSwitches) {
+            pushed = withQueue(pushBackend, [&](auto& q) { return q.push(pending[numPushed]); });
+            numPushed++;
+        }
+
+        std::unique_lock<std::mutex> lock(pushMtx);
+        if(!pushed) {
+            pushing = false;
+            break;
+        }
+        std::vector<std::shared_ptr<ADatatype>> next;
+        next.swap(movedMessages);
+        if(numSwitches != pushSwitches) {
+            // Messages might have landed in the previous queue after its messages were moved over
+            withQueue(pushBackend, [&next](auto& q) {
+                return q.consumeAll([&next](std::shared_ptr<ADatatype>& msg) { next.push_back(std::move(msg)); });
+            });
+            pushBackend = backend;
+            pushSwitches = numSwitches;
+        }
+        next.insert(next.end(), pending.begin() + numPushed, pending.end());
+        pending.swap(next);
+        if(pending.empty()) {
+            pushing = false;
+            break;
+        }
+    }
+    if(!pushed) {
+        throw std::runtime_error(fmt::format("Underlying queue destructed"));
+    }
+
+    // Hand over to asynchronous waiters
+    if(numAsyncWaiters > 0) dispatchAsyncWaiters();
+
+    // Notify pollers
+    if(auto eventNotifier = activeNotifier.load()) eventNotifier->notify();
+
+    // Call callbacks
+    {
+        std::unique_lock<std::mutex> l(internalCallbacksMtx);
+        for(const auto& kv : internalCallbacks) {
+            try {
+                kv.second(name, data);
+            } catch(const std::exception& ex) {
+                logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
+            }
+        }
+    }
+    if(numCallbacks > 0) {
+        data->decodeMetadata();
+        auto executor = std::atomic_load(&callbackExecutor);
+        if(executor) {
+            executor->execute([this, data]() { callCallbacks(data); });
+        } else {
+            callCallbacks(data);
+        }
+    }
+}
+
 // This function is thread-unsafe. The idea of "isClosed" is ephemerial and
 // since there is no mutex lock, its state is outdated and invalid even before
 // the logical NOT in this function. This calculated boolean then continues to degrade
@@ -116,9 +277,23 @@ void DataOutputQueue::close() {
 
     // Destroy queue
     queue.destruct();
+    ringQueue.destruct();
+    latestQueue.destruct();
 
     // Then join thread
     if((readingThread.get_id() != std::this_thread::get_id()) && readingThread.joinable()) readingThread.join();
+    // Or stop reading with reactor
+    if(reactor) reactor->remove(reactorStreamId);
+
+    // Complete asynchronous waiters with an error
+    failAsyncWaiters();
+
+    // Wake pollers, so they notice the queue was closed
+    if(auto eventNotifier = activeNotifier.load()) eventNotifier->notify();
+
+    // Finish pending callbacks
+    auto executor = std::atomic_load(&callbackExecutor);
+    if(executor) executor->stop();
 
     // Log
     logger::debug("DataOutputQueue ({}) closed", name);
@@ -134,7 +309,12 @@ DataOutputQueue::~DataOutputQueue() {
 
 void DataOutputQueue::setBlocking(bool blocking) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    if(reactor != nullptr && blocking) {
+        logger::warn("Queue {} is read by a stream reactor and stays non-blocking", name);
+        return;
+    }
     queue.setBlocking(blocking);
+    ringQueue.setBlocking(blocking);
 }
 
 bool DataOutputQueue::getBlocking() const {
@@ -145,6 +325,7 @@ bool DataOutputQueue::getBlocking() const {
 void DataOutputQueue::setMaxSize(unsigned int maxSize) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
     queue.setMaxSize(maxSize);
+    ringQueue.setMaxSize(maxSize);
 }
 
 unsigned int DataOutputQueue::getMaxSize() const {
@@ -152,6 +333,148 @@ unsigned int DataOutputQueue::getMaxSize() const {
     return queue.getMaxSize();
 }
 
+void DataOutputQueue::setMaxBytes(std::size_t maxBytes) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    queue.setMaxBytes(maxBytes);
+}
+
+std::size_t DataOutputQueue::getMaxBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getMaxBytes();
+}
+
+void DataOutputQueue::setMemoryBudget(std::shared_ptr<MemoryBudget> budget) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    queue.setMemoryBudget(std::move(budget));
+}
+
+std::shared_ptr<MemoryBudget> DataOutputQueue::getMemoryBudget() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getMemoryBudget();
+}
+
+std::size_t DataOutputQueue::getQueuedBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getBytes();
+}
+
+void DataOutputQueue::setDropPolicy(DropPolicy policy) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    switch(policy) {
+        case DropPolicy::OLDEST:
+            queue.setDependencyFunction(nullptr);
+            break;
+        case DropPolicy::KEYFRAME_AWARE:
+            queue.setDependencyFunction(isDependentFrame);
+            break;
+        case DropPolicy::CUSTOM:
+            throw std::invalid_argument("CUSTOM drop policy is set by passing a dependency function");
+    }
+    dropPolicy = policy;
+}
+
+void DataOutputQueue::setDropPolicy(std::function<bool(const std::shared_ptr<ADatatype>&)> dependsOnPrevious) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    if(!dependsOnPrevious) throw std::invalid_argument("Dependency function passed is not valid");
+    queue.setDependencyFunction(std::move(dependsOnPrevious));
+    dropPolicy = DropPolicy::CUSTOM;
+}
+
+DataOutputQueue::DropPolicy DataOutputQueue::getDropPolicy() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return dropPolicy;
+}
+
+bool DataOutputQueue::isDependentFrame(const std::shared_ptr<ADatatype>& msg) {
+    // Only inspect encoded frames, without decoding metadata of other messages
+    if(msg == nullptr || msg->raw->getType() != DatatypeEnum::EncodedFrame) return false;
+    auto frame = std::dynamic_pointer_cast<EncodedFrame>(msg);
+    if(frame == nullptr) return false;
+    msg->decodeMetadata();
+    // RawEncodedFrame doesn't distinguish IDR frames, so every I-frame is treated as a keyframe
+    switch(frame->getFrameType()) {
+        case EncodedFrame::FrameType::P:
+        case EncodedFrame::FrameType::B:
+            return true;
+        case EncodedFrame::FrameType::I:
+        case EncodedFrame::FrameType::Unknown:
+            return false;
+    }
+    return false;
+}
+
+std::size_t DataOutputQueue::messageSize(const std::shared_ptr<ADatatype>& msg) {
+    if(msg == nullptr) return 0;
+    // Adopted data isn't in 'raw->data'
+    return msg->getRawDataView().size() + METADATA_SIZE_ESTIMATE;
+}
+
+void DataOutputQueue::setZeroCopy(bool zeroCopy) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    this->zeroCopy = zeroCopy;
+}
+
+bool DataOutputQueue::getZeroCopy() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return zeroCopy;
+}
+
+void DataOutputQueue::setMessagePool(std::shared_ptr<MessagePool> pool) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    std::atomic_store(&messagePool, std::move(pool));
+}
+
+std::shared_ptr<MessagePool> DataOutputQueue::getMessagePool() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return std::atomic_load(&messagePool);
+}
+
+void DataOutputQueue::setLazyMetadata(bool lazy) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    lazyMetadata = lazy;
+}
+
+bool DataOutputQueue::getLazyMetadata() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return lazyMetadata;
+}
+
+void DataOutputQueue::setQueueBackend(QueueBackend backend) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+
+    // The reading thread picks the backend under the same lock, but doesn't hold it while pushing
+    std::unique_lock<std::mutex> lock(pushMtx);
+    const auto previous = this->backend.load();
+    if(backend == previous) return;
+    this->backend = backend;
+    numSwitches++;
+
+    // Move over queued messages, keeping their order. Emptying the previous queue also wakes the reading thread,
+    // if it is blocked on it being full, after which it moves its message over itself
+    std::vector<std::shared_ptr<ADatatype>> queued;
+    withQueue(previous, [&queued](auto& q) {
+        return q.consumeAll([&queued](std::shared_ptr<ADatatype>& msg) { queued.push_back(std::move(msg)); });
+    });
+    if(pushing) {
+        // Pushed by the reading thread once it's done, as it may be pushing to the same queue
+        movedMessages.insert(movedMessages.end(), queued.begin(), queued.end());
+        return;
+    }
+    // The reading thread doesn't push while 'pushMtx' is held. Never waits for consumers, messages which don't fit are dropped
+    for(const auto& msg : queued) {
+        if(!withQueue(backend, [&msg](auto& q) { return q.tryWaitAndPush(msg, std::chrono::milliseconds(0)); })) numMoveDropped++;
+    }
+}
+
+DataOutputQueue::QueueBackend DataOutputQueue::getQueueBackend() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return backend;
+}
+
+std::uint64_t DataOutputQueue::getNumOverwritten() const {
+    return latestQueue.getNumOverwritten();
+}
+
 std::string DataOutputQueue::getName() const {
     return name;
 }
@@ -165,11 +488,19 @@ int DataOutputQueue::addCallback(std::function<void(std::string, std::shared_ptr
 
     // move assign callback
     callbacks[id] = std::move(callback);
+    numCallbacks = callbacks.size();
 
     // return id assigned to the callback
     return id;
 }
 
+int DataOutputQueue::addInternalCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback) {
+    std::unique_lock<std::mutex> l(internalCallbacksMtx);
+    int id = uniqueCallbackId++;
+    internalCallbacks[id] = std::move(callback);
+    return id;
+}
+
 int DataOutputQueue::addCallback(std::function<void(std::shared_ptr<ADatatype>)> callback) {
     // Create a wrapper
     return addCallback([callback = std::move(callback)](std::string, std::shared_ptr<ADatatype> message) { callback(std::move(message)); });
@@ -181,6 +512,11 @@ int DataOutputQueue::addCallback(std::function<void()> callback) {
 }
 
 bool DataOutputQueue::removeCallback(int callbackId) {
+    {
+        std::unique_lock<std::mutex> l(internalCallbacksMtx);
+        if(internalCallbacks.erase(callbackId) != 0) return true;
+    }
+
     // Lock first
     std::unique_lock<std::mutex> l(callbacksMtx);
 
@@ -189,66 +525,333 @@ bool DataOutputQueue::removeCallback(int callbackId) {
 
     // Otherwise erase and return true
     callbacks.erase(callbackId);
+    callbackStats.erase(callbackId);
+    numCallbacks = callbacks.size();
     return true;
 }
 
+void DataOutputQueue::callCallbacks(const std::shared_ptr<ADatatype>& msg) {
+    std::unique_lock<std::mutex> l(callbacksMtx);
+    for(const auto& kv : callbacks) {
+        const auto& callback = kv.second;
+        auto& stats = callbackStats[kv.first];
+        const auto t1 = std::chrono::steady_clock::now();
+        try {
+            callback(name, msg);
+        } catch(const std::exception& ex) {
+            stats.numExceptions++;
+            logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
+        }
+        const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t1);
+        stats.numCalls++;
+        stats.totalTime += duration;
+        stats.maxTime = std::max(stats.maxTime, duration);
+        callbackTime.record(duration);
+    }
+}
+
+void DataOutputQueue::setCallbackExecutor(CallbackExecutor::Config config) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    if(reactor != nullptr) {
+        // Neither run nor wait for callbacks on reactor threads, which read other streams too
+        if(config.mode == CallbackExecutor::Mode::INLINE) {
+            config.mode = CallbackExecutor::Mode::POOL;
+            config.pool = reactor->getCallbackPool();
+        }
+        if(config.overflowPolicy == CallbackExecutor::OverflowPolicy::BLOCK) {
+            config.overflowPolicy = CallbackExecutor::OverflowPolicy::DROP_OLDEST;
+        }
+    }
+    std::shared_ptr<CallbackExecutor> executor;
+    if(config.mode != CallbackExecutor::Mode::INLINE) {
+        executor = std::make_shared<CallbackExecutor>(std::move(config));
+    }
+    auto previous = std::atomic_exchange(&callbackExecutor, executor);
+    // Let callbacks scheduled on the previous executor finish
+    if(previous) previous->stop();
+}
+
+CallbackExecutor::Config DataOutputQueue::getCallbackExecutor() const {
+    auto executor = std::atomic_load(&callbackExecutor);
+    if(executor) return executor->getConfig();
+    return {};
+}
+
+CallbackExecutor::Stats DataOutputQueue::getCallbackExecutorStats() const {
+    auto executor = std::atomic_load(&callbackExecutor);
+    if(executor) return executor->getStats();
+    return {};
+}
+
+void DataOutputQueue::getAsync(AsyncHandler handler) {
+    if(!handler) throw std::invalid_argument("Handler passed is not valid (empty)");
+    AsyncWaiter waiter;
+    waiter.group = std::make_shared<AsyncGroup>();
+    waiter.handler = [handler = std::move(handler)](const std::string&, std::shared_ptr<ADatatype> msg, std::exception_ptr error) {
+        handler(std::move(msg), error);
+    };
+    addAsyncWaiter(std::move(waiter));
+}
+
+std::future<std::shared_ptr<ADatatype>> DataOutputQueue::getAsync() {
+    auto promise = std::make_shared<std::promise<std::shared_ptr<ADatatype>>>();
+    auto future = promise->get_future();
+    getAsync([promise](std::shared_ptr<ADatatype> msg, std::exception_ptr error) {
+        if(error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(msg));
+        }
+    });
+    return future;
+}
+
+void DataOutputQueue::getAnyAsync(const std::vector<std::shared_ptr<DataOutputQueue>>& queues, AnyAsyncHandler handler) {
+    if(queues.empty()) throw std::invalid_argument("No queues passed");
+    if(!handler) throw std::invalid_argument("Handler passed is not valid (empty)");
+    for(const auto& queue : queues) {
+        if(queue == nullptr) throw std::invalid_argument("DataOutputQueue passed is not valid (nullptr)");
+    }
+
+    AsyncWaiter waiter;
+    waiter.group = std::make_shared<AsyncGroup>();
+    waiter.handler = [handler = std::move(handler)](const std::string& name, std::shared_ptr<ADatatype> msg, std::exception_ptr error) {
+        handler(name, std::move(msg), error);
+    };
+    for(const auto& queue : queues) {
+        queue->addAsyncWaiter(waiter);
+    }
+}
+
+std::future<std::pair<std::string, std::shared_ptr<ADatatype>>> DataOutputQueue::getAnyAsync(const std::vector<std::shared_ptr<DataOutputQueue>>& queues) {
+    auto promise = std::make_shared<std::promise<std::pair<std::string, std::shared_ptr<ADatatype>>>>();
+    auto future = promise->get_future();
+    getAnyAsync(queues, [promise](std::string name, std::shared_ptr<ADatatype> msg, std::exception_ptr error) {
+        if(error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value({std::move(name), std::move(msg)});
+        }
+    });
+    return future;
+}
+
+void DataOutputQueue::addAsyncWaiter(AsyncWaiter waiter) {
+    std::shared_ptr<ADatatype> msg;
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(asyncMtx);
+
+        // Drop waiters completed by another queue, which otherwise pile up on queues that rarely receive messages
+        const auto numWaiters = asyncWaiters.size();
+        asyncWaiters.erase(std::remove_if(asyncWaiters.begin(),
+                                          asyncWaiters.end(),
+                                          [](const AsyncWaiter& w) {
+                                              std::unique_lock<std::mutex> groupLock(w.group->mtx);
+                                              return w.group->done;
+                                          }),
+                           asyncWaiters.end());
+        numAsyncWaiters -= numWaiters - asyncWaiters.size();
+
+        std::unique_lock<std::mutex> groupLock(waiter.group->mtx);
+        // Already completed by another queue
+        if(waiter.group->done) return;
+
+        if(!running) {
+            error = std::make_exception_ptr(std::runtime_error(exceptionMessage.c_str()));
+        } else {
+            // Announce the waiter before checking the queue, so the reading thread either sees it or its message is found here
+            numAsyncWaiters++;
+            if(!withQueue([&msg](auto& q) { return q.tryPop(msg); })) {
+                groupLock.unlock();
+                asyncWaiters.push_back(std::move(waiter));
+                return;
+            }
+            numAsyncWaiters--;
+        }
+        waiter.group->done = true;
+    }
+
+    // Complete right away
+    try {
+        waiter.handler(name, prepare<ADatatype>(std::move(msg)), error);
+    } catch(const std::exception& ex) {
+        logger::error("Async handler of queue {} threw an exception: {}", name, ex.what());
+    }
+}
+
+void DataOutputQueue::dispatchAsyncWaiters() {
+    std::vector<std::pair<AsyncWaiter, std::shared_ptr<ADatatype>>> completed;
+    {
+        std::unique_lock<std::mutex> lock(asyncMtx);
+        while(!asyncWaiters.empty()) {
+            auto& waiter = asyncWaiters.front();
+            {
+                std::unique_lock<std::mutex> groupLock(waiter.group->mtx);
+                // Otherwise drop waiter completed by another queue
+                if(!waiter.group->done) {
+                    std::shared_ptr<ADatatype> msg;
+                    if(!withQueue([&msg](auto& q) { return q.tryPop(msg); })) break;
+                    waiter.group->done = true;
+                    completed.emplace_back(std::move(waiter), std::move(msg));
+                }
+            }
+            asyncWaiters.pop_front();
+            numAsyncWaiters--;
+        }
+    }
+
+    // Call handlers without holding locks
+    for(auto& kv : completed) {
+        try {
+            kv.first.handler(name, prepare<ADatatype>(std::move(kv.second)), nullptr);
+        } catch(const std::exception& ex) {
+            logger::error("Async handler of queue {} threw an exception: {}", name, ex.what());
+        }
+    }
+}
+
+void DataOutputQueue::failAsyncWaiters() {
+    std::vector<AsyncWaiter> failed;
+    {
+        std::unique_lock<std::mutex> lock(asyncMtx);
+        for(auto& waiter : asyncWaiters) {
+            std::unique_lock<std::mutex> groupLock(waiter.group->mtx);
+            if(waiter.group->done) continue;
+            waiter.group->done = true;
+            failed.push_back(std::move(waiter));
+        }
+        asyncWaiters.clear();
+        numAsyncWaiters = 0;
+    }
+
+    const auto error = std::make_exception_ptr(std::runtime_error(exceptionMessage.empty() ? fmt::format("Queue {} closed", name) : exceptionMessage));
+    for(auto& waiter : failed) {
+        try {
+            waiter.handler(name, nullptr, error);
+        } catch(const std::exception& ex) {
+            logger::error("Async handler of queue {} threw an exception: {}", name, ex.what());
+        }
+    }
+}
+
+int DataOutputQueue::getNotificationFd() {
+    std::unique_lock<std::mutex> lock(notifierMtx);
+    if(!notifier) {
+        notifier = std::make_unique<EventNotifier>();
+        activeNotifier = notifier.get();
+        // Messages might already be waiting
+        clearNotification();
+    }
+    return notifier->getFd();
+}
+
+void DataOutputQueue::clearNotification() {
+    auto eventNotifier = activeNotifier.load();
+    if(eventNotifier == nullptr) return;
+    eventNotifier->clear();
+    // Notifications racing with clearing are kept, as the queue is checked afterwards
+    if(!running || !withQueue([](auto& q) { return q.empty(); })) eventNotifier->notify();
+}
+
+DataOutputQueue::Stats DataOutputQueue::getStats() const {
+    Stats stats;
+    stats.numReceived = numReceived;
+    stats.bytesReceived = bytesReceived;
+    stats.queue = queue.getStats();
+    stats.queue.merge(ringQueue.getStats());
+    stats.queue.merge(latestQueue.getStats());
+    stats.queue.numDropped += numMoveDropped;
+    stats.parseTime = parseTime.getSnapshot();
+    stats.callbackTime = callbackTime.getSnapshot();
+    return stats;
+}
+
+DataOutputQueue::CallbackStats DataOutputQueue::getCallbackStats(CallbackId callbackId) {
+    std::unique_lock<std::mutex> l(callbacksMtx);
+    auto it = callbackStats.find(callbackId);
+    if(it == callbackStats.end()) return {};
+    return it->second;
+}
+
+StreamProfilingData DataOutputQueue::getProfilingData() const {
+    return profiler->getData();
+}
+
 // DATA INPUT QUEUE
+namespace {
+// Bounds how long the serializing and writing threads take to notice a conflating switch or closing
+constexpr std::chrono::milliseconds POP_TIMEOUT{100};
+}  // namespace
+
+constexpr unsigned DataInputQueue::DEFAULT_PIPELINE_DEPTH;
+
 DataInputQueue::DataInputQueue(
     const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize, bool blocking, std::size_t maxDataSize)
-    : queue(maxSize, blocking), name(streamName), maxDataSize(maxDataSize) {
+    : queue(maxSize, blocking), pipeline(DEFAULT_PIPELINE_DEPTH, true), name(streamName), maxDataSize(maxDataSize) {
+    queue.setSizeFunction([](const std::shared_ptr<RawBuffer>& msg) { return msg->data.size() + METADATA_SIZE_ESTIMATE; });
+
     // open stream with maxDataSize write size
-    XLinkStream stream(std::move(conn), name, maxDataSize + device::XLINK_MESSAGE_METADATA_MAX_SIZE);
+    startWriting(std::make_unique<XLinkStream>(std::move(conn), name, maxDataSize + device::XLINK_MESSAGE_METADATA_MAX_SIZE));
+}
 
-    writingThread = std::thread([this, stream = std::move(stream)]() mutable {
-        std::uint64_t numPacketsSent = 0;
+DataInputQueue::DataInputQueue(
+    std::unique_ptr<PacketStream> stream, const std::string& streamName, unsigned int maxSize, bool blocking, std::size_t maxDataSize)
+    : queue(maxSize, blocking), pipeline(DEFAULT_PIPELINE_DEPTH, true), name(streamName), maxDataSize(maxDataSize) {
+    if(stream == nullptr) throw std::invalid_argument("PacketStream passed is not valid (nullptr)");
+    queue.setSizeFunction([](const std::shared_ptr<RawBuffer>& msg) { return msg->data.size() + METADATA_SIZE_ESTIMATE; });
+    startWriting(std::move(stream));
+}
+
+void DataInputQueue::startWriting(std::unique_ptr<PacketStream> stream) {
+    profiler = stream->getProfiler();
+
+    // Serializes messages ahead, while previous ones are being written
+    serializingThread = std::thread([this]() {
         try {
             while(running) {
-                // get data from queue
                 std::shared_ptr<RawBuffer> data;
-                if(!queue.waitAndPop(data)) {
-                    continue;
-                }
+                if(!pop(data)) continue;
 
-                // serialize
-                auto t1Parse = std::chrono::steady_clock::now();
-                std::vector<std::vector<uint8_t>> serializedAux;
-                if(data->getType() == DatatypeEnum::MessageGroup) {
-                    auto rawMsgGrp = std::dynamic_pointer_cast<RawMessageGroup>(data);
-                    serializedAux.reserve(rawMsgGrp->group.size());
-                    unsigned int index = 0;
-                    for(auto& msg : rawMsgGrp->group) {
-                        msg.second.index = index++;
-                        serializedAux.push_back(StreamMessageParser::serializeMessage(msg.second.buffer));
-                    }
-                }
-                auto serialized = StreamMessageParser::serializeMessage(data);
-                auto t2Parse = std::chrono::steady_clock::now();
-
-                // Trace level debugging
-                if(logger::get_level() == spdlog::level::trace) {
-                    std::vector<std::uint8_t> metadata;
-                    DatatypeEnum type;
-                    data->serialize(metadata, type);
-                    logger::trace("Sending message to device ({}) - serialize time: {}, data size: {}, object type: {} object data: {}",
-                                  name,
-                                  std::chrono::duration_cast<std::chrono::microseconds>(t2Parse - t1Parse),
-                                  data->data.size(),
-                                  type,
-                                  spdlog::to_hex(metadata));
-                }
+                // Blocks while the pipeline is full, returns false once closed
+                if(!pipeline.push(serialize(std::move(data)))) break;
+            }
+        } catch(const std::exception& ex) {
+            if(running) exceptionMessage = fmt::format("Exception while serializing message. Original message '{}'", ex.what());
+        }
+
+        // Close the queue
+        close();
+    });
 
-                // Blocking
-                stream.write(serialized);
-                for(auto& msg : serializedAux) {
-                    stream.write(msg);
+    writingThread = std::thread([this, stream = std::move(stream)]() mutable {
+        std::uint64_t numPacketsSent = 0;
+        try {
+            while(running) {
+                SerializedMessage msg;
+                if(!pipeline.tryWaitAndPop(msg, POP_TIMEOUT)) continue;
+
+                // Blocking, data is written directly from the message buffer
+                const auto t1Write = std::chrono::steady_clock::now();
+                stream->write({msg.data->data, msg.metadata});
+                std::uint64_t numBytes = msg.data->data.size() + msg.metadata.size();
+                for(std::size_t i = 0; i < msg.aux.size(); i++) {
+                    stream->write({msg.aux[i]->data, msg.auxMetadata[i]});
+                    numBytes += msg.aux[i]->data.size() + msg.auxMetadata[i].size();
                 }
+                const auto t2Write = std::chrono::steady_clock::now();
+                writeTime.record(t2Write - t1Write);
 
                 // Increment num packets sent
+                if(numPacketsSent == 0) firstWriteStart = t1Write.time_since_epoch().count();
+                lastWriteEnd = t2Write.time_since_epoch().count();
                 numPacketsSent++;
+                numSent++;
+                bytesSent += numBytes;
             }
 
         } catch(const std::exception& ex) {
-            exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
+            if(running) exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
         }
 
         // Close the queue
@@ -256,6 +859,48 @@ DataInputQueue::DataInputQueue(
     });
 }
 
+bool DataInputQueue::pop(std::shared_ptr<RawBuffer>& data) {
+    // Sending and switching hold 'sendMtx', so messages are only ever in the active queue.
+    // After a switch, waiting on the previous queue ends within POP_TIMEOUT
+    return conflating ? latestQueue.tryWaitAndPop(data, POP_TIMEOUT) : queue.tryWaitAndPop(data, POP_TIMEOUT);
+}
+
+DataInputQueue::SerializedMessage DataInputQueue::serialize(std::shared_ptr<RawBuffer> data) {
+    // serialize metadata, data is written directly from the message buffer
+    auto t1Parse = std::chrono::steady_clock::now();
+    SerializedMessage msg;
+    if(data->getType() == DatatypeEnum::MessageGroup) {
+        auto rawMsgGrp = std::dynamic_pointer_cast<RawMessageGroup>(data);
+        msg.aux.reserve(rawMsgGrp->group.size());
+        msg.auxMetadata.reserve(rawMsgGrp->group.size());
+        unsigned int index = 0;
+        for(auto& grpMsg : rawMsgGrp->group) {
+            grpMsg.second.index = index++;
+            msg.aux.push_back(grpMsg.second.buffer);
+            msg.auxMetadata.push_back(StreamMessageParser::serializeMetadata(grpMsg.second.buffer));
+        }
+    }
+    msg.metadata = StreamMessageParser::serializeMetadata(data);
+    auto t2Parse = std::chrono::steady_clock::now();
+    serializeTime.record(t2Parse - t1Parse);
+
+    // Trace level debugging
+    if(logger::get_level() == spdlog::level::trace) {
+        std::vector<std::uint8_t> metadata;
+        DatatypeEnum type;
+        data->serialize(metadata, type);
+        logger::trace("Sending message to device ({}) - serialize time: {}, data size: {}, object type: {} object data: {}",
+                      name,
+                      std::chrono::duration_cast<std::chrono::microseconds>(t2Parse - t1Parse),
+                      data->data.size(),
+                      type,
+                      spdlog::to_hex(metadata));
+    }
+
+    msg.data = std::move(data);
+    return msg;
+}
+
 // This function is thread-unsafe. The idea of "isClosed" is ephemerial and
 // since there is no mutex lock, its state is outdated and invalid even before
 // the logical NOT in this function. This calculated boolean then continues to degrade
@@ -270,8 +915,11 @@ void DataInputQueue::close() {
 
     // Destroy queue
     queue.destruct();
+    latestQueue.destruct();
+    pipeline.destruct();
 
-    // Then join thread
+    // Then join threads
+    if((serializingThread.get_id() != std::this_thread::get_id()) && serializingThread.joinable()) serializingThread.join();
     if((writingThread.get_id() != std::this_thread::get_id()) && writingThread.joinable()) writingThread.join();
 
     // Log
@@ -282,7 +930,8 @@ DataInputQueue::~DataInputQueue() {
     // Close the queue
     close();
 
-    // Then join thread
+    // Then join threads
+    if(serializingThread.joinable()) serializingThread.join();
     if(writingThread.joinable()) writingThread.join();
 }
 
@@ -306,6 +955,90 @@ unsigned int DataInputQueue::getMaxSize() const {
     return queue.getMaxSize();
 }
 
+void DataInputQueue::setMaxBytes(std::size_t maxBytes) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    queue.setMaxBytes(maxBytes);
+}
+
+std::size_t DataInputQueue::getMaxBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getMaxBytes();
+}
+
+void DataInputQueue::setMemoryBudget(std::shared_ptr<MemoryBudget> budget) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    queue.setMemoryBudget(std::move(budget));
+}
+
+std::shared_ptr<MemoryBudget> DataInputQueue::getMemoryBudget() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getMemoryBudget();
+}
+
+std::size_t DataInputQueue::getQueuedBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getBytes();
+}
+
+void DataInputQueue::setConflating(bool conflating) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    std::unique_lock<std::timed_mutex> lock(sendMtx);
+    if(this->conflating.exchange(conflating) == conflating) return;
+
+    // Move over messages waiting to be sent, keeping their order
+    std::shared_ptr<RawBuffer> msg;
+    if(conflating) {
+        queue.consumeAll([this](std::shared_ptr<RawBuffer>& msg) { latestQueue.push(msg); });
+    } else if(latestQueue.tryPop(msg)) {
+        queue.push(msg);
+    }
+}
+
+bool DataInputQueue::getConflating() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return conflating;
+}
+
+std::uint64_t DataInputQueue::getNumOverwritten() const {
+    return latestQueue.getNumOverwritten();
+}
+
+DataInputQueue::Stats DataInputQueue::getStats() const {
+    Stats stats;
+    stats.numSent = numSent;
+    stats.bytesSent = bytesSent;
+    stats.queue = queue.getStats();
+    stats.queue.merge(latestQueue.getStats());
+    stats.serializeTime = serializeTime.getSnapshot();
+    stats.writeTime = writeTime.getSnapshot();
+
+    // Measured over the time between first and latest write
+    const std::chrono::nanoseconds sending(lastWriteEnd - firstWriteStart);
+    if(stats.numSent > 0 && sending.count() > 0) {
+        const auto seconds = std::chrono::duration<double>(sending).count();
+        stats.messagesPerSecond = static_cast<double>(stats.numSent) / seconds;
+        stats.megabytesPerSecond = static_cast<double>(stats.bytesSent) / 1e6 / seconds;
+    }
+    if(stats.writeTime.total.count() > 0) {
+        stats.writeMegabytesPerSecond = static_cast<double>(stats.bytesSent) / 1e6 / std::chrono::duration<double>(stats.writeTime.total).count();
+    }
+    return stats;
+}
+
+StreamProfilingData DataInputQueue::getProfilingData() const {
+    return profiler->getData();
+}
+
+void DataInputQueue::setPipelineDepth(unsigned depth) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    pipeline.setMaxSize(std::max(depth, 1u));
+}
+
+unsigned DataInputQueue::getPipelineDepth() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return pipeline.getMaxSize();
+}
+
 // BUGBUG https://github.com/luxonis/depthai-core/issues/762
 void DataInputQueue::setMaxDataSize(std::size_t maxSize) {
     maxDataSize = maxSize;
@@ -328,16 +1061,21 @@ void DataInputQueue::send(const std::shared_ptr<RawBuffer>& rawMsg) {
         throw std::runtime_error(fmt::format("Trying to send larger ({}B) message than XLinkIn maxDataSize ({}B)", rawMsg->data.size(), maxDataSize.load()));
     }
 
-    if(!queue.push(rawMsg)) {
+    std::unique_lock<std::timed_mutex> lock(sendMtx);
+    if(!(conflating ? latestQueue.push(rawMsg) : queue.push(rawMsg))) {
         throw std::runtime_error("Underlying queue destructed");
     }
 }
 void DataInputQueue::send(const std::shared_ptr<ADatatype>& msg) {
     if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    msg->decodeMetadata();
+    msg->copyAdoptedData();
     send(msg->serialize());
 }
 
 void DataInputQueue::send(const ADatatype& msg) {
+    msg.decodeMetadata();
+    msg.copyAdoptedData();
     send(msg.serialize());
 }
 
@@ -350,15 +1088,27 @@ bool DataInputQueue::send(const std::shared_ptr<RawBuffer>& rawMsg, std::chrono:
         throw std::runtime_error(fmt::format("Trying to send larger ({}B) message than XLinkIn maxDataSize ({}B)", rawMsg->data.size(), maxDataSize.load()));
     }
 
-    return queue.tryWaitAndPush(rawMsg, timeout);
+    // Time waiting for another send counts towards the timeout
+    const auto t1 = std::chrono::steady_clock::now();
+    std::unique_lock<std::timed_mutex> lock(sendMtx, std::defer_lock);
+    if(!lock.try_lock()) {
+        const auto maxTimeout = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::time_point::max() - t1) / 2;
+        if(!lock.try_lock_until(t1 + std::min(timeout, maxTimeout))) return false;
+    }
+    if(conflating) return latestQueue.push(rawMsg);
+    return queue.tryWaitAndPush(rawMsg, timeout - std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t1));
 }
 
 bool DataInputQueue::send(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout) {
     if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    msg->decodeMetadata();
+    msg->copyAdoptedData();
     return send(msg->serialize(), timeout);
 }
 
 bool DataInputQueue::send(const ADatatype& msg, std::chrono::milliseconds timeout) {
+    msg.decodeMetadata();
+    msg.copyAdoptedData();
     return send(msg.serialize(), timeout);
 }
 
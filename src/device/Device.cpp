@@ -72,6 +72,7 @@ void Device::closeImpl() {
     }
     // Clear map
     callbackIdMap.clear();
+    queueEvents.clear();
 
     // Close the device before clearing the queues
     DeviceBase::closeImpl();
@@ -108,6 +109,45 @@ std::shared_ptr<DataOutputQueue> Device::getOutputQueue(const std::string& name,
     return outputQueueMap.at(name);
 }
 
+void Device::setCallbackExecutor(CallbackExecutor::Config config) {
+    if(config.mode == CallbackExecutor::Mode::POOL && config.pool == nullptr) {
+        if(callbackPool == nullptr) callbackPool = std::make_shared<ThreadPool>();
+        config.pool = callbackPool;
+    }
+    callbackExecutorConfig = config;
+    for(auto& kv : outputQueueMap) {
+        kv.second->setCallbackExecutor(config);
+    }
+}
+
+void Device::setOutputStreamReactor(std::shared_ptr<StreamReactor> reactor) {
+    outputStreamReactor = std::move(reactor);
+}
+
+std::shared_ptr<StreamReactor> Device::getOutputStreamReactor() const {
+    return outputStreamReactor;
+}
+
+void Device::setQueueMemoryLimit(std::size_t maxBytes) {
+    queueMemoryBudget->setMaxBytes(maxBytes);
+    // Queues only account their messages in the budget while it's limited
+    const auto budget = maxBytes != 0 ? queueMemoryBudget : nullptr;
+    for(auto& kv : inputQueueMap) {
+        if(!kv.second->isClosed()) kv.second->setMemoryBudget(budget);
+    }
+    for(auto& kv : outputQueueMap) {
+        if(!kv.second->isClosed()) kv.second->setMemoryBudget(budget);
+    }
+}
+
+std::size_t Device::getQueueMemoryLimit() const {
+    return queueMemoryBudget->getMaxBytes();
+}
+
+std::size_t Device::getQueueMemoryUsage() const {
+    return queueMemoryBudget->getUsedBytes();
+}
+
 std::vector<std::string> Device::getOutputQueueNames() const {
     std::vector<std::string> names;
     names.reserve(outputQueueMap.size());
@@ -163,62 +203,16 @@ std::vector<std::string> Device::getInputQueueNames() const {
 
 std::vector<std::string> Device::getQueueEvents(const std::vector<std::string>& queueNames, std::size_t maxNumEvents, std::chrono::microseconds timeout) {
     // First check if specified queues names are actually opened
-    auto availableQueueNames = getOutputQueueNames();
+    std::vector<QueueEventDispatcher::QueueId> ids;
+    ids.reserve(queueNames.size());
     for(const auto& outputQueue : queueNames) {
-        bool found = false;
-        for(const auto& availableQueueName : availableQueueNames) {
-            if(outputQueue == availableQueueName) {
-                found = true;
-                break;
-            }
-        }
-        if(!found) throw std::runtime_error(fmt::format("Queue with name '{}' doesn't exist", outputQueue));
+        QueueEventDispatcher::QueueId id = 0;
+        if(!queueEvents.findQueue(outputQueue, id)) throw std::runtime_error(fmt::format("Queue with name '{}' doesn't exist", outputQueue));
+        ids.push_back(id);
     }
 
     // Blocking part
-    // lock eventMtx
-    std::unique_lock<std::mutex> lock(eventMtx);
-
-    // Create temporary string which predicate will fill when it finds the event
-    std::vector<std::string> eventsFromQueue;
-    // wait until predicate
-    auto predicate = [this, &queueNames, &eventsFromQueue, &maxNumEvents]() {
-        for(auto it = eventQueue.begin(); it != eventQueue.end();) {
-            bool wasRemoved = false;
-            for(const auto& name : queueNames) {
-                if(name == *it) {
-                    // found one of the events we have specified to wait for
-                    eventsFromQueue.push_back(name);
-                    // remove element from queue
-                    it = eventQueue.erase(it);
-                    wasRemoved = true;
-                    // return and acknowledge the wait prematurelly, if reached maxnumevents
-                    if(eventsFromQueue.size() >= maxNumEvents) {
-                        return true;
-                    }
-                    // breaks as other queue names won't be same as this one
-                    break;
-                }
-            }
-            // If element wasn't removed, move iterator forward, else it was already moved by erase call
-            if(!wasRemoved) ++it;
-        }
-        // After search, if no events were found, return false
-        if(eventsFromQueue.empty()) return false;
-        // Otherwise acknowledge the wait and exit
-        return true;
-    };
-
-    if(timeout < std::chrono::microseconds(0)) {
-        // if timeout < 0, infinite wait time (no timeout)
-        eventCv.wait(lock, predicate);
-    } else {
-        // otherwise respect timeout
-        eventCv.wait_for(lock, timeout, predicate);
-    }
-
-    // eventFromQueue should now contain the event name
-    return eventsFromQueue;
+    return queueEvents.wait(ids, maxNumEvents, timeout);
 }
 
 std::vector<std::string> Device::getQueueEvents(const std::initializer_list<std::string>& queueNames,
@@ -267,8 +261,10 @@ bool Device::startPipelineImpl(const Pipeline& pipeline) {
         auto streamName = xlinkIn->getStreamName();
         if(inputQueueMap.count(streamName) != 0) throw std::invalid_argument(fmt::format("Streams have duplicate name '{}'", streamName));
         // set max data size, for more verbosity
-        inputQueueMap[std::move(streamName)] = std::make_shared<DataInputQueue>(connection, xlinkIn->getStreamName(), 16, true, xlinkIn->getMaxDataSize());
+        inputQueueMap[streamName] = std::make_shared<DataInputQueue>(connection, xlinkIn->getStreamName(), 16, true, xlinkIn->getMaxDataSize());
+        if(queueMemoryBudget->getMaxBytes() != 0) inputQueueMap[streamName]->setMemoryBudget(queueMemoryBudget);
     }
+    const auto& reactor = outputStreamReactor;
     for(const auto& kv : pipeline.getNodeMap()) {
         const auto& node = kv.second;
         const auto& xlinkOut = std::dynamic_pointer_cast<const node::XLinkOut>(node);
@@ -279,28 +275,20 @@ bool Device::startPipelineImpl(const Pipeline& pipeline) {
         // Create DataOutputQueue's
         auto streamName = xlinkOut->getStreamName();
         if(outputQueueMap.count(streamName) != 0) throw std::invalid_argument(fmt::format("Streams have duplicate name '{}'", streamName));
-        outputQueueMap[streamName] = std::make_shared<DataOutputQueue>(connection, streamName);
-
-        // Add callback for events
-        callbackIdMap[std::move(streamName)] =
-            outputQueueMap[xlinkOut->getStreamName()]->addCallback([this](std::string queueName, std::shared_ptr<ADatatype>) {
-                {
-                    // Lock first
-                    std::unique_lock<std::mutex> lock(eventMtx);
-
-                    // Check if size is equal or greater than EVENT_QUEUE_MAXIMUM_SIZE
-                    if(eventQueue.size() >= EVENT_QUEUE_MAXIMUM_SIZE) {
-                        auto numToRemove = eventQueue.size() - EVENT_QUEUE_MAXIMUM_SIZE + 1;
-                        eventQueue.erase(eventQueue.begin(), eventQueue.begin() + numToRemove);
-                    }
-
-                    // Add to the end of event queue
-                    eventQueue.push_back(std::move(queueName));
-                }
-
-                // notify the rest
-                eventCv.notify_all();
-            });
+        if(reactor) {
+            outputQueueMap[streamName] = std::make_shared<DataOutputQueue>(connection, streamName, reactor);
+        } else {
+            outputQueueMap[streamName] = std::make_shared<DataOutputQueue>(connection, streamName);
+        }
+        if(queueMemoryBudget->getMaxBytes() != 0) outputQueueMap[streamName]->setMemoryBudget(queueMemoryBudget);
+        if(callbackExecutorConfig.mode != CallbackExecutor::Mode::INLINE) {
+            outputQueueMap[streamName]->setCallbackExecutor(callbackExecutorConfig);
+        }
+
+        // Add callback for events, called on the reading thread regardless of the callback executor
+        const auto eventQueueId = queueEvents.addQueue(streamName);
+        callbackIdMap[std::move(streamName)] = outputQueueMap[xlinkOut->getStreamName()]->addInternalCallback(
+            [this, eventQueueId](std::string, std::shared_ptr<ADatatype>) { queueEvents.push(eventQueueId); });
     }
     return DeviceBase::startPipelineImpl(pipeline);
 }
@@ -1,6 +1,7 @@
 #include "depthai/device/DeviceBase.hpp"
 
 // std
+#include <algorithm>
 #include <iostream>
 
 // shared
@@ -20,6 +21,7 @@
 #include "depthai/device/EepromError.hpp"
 #include "depthai/pipeline/node/XLinkIn.hpp"
 #include "depthai/pipeline/node/XLinkOut.hpp"
+#include "depthai/xlink/DeviceRegistry.hpp"
 #include "pipeline/Pipeline.hpp"
 #include "utility/EepromDataParser.hpp"
 #include "utility/Environment.hpp"
@@ -144,40 +146,33 @@ std::tuple<bool, DeviceInfo> DeviceBase::getAnyAvailableDevice(std::chrono::mill
     constexpr auto POOL_SLEEP_TIME = milliseconds(100);
 
     // First looks for UNBOOTED, then BOOTLOADER, for 'timeout' time
-    auto searchStartTime = steady_clock::now();
     bool found = false;
     DeviceInfo deviceInfo;
     std::unordered_map<std::string, DeviceInfo> invalidDevices;
-    do {
-        auto devices = XLinkConnection::getAllConnectedDevices(X_LINK_ANY_STATE, false);
+    const auto select = [&invalidDevices](const std::vector<DeviceInfo>& devices, DeviceInfo& selected) {
         for(auto searchState : {X_LINK_UNBOOTED, X_LINK_BOOTLOADER, X_LINK_FLASH_BOOTED}) {
             for(const auto& device : devices) {
-                if(device.state == searchState) {
-                    if(device.status == X_LINK_SUCCESS) {
-                        found = true;
-                        deviceInfo = device;
-                        break;
-                    } else {
-                        found = false;
-                        invalidDevices[device.name] = device;
-                    }
+                if(device.state != searchState) continue;
+                if(device.status == X_LINK_SUCCESS) {
+                    selected = device;
+                    return true;
                 }
+                invalidDevices[device.name] = device;
             }
-            if(found) break;
         }
+        return false;
+    };
+
+    // Wait on the registry, which wakes up as soon as a scan finds a device, calling the callback periodically
+    auto registry = DeviceRegistry::getInstance();
+    auto searchStartTime = steady_clock::now();
+    do {
+        auto remaining = timeout - duration_cast<milliseconds>(steady_clock::now() - searchStartTime);
+        std::tie(found, deviceInfo) = registry->waitForDevice(select, std::max(milliseconds(0), std::min(remaining, POOL_SLEEP_TIME)));
         if(found) break;
 
         // Call the callback
         if(cb) cb();
-
-        // If 'timeout' < 'POOL_SLEEP_TIME', use 'timeout' as sleep time and then break
-        if(timeout < POOL_SLEEP_TIME) {
-            // sleep for 'timeout'
-            std::this_thread::sleep_for(timeout);
-            break;
-        } else {
-            std::this_thread::sleep_for(POOL_SLEEP_TIME);  // default pool rate
-        }
     } while(steady_clock::now() - searchStartTime < timeout);
 
     // Check if its an invalid device
@@ -645,9 +640,12 @@ DeviceBase::~DeviceBase() {
 
 void DeviceBase::tryStartPipeline(const Pipeline& pipeline) {
     try {
+        const auto tPipeline = std::chrono::steady_clock::now();
         if(!startPipeline(pipeline)) {
             throw std::runtime_error("Couldn't start the pipeline");
         }
+        startupTiming.pipeline = std::chrono::steady_clock::now() - tPipeline;
+        startupTiming.total += startupTiming.pipeline;
     } catch(const std::exception&) {
         // close device (cleanup)
         close();
@@ -678,6 +676,8 @@ void DeviceBase::init(Config config, UsbSpeed maxUsbSpeed, const dai::Path& path
 }
 
 void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<const Pipeline&> pipeline) {
+    const auto tStartup = std::chrono::steady_clock::now();
+
     // Initalize depthai library if not already
     if(!dumpOnly) initialize();
 
@@ -702,6 +702,7 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
 
     // If deviceInfo isn't fully specified (eg ANY_STATE, etc...), try finding it first
     if(deviceInfo.state == X_LINK_ANY_STATE || deviceInfo.protocol == X_LINK_ANY_PROTOCOL) {
+        const auto tSearch = std::chrono::steady_clock::now();
         deviceDesc_t foundDesc;
         auto ret = XLinkFindFirstSuitableDevice(deviceInfo.getXLinkDeviceDesc(), &foundDesc);
         if(ret == X_LINK_SUCCESS) {
@@ -711,6 +712,7 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
             deviceInfo.state = X_LINK_ANY_STATE;
             pimpl->logger.debug("Searched, but no actual device found by given DeviceInfo");
         }
+        startupTiming.search = std::chrono::steady_clock::now() - tSearch;
     }
 
     if(pipeline) {
@@ -772,7 +774,9 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
         nlohmann::json jBoardConfig = config.board;
         pimpl->logger.debug("Device - BoardConfig: {} \nlibnop:{}", jBoardConfig.dump(), spdlog::to_hex(utility::serialize(config.board)));
     }
+    const auto tFirmware = std::chrono::steady_clock::now();
     std::vector<std::uint8_t> fwWithConfig = Resources::getInstance().getDeviceFirmware(config, pathToMvcmd);
+    startupTiming.firmware = std::chrono::steady_clock::now() - tFirmware;
 
     // Init device (if bootloader, handle correctly - issue USB boot command)
     if(deviceInfo.state == X_LINK_UNBOOTED) {
@@ -780,6 +784,7 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
         connection = std::make_shared<XLinkConnection>(deviceInfo, fwWithConfig);
     } else if(deviceInfo.state == X_LINK_BOOTLOADER || deviceInfo.state == X_LINK_FLASH_BOOTED) {
         // Scope so DeviceBootloader is disconnected
+        const auto tBootloader = std::chrono::steady_clock::now();
         {
             DeviceBootloader bl(deviceInfo);
             auto version = bl.getVersion();
@@ -807,6 +812,7 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
                 deviceInfo.state = X_LINK_UNBOOTED;
             }
         }
+        startupTiming.boot = std::chrono::steady_clock::now() - tBootloader;
 
         // Boot and connect with XLinkConnection constructor
         connection = std::make_shared<XLinkConnection>(deviceInfo, fwWithConfig, expectedBootState);
@@ -819,6 +825,9 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
     }
 
     deviceInfo.state = expectedBootState;
+    startupTiming.boot += connection->getBootTime();
+    startupTiming.connect = connection->getConnectTime();
+    const auto tSetup = std::chrono::steady_clock::now();
 
     // prepare rpc for both attached and host controlled mode
     pimpl->rpcStream = std::make_shared<XLinkStream>(connection, device::XLINK_CHANNEL_MAIN_RPC, device::XLINK_USB_BUFFER_MAX_SIZE);
@@ -1037,6 +1046,15 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
             throw;
         }
     }
+
+    const auto tStartupEnd = std::chrono::steady_clock::now();
+    startupTiming.setup = tStartupEnd - tSetup;
+    startupTiming.total = tStartupEnd - tStartup;
+    pimpl->logger.debug("Startup took {}ms (firmware: {}ms, boot: {}ms, connect: {}ms)",
+                        std::chrono::duration_cast<std::chrono::milliseconds>(startupTiming.total).count(),
+                        std::chrono::duration_cast<std::chrono::milliseconds>(startupTiming.firmware).count(),
+                        std::chrono::duration_cast<std::chrono::milliseconds>(startupTiming.boot).count(),
+                        std::chrono::duration_cast<std::chrono::milliseconds>(startupTiming.connect).count());
 }
 
 std::string DeviceBase::getMxId() {
@@ -1227,6 +1245,10 @@ DeviceInfo DeviceBase::getDeviceInfo() const {
     return deviceInfo;
 }
 
+DeviceBase::StartupTiming DeviceBase::getStartupTiming() const {
+    return startupTiming;
+}
+
 std::string DeviceBase::getProductName() {
     EepromData eepromFactory = readFactoryCalibrationOrDefault().getEepromData();
     EepromData eeprom = readCalibrationOrDefault().getEepromData();
@@ -1521,8 +1543,12 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
     // Serialize the pipeline
     PipelineSchema schema;
     Assets assets;
-    std::vector<std::uint8_t> assetStorage;
+    // Asset storage references asset data (eg. mapped blobs), instead of copying it
+    AssetStorage assetStorage;
     pipeline.serialize(schema, assets, assetStorage);
+    if(assetStorage.getDeduplicatedSize() > 0) {
+        pimpl->logger.debug("Asset storage: {}B, {}B of identical assets not sent", assetStorage.size(), assetStorage.getDeduplicatedSize());
+    }
 
     // if debug or lower
     if(getLogOutputLevel() <= LogLevel::DEBUG) {
@@ -1546,7 +1572,7 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
             int64_t offset = 0;
             do {
                 int64_t toTransfer = std::min(static_cast<int64_t>(device::XLINK_USB_BUFFER_MAX_SIZE), static_cast<int64_t>(assetStorage.size() - offset));
-                stream.write(&assetStorage[offset], toTransfer);
+                stream.write(assetStorage.getSegments(static_cast<std::size_t>(offset), static_cast<std::size_t>(toTransfer)));
                 offset += toTransfer;
             } while(offset < static_cast<int64_t>(assetStorage.size()));
         });
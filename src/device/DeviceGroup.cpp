@@ -0,0 +1,120 @@
+#include "depthai/device/DeviceGroup.hpp"
+
+// std
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// project
+#include "utility/Resources.hpp"
+
+// libraries
+#include "spdlog/fmt/fmt.h"
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+namespace {
+
+// Closing waits for the device to reset, so devices are closed concurrently as well
+void closeConcurrently(const std::vector<std::shared_ptr<Device>>& devices) {
+    std::vector<std::thread> threads;
+    for(const auto& device : devices) {
+        if(device == nullptr) continue;
+        threads.emplace_back([device]() { device->close(); });
+    }
+    for(auto& thread : threads) thread.join();
+}
+
+}  // namespace
+
+DeviceGroup::DeviceGroup(const std::vector<DeviceInfo>& devices, Device::Config config) {
+    open(devices, config, {});
+}
+
+DeviceGroup::DeviceGroup(const std::vector<DeviceInfo>& devices, const Pipeline& pipeline) {
+    open(devices, pipeline.getDeviceConfig(), pipeline);
+}
+
+DeviceGroup::~DeviceGroup() {
+    close();
+}
+
+void DeviceGroup::open(const std::vector<DeviceInfo>& devicesToOpen, const Device::Config& config, tl::optional<const Pipeline&> pipeline) {
+    using namespace std::chrono;
+    const auto tStart = steady_clock::now();
+
+    // Prepare firmware once, so concurrently opened devices don't each wait for and patch it
+    Resources::getInstance().getDeviceFirmware(config);
+    firmwarePreparationTime = steady_clock::now() - tStart;
+
+    std::vector<std::shared_ptr<Device>> opened(devicesToOpen.size());
+    std::vector<std::string> errors(devicesToOpen.size());
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < devicesToOpen.size(); i++) {
+        threads.emplace_back([&, i]() {
+            try {
+                if(pipeline) {
+                    opened[i] = std::make_shared<Device>(*pipeline, devicesToOpen[i]);
+                } else {
+                    opened[i] = std::make_shared<Device>(config, devicesToOpen[i]);
+                }
+            } catch(const std::exception& ex) {
+                errors[i] = ex.what();
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+
+    std::string failures;
+    std::size_t numFailures = 0;
+    for(std::size_t i = 0; i < devicesToOpen.size(); i++) {
+        if(opened[i] != nullptr) continue;
+        failures += fmt::format("\n{} [{}]: {}", devicesToOpen[i].mxid, devicesToOpen[i].name, errors[i]);
+        numFailures++;
+    }
+    if(numFailures > 0) {
+        closeConcurrently(opened);
+        throw std::runtime_error(fmt::format("Failed to open {} of {} devices:{}", numFailures, devicesToOpen.size(), failures));
+    }
+
+    devices = std::move(opened);
+    startupTime = steady_clock::now() - tStart;
+    logger::debug("DeviceGroup - opened {} devices in {}ms, firmware prepared in {}ms",
+                  devices.size(),
+                  duration_cast<milliseconds>(startupTime).count(),
+                  duration_cast<milliseconds>(firmwarePreparationTime).count());
+}
+
+std::size_t DeviceGroup::size() const {
+    return devices.size();
+}
+
+std::shared_ptr<Device> DeviceGroup::getDevice(std::size_t index) const {
+    return devices.at(index);
+}
+
+const std::vector<std::shared_ptr<Device>>& DeviceGroup::getDevices() const {
+    return devices;
+}
+
+std::vector<DeviceBase::StartupTiming> DeviceGroup::getStartupTimings() const {
+    std::vector<DeviceBase::StartupTiming> timings;
+    timings.reserve(devices.size());
+    for(const auto& device : devices) timings.push_back(device->getStartupTiming());
+    return timings;
+}
+
+std::chrono::nanoseconds DeviceGroup::getFirmwarePreparationTime() const {
+    return firmwarePreparationTime;
+}
+
+std::chrono::nanoseconds DeviceGroup::getStartupTime() const {
+    return startupTime;
+}
+
+void DeviceGroup::close() {
+    closeConcurrently(devices);
+}
+
+}  // namespace dai
@@ -0,0 +1,323 @@
+#include "depthai/device/MessageJoiner.hpp"
+
+// std
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+// project
+#include "depthai/utility/LockingQueue.hpp"
+
+// libraries
+#include "spdlog/fmt/fmt.h"
+
+namespace dai {
+
+struct MessageJoiner::State {
+    struct Pending {
+        std::shared_ptr<Buffer> msg;
+        std::chrono::nanoseconds ts;
+        std::chrono::steady_clock::time_point pushed;
+    };
+    struct Stream {
+        std::string name;
+        // Ordered by timestamp
+        std::deque<Pending> buffer;
+        // Timestamp of the latest grouped message
+        std::chrono::nanoseconds lastGrouped = std::chrono::nanoseconds::min();
+    };
+
+    const Config config;
+    std::mutex mtx;
+    std::vector<Stream> streams;
+    std::unordered_map<std::string, std::size_t> indices;
+    std::function<void(std::shared_ptr<MessageGroup>)> callback;
+    LockingQueue<std::shared_ptr<MessageGroup>> groups;
+    // Completed groups not yet handed out, in sequence order
+    std::deque<std::shared_ptr<MessageGroup>> ready;
+    // Whether a thread is handing groups out
+    bool emitting = false;
+    std::int64_t sequenceNum = 0;
+    Stats stats;
+    Histogram interval;
+
+    State(std::vector<std::string> names, Config cfg) : config(cfg), groups(cfg.maxGroups, false) {
+        if(names.empty()) throw std::invalid_argument("MessageJoiner requires at least one stream");
+        for(auto& name : names) {
+            if(!indices.emplace(name, streams.size()).second) throw std::invalid_argument(fmt::format("Stream '{}' is joined more than once", name));
+            streams.push_back({std::move(name), {}});
+        }
+    }
+
+    std::size_t index(const std::string& name) const {
+        auto it = indices.find(name);
+        if(it == indices.end()) throw std::invalid_argument(fmt::format("Stream '{}' isn't joined", name));
+        return it->second;
+    }
+
+    std::chrono::nanoseconds timestamp(const Buffer& msg) const {
+        const auto ts = config.timestampSource == TimestampSource::DEVICE ? msg.getTimestampDevice() : msg.getTimestamp();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(ts.time_since_epoch());
+    }
+
+    // Drops messages of a stream up to (excluding) given position
+    void dropUntil(Stream& stream, std::deque<Pending>::iterator it) {
+        stats.numDropped += static_cast<std::uint64_t>(std::distance(stream.buffer.begin(), it));
+        stream.buffer.erase(stream.buffer.begin(), it);
+    }
+
+    // Latest message of a stream not newer than 'ts', or end if there is none
+    static std::deque<Pending>::iterator latestUntil(Stream& stream, std::chrono::nanoseconds ts) {
+        auto it = std::upper_bound(stream.buffer.begin(), stream.buffer.end(), ts, [](std::chrono::nanoseconds t, const Pending& p) { return t < p.ts; });
+        return it == stream.buffer.begin() ? stream.buffer.end() : std::prev(it);
+    }
+
+    // Message of a stream nearest to 'ts', or end if the stream has none
+    static std::deque<Pending>::iterator nearest(Stream& stream, std::chrono::nanoseconds ts) {
+        auto it = std::lower_bound(stream.buffer.begin(), stream.buffer.end(), ts, [](const Pending& p, std::chrono::nanoseconds t) { return p.ts < t; });
+        if(it == stream.buffer.begin()) return it;
+        if(it == stream.buffer.end() || ts - std::prev(it)->ts <= it->ts - ts) return std::prev(it);
+        return it;
+    }
+
+    // Takes given messages (one per stream, end if none) out of buffers into a group, dropping older messages
+    std::shared_ptr<MessageGroup> take(std::vector<std::deque<Pending>::iterator>& picks) {
+        auto group = std::make_shared<MessageGroup>();
+        auto tsMin = std::chrono::nanoseconds::max();
+        auto tsMax = std::chrono::nanoseconds::min();
+        auto latestHost = std::chrono::steady_clock::time_point::min();
+        auto latestDevice = std::chrono::steady_clock::time_point::min();
+        bool partial = false;
+        for(std::size_t i = 0; i < streams.size(); i++) {
+            auto& stream = streams[i];
+            if(picks[i] == stream.buffer.end()) {
+                partial = true;
+                continue;
+            }
+            const auto& pick = *picks[i];
+            group->add(stream.name, std::static_pointer_cast<ADatatype>(pick.msg));
+            tsMin = std::min(tsMin, pick.ts);
+            tsMax = std::max(tsMax, pick.ts);
+            latestHost = std::max(latestHost, pick.msg->getTimestamp());
+            latestDevice = std::max(latestDevice, pick.msg->getTimestampDevice());
+            stream.lastGrouped = pick.ts;
+            dropUntil(stream, picks[i]);
+            stream.buffer.pop_front();
+        }
+        group->setTimestamp(latestHost);
+        group->setTimestampDevice(latestDevice);
+        group->setSequenceNum(sequenceNum++);
+
+        stats.numGroups++;
+        if(partial) stats.numPartialGroups++;
+        interval.record(tsMax - tsMin);
+        return group;
+    }
+
+    // Forms groups out of buffered messages
+    void join() {
+        std::vector<std::deque<Pending>::iterator> picks(streams.size());
+        while(std::all_of(streams.begin(), streams.end(), [](const Stream& s) { return !s.buffer.empty(); })) {
+            // Reference is the latest of the oldest messages, every stream has a message not newer than it
+            auto reference = std::chrono::nanoseconds::min();
+            for(const auto& stream : streams) reference = std::max(reference, stream.buffer.front().ts);
+
+            bool stale = false;
+            for(std::size_t i = 0; i < streams.size(); i++) {
+                picks[i] = latestUntil(streams[i], reference);
+                if(reference - picks[i]->ts > config.threshold) {
+                    // Following messages of the reference stream are newer, so these can't be matched anymore
+                    dropUntil(streams[i], std::next(picks[i]));
+                    stale = true;
+                }
+            }
+            if(stale) continue;
+
+            // Prefer a newer message where it is nearer to the reference, as long as the group stays within threshold
+            auto tsMax = reference;
+            for(std::size_t i = 0; i < streams.size(); i++) {
+                auto next = std::next(picks[i]);
+                if(next == streams[i].buffer.end() || next->ts - reference >= reference - picks[i]->ts) continue;
+                auto newMin = reference;
+                for(std::size_t j = 0; j < streams.size(); j++) {
+                    if(j != i) newMin = std::min(newMin, picks[j]->ts);
+                }
+                if(std::max(tsMax, next->ts) - newMin <= config.threshold) {
+                    picks[i] = next;
+                    tsMax = std::max(tsMax, next->ts);
+                }
+            }
+            ready.push_back(take(picks));
+        }
+    }
+
+    // Handles messages which waited longer than the timeout
+    void expire(std::chrono::steady_clock::time_point now) {
+        if(config.timeout <= std::chrono::milliseconds(0)) return;
+        std::vector<std::deque<Pending>::iterator> picks(streams.size());
+        while(true) {
+            // Oldest waiting message
+            Stream* expired = nullptr;
+            for(auto& stream : streams) {
+                if(!stream.buffer.empty() && (expired == nullptr || stream.buffer.front().pushed < expired->buffer.front().pushed)) expired = &stream;
+            }
+            if(expired == nullptr || now - expired->buffer.front().pushed < config.timeout) return;
+
+            switch(config.timeoutPolicy) {
+                case TimeoutPolicy::DROP:
+                    stats.numDropped++;
+                    expired->buffer.pop_front();
+                    break;
+                case TimeoutPolicy::EMIT_PARTIAL: {
+                    // Add nearest messages of other streams, closest first, while the group stays within threshold
+                    const auto ts = expired->buffer.front().ts;
+                    auto tsMin = ts, tsMax = ts;
+                    std::vector<std::pair<std::chrono::nanoseconds, std::size_t>> candidates;
+                    for(std::size_t i = 0; i < streams.size(); i++) {
+                        picks[i] = &streams[i] == expired ? streams[i].buffer.begin() : nearest(streams[i], ts);
+                        if(&streams[i] != expired && picks[i] != streams[i].buffer.end()) {
+                            candidates.emplace_back(picks[i]->ts > ts ? picks[i]->ts - ts : ts - picks[i]->ts, i);
+                        }
+                    }
+                    std::sort(candidates.begin(), candidates.end());
+                    for(const auto& candidate : candidates) {
+                        const auto candidateTs = picks[candidate.second]->ts;
+                        if(std::max(tsMax, candidateTs) - std::min(tsMin, candidateTs) <= config.threshold) {
+                            tsMin = std::min(tsMin, candidateTs);
+                            tsMax = std::max(tsMax, candidateTs);
+                        } else {
+                            picks[candidate.second] = streams[candidate.second].buffer.end();
+                        }
+                    }
+                    ready.push_back(take(picks));
+                    break;
+                }
+            }
+        }
+    }
+
+    void push(std::size_t i, std::shared_ptr<Buffer> msg) {
+        auto& stream = streams[i];
+        const auto ts = timestamp(*msg);
+        const auto now = std::chrono::steady_clock::now();
+        if(ts <= stream.lastGrouped) {
+            // Arrived too late, a newer message of this stream was already grouped
+            stats.numDropped++;
+        } else {
+            auto it = std::upper_bound(stream.buffer.begin(), stream.buffer.end(), ts, [](std::chrono::nanoseconds t, const Pending& p) { return t < p.ts; });
+            stream.buffer.insert(it, {std::move(msg), ts, now});
+            while(stream.buffer.size() > std::max<std::size_t>(config.maxBufferSize, 1)) {
+                stats.numDropped++;
+                stream.buffer.pop_front();
+            }
+            join();
+        }
+        expire(now);
+    }
+
+    // Hands ready groups out, outside of the lock. Only one thread does so at a time, so groups are delivered in
+    // sequence order, other threads leave theirs to it instead of waiting
+    void emit() {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(emitting) return;
+        emitting = true;
+        while(!ready.empty()) {
+            auto group = std::move(ready.front());
+            ready.pop_front();
+            auto cb = callback;
+            lock.unlock();
+            groups.push(group);
+            try {
+                if(cb) cb(group);
+            } catch(...) {
+                lock.lock();
+                emitting = false;
+                throw;
+            }
+            lock.lock();
+        }
+        emitting = false;
+    }
+};
+
+MessageJoiner::MessageJoiner(std::vector<std::string> streams) : MessageJoiner(std::move(streams), Config()) {}
+
+MessageJoiner::MessageJoiner(std::vector<std::string> streams, Config config) : state(std::make_shared<State>(std::move(streams), config)) {}
+
+MessageJoiner::~MessageJoiner() {
+    for(const auto& kv : queueCallbacks) {
+        if(auto queue = kv.first.lock()) queue->removeCallback(kv.second);
+    }
+    state->groups.destruct();
+}
+
+void MessageJoiner::addQueue(const std::shared_ptr<DataOutputQueue>& queue, const std::string& stream) {
+    if(queue == nullptr) throw std::invalid_argument("DataOutputQueue passed is not valid (nullptr)");
+    const auto i = state->index(stream.empty() ? queue->getName() : stream);
+
+    std::weak_ptr<State> weakState = state;
+    auto id = queue->addCallback([weakState, i](std::shared_ptr<ADatatype> msg) {
+        auto s = weakState.lock();
+        if(!s) return;
+        auto buffer = std::dynamic_pointer_cast<Buffer>(std::move(msg));
+        if(buffer == nullptr) return;
+        {
+            std::unique_lock<std::mutex> lock(s->mtx);
+            s->push(i, std::move(buffer));
+        }
+        s->emit();
+    });
+    queueCallbacks.emplace_back(queue, id);
+}
+
+void MessageJoiner::push(const std::string& stream, std::shared_ptr<ADatatype> msg) {
+    const auto i = state->index(stream);
+    auto buffer = std::dynamic_pointer_cast<Buffer>(std::move(msg));
+    if(buffer == nullptr) throw std::invalid_argument(fmt::format("Message of stream '{}' isn't a Buffer", stream));
+
+    {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        state->push(i, std::move(buffer));
+    }
+    state->emit();
+}
+
+void MessageJoiner::setCallback(std::function<void(std::shared_ptr<MessageGroup>)> callback) {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->callback = std::move(callback);
+}
+
+std::shared_ptr<MessageGroup> MessageJoiner::tryGet() {
+    std::shared_ptr<MessageGroup> group;
+    state->groups.tryPop(group);
+    return group;
+}
+
+std::shared_ptr<MessageGroup> MessageJoiner::get() {
+    std::shared_ptr<MessageGroup> group;
+    state->groups.waitAndPop(group);
+    return group;
+}
+
+std::shared_ptr<MessageGroup> MessageJoiner::get(std::chrono::milliseconds timeout, bool& hasTimedout) {
+    std::shared_ptr<MessageGroup> group;
+    hasTimedout = !state->groups.tryWaitAndPop(group, timeout);
+    return group;
+}
+
+MessageJoiner::Stats MessageJoiner::getStats() const {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    Stats stats = state->stats;
+    stats.interval = state->interval.getSnapshot();
+    return stats;
+}
+
+std::vector<std::string> MessageJoiner::getStreams() const {
+    std::vector<std::string> names;
+    for(const auto& stream : state->streams) names.push_back(stream.name);
+    return names;
+}
+
+}  // namespace dai
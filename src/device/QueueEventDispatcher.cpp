@@ -0,0 +1,137 @@
+#include "depthai/device/QueueEventDispatcher.hpp"
+
+// std
+#include <algorithm>
+#include <limits>
+
+namespace dai {
+
+QueueEventDispatcher::QueueEventDispatcher(std::size_t maxEvents) : maxEvents(maxEvents) {}
+
+QueueEventDispatcher::QueueId QueueEventDispatcher::addQueue(const std::string& name) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = ids.find(name);
+    if(it != ids.end()) return it->second;
+
+    const QueueId id = names.size();
+    ids.emplace(name, id);
+    names.push_back(name);
+    pending.emplace_back();
+    return id;
+}
+
+void QueueEventDispatcher::clear() {
+    std::unique_lock<std::mutex> lock(mtx);
+    ids.clear();
+    names.clear();
+    pending.clear();
+    numPending = 0;
+}
+
+bool QueueEventDispatcher::findQueue(const std::string& name, QueueId& id) const {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = ids.find(name);
+    if(it == ids.end()) return false;
+    id = it->second;
+    return true;
+}
+
+void QueueEventDispatcher::push(QueueId id) {
+    std::unique_lock<std::mutex> lock(mtx);
+    // Queues could have been cleared in the meantime
+    if(id >= pending.size()) return;
+
+    while(numPending > 0 && numPending >= maxEvents) discardOldest();
+    pending[id].push_back(sequence++);
+    numPending++;
+
+    // Notified under the lock, as waiters live on the stack of waiting threads
+    notifyOne(id);
+}
+
+std::vector<std::string> QueueEventDispatcher::wait(const std::vector<QueueId>& ids, std::size_t maxNumEvents, std::chrono::microseconds timeout) {
+    // Always return at least one event, as when a limit of 1 is given
+    maxNumEvents = std::max<std::size_t>(maxNumEvents, 1);
+
+    std::vector<std::string> events;
+    std::unique_lock<std::mutex> lock(mtx);
+    collect(ids, maxNumEvents, events);
+
+    if(events.empty() && timeout != std::chrono::microseconds(0)) {
+        Waiter waiter;
+        waiter.interest.resize(pending.size(), false);
+        for(auto id : ids) {
+            if(id < waiter.interest.size()) waiter.interest[id] = true;
+        }
+        waiters.push_back(&waiter);
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(events.empty()) {
+            if(timeout < std::chrono::microseconds(0)) {
+                waiter.cv.wait(lock, [&waiter]() { return waiter.signaled; });
+            } else if(!waiter.cv.wait_until(lock, deadline, [&waiter]() { return waiter.signaled; })) {
+                break;
+            }
+            waiter.signaled = false;
+            // Events could have been taken by another thread in the meantime, in which case keep waiting
+            collect(ids, maxNumEvents, events);
+        }
+
+        waiters.erase(std::find(waiters.begin(), waiters.end(), &waiter));
+    }
+
+    // Hand over events left due to the limit to other waiters, as only this thread was woken for them
+    if(events.size() >= maxNumEvents) {
+        for(auto id : ids) {
+            if(id < pending.size() && !pending[id].empty()) notifyOne(id);
+        }
+    }
+    return events;
+}
+
+std::size_t QueueEventDispatcher::getNumPending() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return numPending;
+}
+
+void QueueEventDispatcher::discardOldest() {
+    // Only happens once events aren't being consumed, so scanning front of each queue is fine
+    QueueId oldest = pending.size();
+    for(QueueId id = 0; id < pending.size(); id++) {
+        if(!pending[id].empty() && (oldest == pending.size() || pending[id].front() < pending[oldest].front())) oldest = id;
+    }
+    if(oldest == pending.size()) return;
+    pending[oldest].pop_front();
+    numPending--;
+}
+
+void QueueEventDispatcher::notifyOne(QueueId id) {
+    for(auto* waiter : waiters) {
+        if(!waiter->signaled && id < waiter->interest.size() && waiter->interest[id]) {
+            waiter->signaled = true;
+            waiter->cv.notify_one();
+            return;
+        }
+    }
+}
+
+void QueueEventDispatcher::collect(const std::vector<QueueId>& ids, std::size_t maxNumEvents, std::vector<std::string>& events) {
+    // Merge pending events of given queues by sequence number
+    while(events.size() < maxNumEvents) {
+        QueueId next = 0;
+        auto nextSequence = std::numeric_limits<std::uint64_t>::max();
+        for(auto id : ids) {
+            if(id < pending.size() && !pending[id].empty() && pending[id].front() < nextSequence) {
+                next = id;
+                nextSequence = pending[id].front();
+            }
+        }
+        if(nextSequence == std::numeric_limits<std::uint64_t>::max()) return;
+
+        pending[next].pop_front();
+        numPending--;
+        events.push_back(names[next]);
+    }
+}
+
+}  // namespace dai
@@ -7,6 +7,7 @@
 namespace dai {
 
 ImgFrame& ImgFrame::setFrame(cv::Mat frame) {
+    discardAdoptedData();
     img.data.clear();
     img.data.insert(img.data.begin(), frame.datastart, frame.dataend);
     return *this;
@@ -17,6 +18,8 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
     cv::Mat mat;
     cv::Size size = {0, 0};
     int type = 0;
+    // Mutable view (the frame may be modified through the returned Mat), so that data received without copying isn't copied here either
+    const auto data = getRawDataView();
 
     switch(getType()) {
         case Type::RGB888i:
@@ -63,14 +66,14 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
 
         case dai::RawImgFrame::Type::BITSTREAM:
         default:
-            size = cv::Size(static_cast<int>(getData().size()), 1);
+            size = cv::Size(static_cast<int>(data.size()), 1);
             type = CV_8UC1;
             break;
     }
 
     // Check if enough data
     long requiredSize = CV_ELEM_SIZE(type) * size.area();
-    long actualSize = static_cast<long>(img.data.size());
+    long actualSize = static_cast<long>(data.size());
     if(actualSize < requiredSize) {
         throw std::runtime_error("ImgFrame doesn't have enough data to encode specified frame, required " + std::to_string(requiredSize) + ", actual "
                                  + std::to_string(actualSize) + ". Maybe metadataOnly transfer was made?");
@@ -87,9 +90,9 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
         // Create new image data
         mat.create(size, type);
         // Copy number of bytes that are available by Mat space or by img data size
-        std::memcpy(mat.data, img.data.data(), std::min((long)(img.data.size()), (long)(mat.dataend - mat.datastart)));
+        std::memcpy(mat.data, data.data(), std::min((long)(data.size()), (long)(mat.dataend - mat.datastart)));
     } else {
-        mat = cv::Mat(size, type, img.data.data());
+        mat = cv::Mat(size, type, data.data());
     }
 
     return mat;
@@ -98,6 +101,7 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
 cv::Mat ImgFrame::getCvFrame() {
     cv::Mat frame = getFrame();
     cv::Mat output;
+    const auto data = getRawDataView();
 
     switch(getType()) {
         case Type::RGB888i:
@@ -112,9 +116,9 @@ cv::Mat ImgFrame::getCvFrame() {
             cv::Size s(getWidth(), getHeight());
             std::vector<cv::Mat> channels;
             // RGB
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 2));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 1));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 0));
+            channels.push_back(cv::Mat(s, CV_8UC1, data.data() + s.area() * 2));
+            channels.push_back(cv::Mat(s, CV_8UC1, data.data() + s.area() * 1));
+            channels.push_back(cv::Mat(s, CV_8UC1, data.data() + s.area() * 0));
             cv::merge(channels, output);
         } break;
 
@@ -122,9 +126,9 @@ cv::Mat ImgFrame::getCvFrame() {
             cv::Size s(getWidth(), getHeight());
             std::vector<cv::Mat> channels;
             // BGR
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 0));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 1));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 2));
+            channels.push_back(cv::Mat(s, CV_8UC1, data.data() + s.area() * 0));
+            channels.push_back(cv::Mat(s, CV_8UC1, data.data() + s.area() * 1));
+            channels.push_back(cv::Mat(s, CV_8UC1, data.data() + s.area() * 2));
             cv::merge(channels, output);
         } break;
 
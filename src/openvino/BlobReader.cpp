@@ -25,7 +25,7 @@ namespace dai {
 namespace {
 
 template <typename T>
-T readFromBlob(const std::vector<std::uint8_t>& blob, uint32_t& offset) {
+T readFromBlob(span<const std::uint8_t> blob, uint32_t& offset) {
     if(offset + sizeof(T) > blob.size()) {
         throw std::length_error("BlobReader error: Filesize is less than blob specifies. Likely corrupted");
     }
@@ -42,7 +42,7 @@ bool isIOShapeName(std::string name) {
 
 }  // namespace
 
-void BlobReader::parse(const std::vector<std::uint8_t>& blob) {
+void BlobReader::parse(span<const std::uint8_t> blob) {
     if(blob.empty() || blob.size() < sizeof(ElfN_Ehdr) + sizeof(mv_blob_header)) {
         throw std::logic_error("BlobReader error: Blob is empty");
     }
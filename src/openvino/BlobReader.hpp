@@ -12,6 +12,7 @@
 
 #include "BlobFormat.hpp"
 #include "depthai-shared/common/TensorInfo.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
@@ -19,7 +20,7 @@ class BlobReader {
 public:
     BlobReader() = default;
 
-    void parse(const std::vector<std::uint8_t>& blob);
+    void parse(span<const std::uint8_t> blob);
 
     const std::unordered_map<std::string, TensorInfo>& getNetworkInputs() const { return networkInputs; }
     const std::unordered_map<std::string, TensorInfo>& getNetworkOutputs() const { return networkOutputs; }
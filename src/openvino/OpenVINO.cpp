@@ -156,10 +156,9 @@ bool OpenVINO::areVersionsBlobCompatible(OpenVINO::Version v1, OpenVINO::Version
     return false;
 }
 
-static void blobInit(OpenVINO::Blob& blob, std::vector<uint8_t> data) {
-    blob.data = std::move(data);
+static void blobInit(OpenVINO::Blob& blob) {
     BlobReader reader;
-    reader.parse(blob.data);
+    reader.parse(blob.getData());
     blob.networkInputs = reader.getNetworkInputs();
     blob.networkOutputs = reader.getNetworkOutputs();
     blob.stageCount = reader.getStageCount();
@@ -168,19 +167,37 @@ static void blobInit(OpenVINO::Blob& blob, std::vector<uint8_t> data) {
     blob.version = OpenVINO::getBlobVersion(reader.getVersionMajor(), reader.getVersionMinor());
 }
 
-OpenVINO::Blob::Blob(std::vector<uint8_t> data) {
-    blobInit(*this, std::move(data));
+OpenVINO::Blob::Blob(std::vector<uint8_t> blobData) : data(std::move(blobData)) {
+    blobInit(*this);
+}
+
+OpenVINO::Blob::Blob(std::shared_ptr<Memory> blobMemory) : memory(std::move(blobMemory)) {
+    blobInit(*this);
 }
 
 OpenVINO::Blob::Blob(const dai::Path& path) {
-    // Load binary file at path
-    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    // Load binary file at path, in one read
+    std::ifstream stream(path, std::ios::in | std::ios::binary | std::ios::ate);
     if(!stream.is_open()) {
         // Throw an error
         // TODO(themarpe) - Unify exceptions into meaningful groups
         throw std::runtime_error(fmt::format("Cannot load blob, file at path {} doesn't exist.", path));
     }
-    blobInit(*this, std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {}));
+    // Directories open as well, but report a bogus size and fail on reading
+    const auto size = stream.tellg();
+    if(size < 0 || !stream.seekg(0) || (size > 0 && stream.peek() == std::ifstream::traits_type::eof())) {
+        throw std::runtime_error(fmt::format("Cannot load blob, file at path {} couldn't be read.", path));
+    }
+    data.resize(static_cast<std::size_t>(size));
+    if(!stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        throw std::runtime_error(fmt::format("Cannot load blob, file at path {} couldn't be read.", path));
+    }
+    blobInit(*this);
+}
+
+span<const uint8_t> OpenVINO::Blob::getData() const {
+    if(memory != nullptr) return memory->getData();
+    return {data.data(), data.size()};
 }
 
 }  // namespace dai
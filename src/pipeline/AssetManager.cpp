@@ -4,7 +4,12 @@
 #include "utility/spdlog-fmt.hpp"
 
 // std
+#include <algorithm>
 #include <fstream>
+#include <cstring>
+
+// shared
+#include "depthai-shared/utility/Checksum.hpp"
 
 namespace dai {
 
@@ -12,6 +17,99 @@ std::string Asset::getRelativeUri() {
     return fmt::format("{}:{}", "asset", key);
 }
 
+span<const std::uint8_t> Asset::getData() const {
+    if(memory != nullptr) return memory->getData();
+    return {data.data(), data.size()};
+}
+
+std::size_t Asset::getSize() const {
+    return getData().size();
+}
+
+std::size_t AssetStorage::append(std::shared_ptr<const Asset> asset) {
+    const auto data = asset->getData();
+
+    // Reuse an identical asset if already stored at a suitable alignment
+    std::uint32_t hash = 0;
+    bool hashed = false;
+    const auto sameSize = entriesBySize.equal_range(data.size());
+    for(auto it = sameSize.first; it != sameSize.second && !data.empty(); ++it) {
+        auto& entry = entries[it->second];
+        if(asset->alignment > 1 && entry.offset % asset->alignment != 0) continue;
+        const auto other = entry.asset->getData();
+        if(other.data() != data.data()) {
+            // Compare contents by hash first, and only then byte by byte
+            if(!hashed) {
+                hash = utility::checksum(data.data(), data.size());
+                hashed = true;
+            }
+            if(!entry.hashed) {
+                entry.hash = utility::checksum(other.data(), other.size());
+                entry.hashed = true;
+            }
+            if(entry.hash != hash || std::memcmp(other.data(), data.data(), data.size()) != 0) continue;
+        }
+        deduplicatedSize += data.size();
+        return entry.offset;
+    }
+
+    // calculate additional bytes needed to offset to alignment
+    std::size_t toAdd = 0;
+    if(asset->alignment > 1 && storageSize % asset->alignment != 0) {
+        toAdd = asset->alignment - (storageSize % asset->alignment);
+    }
+    if(padding.size() < toAdd) padding.resize(toAdd, 0);
+
+    std::size_t offset = storageSize + toAdd;
+    storageSize = offset + data.size();
+    entriesBySize.emplace(data.size(), entries.size());
+    entries.push_back({std::move(asset), offset, hash, hashed});
+    return offset;
+}
+
+std::size_t AssetStorage::getDeduplicatedSize() const {
+    return deduplicatedSize;
+}
+
+std::size_t AssetStorage::size() const {
+    return storageSize;
+}
+
+bool AssetStorage::empty() const {
+    return storageSize == 0;
+}
+
+std::vector<span<const std::uint8_t>> AssetStorage::getSegments(std::size_t offset, std::size_t size) const {
+    std::vector<span<const std::uint8_t>> segments;
+    const std::size_t end = std::min(offset + size, storageSize);
+    std::size_t position = offset;
+    for(std::size_t i = 0; i < entries.size() && position < end; i++) {
+        const auto& entry = entries[i];
+        const auto data = entry.asset->getData();
+        // padding in front of the asset
+        if(position < entry.offset) {
+            const std::size_t toAdd = std::min(entry.offset, end) - position;
+            segments.emplace_back(padding.data(), toAdd);
+            position += toAdd;
+        }
+        // asset data
+        const std::size_t assetEnd = entry.offset + data.size();
+        if(position < end && position < assetEnd) {
+            const std::size_t toAdd = std::min(assetEnd, end) - position;
+            segments.push_back(data.subspan(position - entry.offset, toAdd));
+            position += toAdd;
+        }
+    }
+    return segments;
+}
+
+std::vector<std::uint8_t> AssetStorage::toVector() const {
+    std::vector<std::uint8_t> storage;
+    storage.reserve(storageSize);
+    for(const auto& segment : getSegments(0, storageSize)) storage.insert(storage.end(), segment.begin(), segment.end());
+    return storage;
+}
+
 std::shared_ptr<dai::Asset> AssetManager::set(Asset asset) {
     std::string key = asset.key;
     assetMap[key] = std::make_shared<Asset>(std::move(asset));
@@ -22,23 +120,35 @@ std::shared_ptr<dai::Asset> AssetManager::set(const std::string& key, Asset asse
     // Rename the asset with supplied key and store
     Asset a(key);
     a.data = std::move(asset.data);
+    a.memory = std::move(asset.memory);
     a.alignment = asset.alignment;
     return set(std::move(a));
 }
 
 std::shared_ptr<dai::Asset> AssetManager::set(const std::string& key, const dai::Path& path, int alignment) {
-    // Load binary file at path
-    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    // Load binary file at path, in one read
+    std::ifstream stream(path, std::ios::in | std::ios::binary | std::ios::ate);
     if(!stream.is_open()) {
         // Throw an error
         // TODO(themarpe) - Unify exceptions into meaningful groups
         throw std::runtime_error(fmt::format("Cannot load asset, file at path {} doesn't exist.", path));
     }
+    const auto size = stream.tellg();
+    if(size < 0 || !stream.seekg(0) || (size > 0 && stream.peek() == std::ifstream::traits_type::eof())) {
+        throw std::runtime_error(fmt::format("Cannot load asset, file at path {} couldn't be read.", path));
+    }
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(size));
+    if(!stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        throw std::runtime_error(fmt::format("Cannot load asset, file at path {} couldn't be read.", path));
+    }
+    return set(key, std::move(data), alignment);
+}
 
+std::shared_ptr<dai::Asset> AssetManager::set(const std::string& key, std::shared_ptr<Memory> memory, int alignment) {
     // Create an asset
     Asset binaryAsset(key);
     binaryAsset.alignment = alignment;
-    binaryAsset.data = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {});
+    binaryAsset.memory = std::move(memory);
     // Store asset
     return set(std::move(binaryAsset));
 }
@@ -127,10 +237,19 @@ void AssetManager::serialize(AssetsMutable& mutableAssets, std::vector<std::uint
         storage.resize(storage.size() + toAdd);
 
         // copy data
-        storage.insert(storage.end(), a.data.begin(), a.data.end());
+        const auto data = a.getData();
+        storage.insert(storage.end(), data.begin(), data.end());
 
         // Add to map the currently added asset
-        mutableAssets.set(prefix + a.key, offset, static_cast<uint32_t>(a.data.size()), a.alignment);
+        mutableAssets.set(prefix + a.key, offset, static_cast<uint32_t>(data.size()), a.alignment);
+    }
+}
+
+void AssetManager::serialize(AssetsMutable& mutableAssets, AssetStorage& storage, std::string prefix) const {
+    for(auto& kv : assetMap) {
+        const auto& a = *kv.second;
+        auto offset = storage.append(kv.second);
+        mutableAssets.set(prefix + a.key, static_cast<uint32_t>(offset), static_cast<uint32_t>(a.getSize()), a.alignment);
     }
 }
 
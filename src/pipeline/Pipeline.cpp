@@ -84,11 +84,18 @@ std::vector<std::shared_ptr<Node>> PipelineImpl::getAllNodes() {
 }
 
 void PipelineImpl::serialize(PipelineSchema& schema, Assets& assets, std::vector<std::uint8_t>& assetStorage, SerializationType type) const {
+    // Serialize all asset managers into (deduplicated) asset storage and copy it
+    AssetStorage storage;
+    serialize(schema, assets, storage, type);
+    assetStorage = storage.toVector();
+}
+
+void PipelineImpl::serialize(PipelineSchema& schema, Assets& assets, AssetStorage& assetStorage, SerializationType type) const {
     // Set schema
     schema = getPipelineSchema(type);
 
-    // Serialize all asset managers into asset storage
-    assetStorage.clear();
+    // Reference assets of all asset managers in asset storage
+    assetStorage = {};
     AssetsMutable mutableAssets;
     // Pipeline assets
     assetManager.serialize(mutableAssets, assetStorage, "/pipeline/");
@@ -297,7 +304,7 @@ void PipelineImpl::setCameraTuningBlobPath(const dai::Path& path) {
     auto asset = assetManager.set(assetKey, path);
 
     globalProperties.cameraTuningBlobUri = asset->getRelativeUri();
-    globalProperties.cameraTuningBlobSize = static_cast<uint32_t>(asset->data.size());
+    globalProperties.cameraTuningBlobSize = static_cast<uint32_t>(asset->getSize());
 }
 
 void PipelineImpl::setXLinkChunkSize(int sizeBytes) {
@@ -11,14 +11,21 @@ Buffer::Buffer(std::shared_ptr<dai::RawBuffer> ptr) : ADatatype(std::move(ptr))
 
 // helpers
 std::vector<std::uint8_t>& Buffer::getData() const {
+    copyAdoptedData();
     return raw->data;
 }
 
+span<const std::uint8_t> Buffer::getDataView() const {
+    return getRawDataView();
+}
+
 void Buffer::setData(const std::vector<std::uint8_t>& data) {
+    discardAdoptedData();
     raw->data = data;
 }
 
 void Buffer::setData(std::vector<std::uint8_t>&& data) {
+    discardAdoptedData();
     raw->data = std::move(data);
 }
 
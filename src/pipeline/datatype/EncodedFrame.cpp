@@ -50,10 +50,10 @@ EncodedFrame::FrameType EncodedFrame::getFrameType() const {
                 frameType = utility::SliceType::I;
                 break;
             case RawEncodedFrame::Profile::AVC:
-                frameType = utility::getTypesH264(frame.data, true)[0];
+                frameType = utility::getTypesH264(getDataView(), true)[0];
                 break;
             case RawEncodedFrame::Profile::HEVC:
-                frameType = utility::getTypesH265(frame.data, true)[0];
+                frameType = utility::getTypesH265(getDataView(), true)[0];
                 break;
         }
         switch(frameType) {
@@ -9,6 +9,10 @@
 namespace dai {
 
 std::shared_ptr<RawBuffer> MessageGroup::serialize() const {
+    // Members share their raw buffers with the group, fill in data they still only view in place
+    for(const auto& entry : group) {
+        entry.second->copyAdoptedData();
+    }
     return raw;
 }
 
@@ -20,7 +24,9 @@ std::shared_ptr<ADatatype> MessageGroup::operator[](const std::string& name) {
 }
 void MessageGroup::add(const std::string& name, const std::shared_ptr<ADatatype>& value) {
     group[name] = value;
-    rawGrp.group[name] = {value->getRaw(), 0};
+    // Adopted data isn't copied until the group is serialized
+    value->decodeMetadata();
+    rawGrp.group[name] = {value->raw, 0};
 }
 
 std::unordered_map<std::string, std::shared_ptr<ADatatype>>::iterator MessageGroup::begin() {
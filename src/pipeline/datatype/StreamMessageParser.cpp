@@ -36,6 +36,8 @@
 #include "depthai/pipeline/datatype/ToFConfig.hpp"
 #include "depthai/pipeline/datatype/TrackedFeatures.hpp"
 #include "depthai/pipeline/datatype/Tracklets.hpp"
+#include "depthai/utility/MessagePool.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
 
 // shared
 #include "depthai-shared/datatype/DatatypeEnum.hpp"
@@ -77,13 +79,24 @@ inline int readIntLE(uint8_t* data) {
 }
 
 template <class T>
-inline std::shared_ptr<T> parseDatatype(std::uint8_t* metadata, size_t size, std::vector<uint8_t>& data) {
-    auto tmp = std::make_shared<T>();
-
-    // deserialize
-    utility::deserialize(metadata, size, *tmp);
-    // Move data
-    tmp->data = std::move(data);
+inline std::shared_ptr<T> parseDatatype(std::uint8_t* metadata,
+                                        size_t size,
+                                        const std::uint8_t* data,
+                                        size_t dataSize,
+                                        MessagePool* pool,
+                                        std::shared_ptr<DeferredMetadata>* deferred) {
+    auto tmp = pool ? pool->acquire<T>() : std::make_shared<T>();
+
+    if(deferred) {
+        // keep serialized metadata, deserialize on first access
+        *deferred = std::make_shared<DeferredMetadata>(
+            metadata, size, [](std::uint8_t* m, std::size_t s, RawBuffer& raw) { utility::deserialize(m, s, static_cast<T&>(raw)); });
+    } else {
+        // deserialize
+        utility::deserialize(metadata, size, *tmp);
+    }
+    // Copy data (reuses capacity of pooled objects)
+    tmp->data.assign(data, data + dataSize);
 
     return tmp;
 }
@@ -135,101 +148,98 @@ std::shared_ptr<RawBuffer> StreamMessageParser::parseMessage(streamPacketDesc_t*
     std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
     auto* const metadataStart = packet->data + bufferLength;
 
-    // copy data part
-    std::vector<uint8_t> data(packet->data, packet->data + bufferLength);
-
     // Create corresponding object
     switch(objectType) {
         case DatatypeEnum::Buffer:
-            return parseDatatype<RawBuffer>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawBuffer>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::ImgFrame:
-            return parseDatatype<RawImgFrame>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawImgFrame>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::EncodedFrame:
-            return parseDatatype<RawEncodedFrame>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawEncodedFrame>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::NNData:
-            return parseDatatype<RawNNData>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawNNData>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::ImageManipConfig:
-            return parseDatatype<RawImageManipConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawImageManipConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::CameraControl:
-            return parseDatatype<RawCameraControl>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawCameraControl>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::ImgDetections:
-            return parseDatatype<RawImgDetections>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawImgDetections>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::SpatialImgDetections:
-            return parseDatatype<RawSpatialImgDetections>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawSpatialImgDetections>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::SystemInformation:
-            return parseDatatype<RawSystemInformation>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawSystemInformation>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::SpatialLocationCalculatorData:
-            return parseDatatype<RawSpatialLocations>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawSpatialLocations>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::SpatialLocationCalculatorConfig:
-            return parseDatatype<RawSpatialLocationCalculatorConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawSpatialLocationCalculatorConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::AprilTags:
-            return parseDatatype<RawAprilTags>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawAprilTags>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::AprilTagConfig:
-            return parseDatatype<RawAprilTagConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawAprilTagConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::Tracklets:
-            return parseDatatype<RawTracklets>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawTracklets>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::IMUData:
-            return parseDatatype<RawIMUData>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawIMUData>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::StereoDepthConfig:
-            return parseDatatype<RawStereoDepthConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawStereoDepthConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::EdgeDetectorConfig:
-            return parseDatatype<RawEdgeDetectorConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawEdgeDetectorConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::TrackedFeatures:
-            return parseDatatype<RawTrackedFeatures>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawTrackedFeatures>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::FeatureTrackerConfig:
-            return parseDatatype<RawFeatureTrackerConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawFeatureTrackerConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
 
         case DatatypeEnum::ToFConfig:
-            return parseDatatype<RawToFConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawToFConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
         case DatatypeEnum::PointCloudConfig:
-            return parseDatatype<RawPointCloudConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawPointCloudConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
         case DatatypeEnum::PointCloudData:
-            return parseDatatype<RawPointCloudData>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawPointCloudData>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
         case DatatypeEnum::MessageGroup:
-            return parseDatatype<RawMessageGroup>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawMessageGroup>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
         case DatatypeEnum::ImageAlignConfig:
-            return parseDatatype<RawImageAlignConfig>(metadataStart, serializedObjectSize, data);
+            return parseDatatype<RawImageAlignConfig>(metadataStart, serializedObjectSize, packet->data, bufferLength, nullptr, nullptr);
             break;
     }
 
@@ -237,112 +247,170 @@ std::shared_ptr<RawBuffer> StreamMessageParser::parseMessage(streamPacketDesc_t*
         fmt::format("Bad packet, couldn't parse, total size {}, type {}, metadata size {}", packet->length, objectType, serializedObjectSize));
 }
 
-std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& objectType) {
-    size_t serializedObjectSize;
-    size_t bufferLength;
-    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
-    auto* const metadataStart = packet->data + bufferLength;
-
-    // copy data part
-    std::vector<uint8_t> data(packet->data, packet->data + bufferLength);
-
+static std::shared_ptr<ADatatype> parseADatatype(DatatypeEnum objectType,
+                                                 std::uint8_t* metadataStart,
+                                                 size_t serializedObjectSize,
+                                                 const std::uint8_t* data,
+                                                 size_t dataSize,
+                                                 std::uint32_t packetLength,
+                                                 MessagePool* pool,
+                                                 bool lazyMetadata) {
+    std::shared_ptr<DeferredMetadata> deferred;
+    auto* const deferredPtr = lazyMetadata ? &deferred : nullptr;
+    std::shared_ptr<ADatatype> msg;
     switch(objectType) {
         case DatatypeEnum::Buffer: {
-            return std::make_shared<Buffer>(parseDatatype<RawBuffer>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<Buffer>(parseDatatype<RawBuffer>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
         } break;
 
         case DatatypeEnum::ImgFrame:
-            return std::make_shared<ImgFrame>(parseDatatype<RawImgFrame>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<ImgFrame>(parseDatatype<RawImgFrame>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::EncodedFrame:
-            return std::make_shared<EncodedFrame>(parseDatatype<RawEncodedFrame>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<EncodedFrame>(parseDatatype<RawEncodedFrame>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::NNData:
-            return std::make_shared<NNData>(parseDatatype<RawNNData>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<NNData>(parseDatatype<RawNNData>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::ImageManipConfig:
-            return std::make_shared<ImageManipConfig>(parseDatatype<RawImageManipConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<ImageManipConfig>(parseDatatype<RawImageManipConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::CameraControl:
-            return std::make_shared<CameraControl>(parseDatatype<RawCameraControl>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<CameraControl>(parseDatatype<RawCameraControl>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::ImgDetections:
-            return std::make_shared<ImgDetections>(parseDatatype<RawImgDetections>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<ImgDetections>(parseDatatype<RawImgDetections>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::SpatialImgDetections:
-            return std::make_shared<SpatialImgDetections>(parseDatatype<RawSpatialImgDetections>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<SpatialImgDetections>(parseDatatype<RawSpatialImgDetections>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::SystemInformation:
-            return std::make_shared<SystemInformation>(parseDatatype<RawSystemInformation>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<SystemInformation>(parseDatatype<RawSystemInformation>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::SpatialLocationCalculatorData:
-            return std::make_shared<SpatialLocationCalculatorData>(parseDatatype<RawSpatialLocations>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<SpatialLocationCalculatorData>(parseDatatype<RawSpatialLocations>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::SpatialLocationCalculatorConfig:
-            return std::make_shared<SpatialLocationCalculatorConfig>(
-                parseDatatype<RawSpatialLocationCalculatorConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<SpatialLocationCalculatorConfig>(
+                parseDatatype<RawSpatialLocationCalculatorConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::AprilTags:
-            return std::make_shared<AprilTags>(parseDatatype<RawAprilTags>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<AprilTags>(parseDatatype<RawAprilTags>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::AprilTagConfig:
-            return std::make_shared<AprilTagConfig>(parseDatatype<RawAprilTagConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<AprilTagConfig>(parseDatatype<RawAprilTagConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::Tracklets:
-            return std::make_shared<Tracklets>(parseDatatype<RawTracklets>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<Tracklets>(parseDatatype<RawTracklets>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::IMUData:
-            return std::make_shared<IMUData>(parseDatatype<RawIMUData>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<IMUData>(parseDatatype<RawIMUData>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::StereoDepthConfig:
-            return std::make_shared<StereoDepthConfig>(parseDatatype<RawStereoDepthConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<StereoDepthConfig>(parseDatatype<RawStereoDepthConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::EdgeDetectorConfig:
-            return std::make_shared<EdgeDetectorConfig>(parseDatatype<RawEdgeDetectorConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<EdgeDetectorConfig>(parseDatatype<RawEdgeDetectorConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::TrackedFeatures:
-            return std::make_shared<TrackedFeatures>(parseDatatype<RawTrackedFeatures>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<TrackedFeatures>(parseDatatype<RawTrackedFeatures>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::FeatureTrackerConfig:
-            return std::make_shared<FeatureTrackerConfig>(parseDatatype<RawFeatureTrackerConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<FeatureTrackerConfig>(parseDatatype<RawFeatureTrackerConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
 
         case DatatypeEnum::ToFConfig:
-            return std::make_shared<ToFConfig>(parseDatatype<RawToFConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<ToFConfig>(parseDatatype<RawToFConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
         case DatatypeEnum::PointCloudConfig:
-            return std::make_shared<PointCloudConfig>(parseDatatype<RawPointCloudConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<PointCloudConfig>(parseDatatype<RawPointCloudConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
         case DatatypeEnum::PointCloudData:
-            return std::make_shared<PointCloudData>(parseDatatype<RawPointCloudData>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<PointCloudData>(parseDatatype<RawPointCloudData>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
         case DatatypeEnum::MessageGroup:
-            return std::make_shared<MessageGroup>(parseDatatype<RawMessageGroup>(metadataStart, serializedObjectSize, data));
+            // Never deferred, the group's layout is needed right away to read its members
+            msg = std::make_shared<MessageGroup>(parseDatatype<RawMessageGroup>(metadataStart, serializedObjectSize, data, dataSize, pool, nullptr));
             break;
         case DatatypeEnum::ImageAlignConfig:
-            return std::make_shared<ImageAlignConfig>(parseDatatype<RawImageAlignConfig>(metadataStart, serializedObjectSize, data));
+            msg = std::make_shared<ImageAlignConfig>(parseDatatype<RawImageAlignConfig>(metadataStart, serializedObjectSize, data, dataSize, pool, deferredPtr));
             break;
     }
 
+    if(msg) {
+        msg->deferred = std::move(deferred);
+        return msg;
+    }
+
     throw std::runtime_error(fmt::format(
-        "Bad packet, couldn't parse (invalid message type), total size {}, type {}, metadata size {}", packet->length, objectType, serializedObjectSize));
+        "Bad packet, couldn't parse (invalid message type), total size {}, type {}, metadata size {}", packetLength, objectType, serializedObjectSize));
+}
+
+// Types whose data is only accessed through Buffer::getData/getDataView, so it can be adopted instead of copied
+static bool canAdoptData(DatatypeEnum objectType) {
+    switch(objectType) {
+        case DatatypeEnum::Buffer:
+        case DatatypeEnum::ImgFrame:
+        case DatatypeEnum::EncodedFrame:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet,
+                                                                        DatatypeEnum& objectType,
+                                                                        const std::shared_ptr<MessagePool>& pool,
+                                                                        bool lazyMetadata) {
+    size_t serializedObjectSize;
+    size_t bufferLength;
+    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
+    auto* const metadataStart = packet->data + bufferLength;
+
+    // copy data part
+    return parseADatatype(objectType, metadataStart, serializedObjectSize, packet->data, bufferLength, packet->length, pool.get(), lazyMetadata);
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(StreamPacketDesc&& packet,
+                                                                        DatatypeEnum& objectType,
+                                                                        const std::shared_ptr<MessagePool>& pool,
+                                                                        bool lazyMetadata) {
+    size_t serializedObjectSize;
+    size_t bufferLength;
+    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(&packet);
+    auto* const metadataStart = packet.data + bufferLength;
+
+    if(!canAdoptData(objectType)) {
+        // copy data part
+        return parseADatatype(objectType, metadataStart, serializedObjectSize, packet.data, bufferLength, packet.length, pool.get(), lazyMetadata);
+    }
+
+    // Parse metadata first, then hand over the packet to the message
+    auto msg = parseADatatype(objectType, metadataStart, serializedObjectSize, nullptr, 0, packet.length, pool.get(), lazyMetadata);
+    msg->adopted = std::make_shared<AdoptedMemory>(std::make_shared<StreamPacketMemory>(std::move(packet), bufferLength));
+    return msg;
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(StreamPacketDesc&& packet) {
+    DatatypeEnum objectType;
+    return parseMessageToADatatype(std::move(packet), objectType);
 }
 
 std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet) {
@@ -350,13 +418,12 @@ std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPa
     return parseMessageToADatatype(packet, objectType);
 }
 
-std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const RawBuffer& data) {
-    // Serialization:
-    // 1. fill vector with bytes from data.data
-    // 2. serialize and append metadata
-    // 3. append datatype enum (4B LE)
-    // 4. append size (4B LE) of serialized metadata
-    // 5. append 16-byte marker/canary
+std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const RawBuffer& data) {
+    // Serialization of everything following data.data:
+    // 1. serialize metadata
+    // 2. append datatype enum (4B LE)
+    // 3. append size (4B LE) of serialized metadata
+    // 4. append 16-byte marker/canary
 
     DatatypeEnum datatype;
     std::vector<std::uint8_t> metadata;
@@ -369,13 +436,30 @@ std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const RawBuffer&
     for(int i = 0; i < 4; i++) leDatatype[i] = (static_cast<std::int32_t>(datatype) >> (i * 8)) & 0xFF;
     for(int i = 0; i < 4; i++) leMetadataSize[i] = (metadataSize >> i * 8) & 0xFF;
 
+    metadata.reserve(metadata.size() + leDatatype.size() + leMetadataSize.size() + endOfPacketMarker.size());
+    metadata.insert(metadata.end(), leDatatype.begin(), leDatatype.end());
+    metadata.insert(metadata.end(), leMetadataSize.begin(), leMetadataSize.end());
+    metadata.insert(metadata.end(), endOfPacketMarker.begin(), endOfPacketMarker.end());
+
+    return metadata;
+}
+
+std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const std::shared_ptr<const RawBuffer>& data) {
+    if(!data) return {};
+    return serializeMetadata(*data);
+}
+
+std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const RawBuffer& data) {
+    // Serialization:
+    // 1. fill vector with bytes from data.data
+    // 2. append serialized metadata, datatype, metadata size and marker (see serializeMetadata)
+
+    const auto metadata = serializeMetadata(data);
+
     std::vector<std::uint8_t> ser;
-    ser.reserve(data.data.size() + metadata.size() + leDatatype.size() + leMetadataSize.size() + endOfPacketMarker.size());
+    ser.reserve(data.data.size() + metadata.size());
     ser.insert(ser.end(), data.data.begin(), data.data.end());
     ser.insert(ser.end(), metadata.begin(), metadata.end());
-    ser.insert(ser.end(), leDatatype.begin(), leDatatype.end());
-    ser.insert(ser.end(), leMetadataSize.begin(), leMetadataSize.end());
-    ser.insert(ser.end(), endOfPacketMarker.begin(), endOfPacketMarker.end());
 
     return ser;
 }
@@ -386,6 +470,8 @@ std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const std::share
 }
 
 std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const ADatatype& data) {
+    data.decodeMetadata();
+    data.copyAdoptedData();
     return serializeMessage(data.serialize());
 }
 
@@ -3,6 +3,7 @@
 // std
 #include <cmath>
 #include <fstream>
+#include <stdexcept>
 
 // libraries
 #include "spdlog/fmt/fmt.h"
@@ -250,13 +251,24 @@ void Camera::loadMeshData(span<const std::uint8_t> data) {
 }
 
 void Camera::loadMeshFile(const dai::Path& warpMesh) {
-    std::ifstream streamMesh(warpMesh, std::ios::binary);
+    std::ifstream streamMesh(warpMesh, std::ios::binary | std::ios::ate);
     if(!streamMesh.is_open()) {
         throw std::runtime_error(fmt::format("Camera | Cannot open mesh at path: {}", warpMesh.u8string()));
     }
-    std::vector<std::uint8_t> data = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(streamMesh), {});
+    const auto size = streamMesh.tellg();
+    if(size < 0 || !streamMesh.seekg(0) || (size > 0 && streamMesh.peek() == std::ifstream::traits_type::eof())) {
+        throw std::runtime_error(fmt::format("Camera | Cannot read mesh at path: {}", warpMesh.u8string()));
+    }
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(size));
+    if(!streamMesh.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        throw std::runtime_error(fmt::format("Camera | Cannot read mesh at path: {}", warpMesh.u8string()));
+    }
+    if(data.empty()) {
+        throw std::runtime_error("Camera | mesh data must not be empty");
+    }
 
-    loadMeshData(data);
+    // Moved into the asset, instead of being copied by loadMeshData
+    properties.warpMeshUri = assetManager.set("warpMesh", std::move(data), 64)->getRelativeUri();
 }
 
 void Camera::setMeshStep(int width, int height) {
@@ -33,9 +33,10 @@ void NeuralNetwork::setBlob(const dai::Path& path) {
 
 void NeuralNetwork::setBlob(OpenVINO::Blob blob) {
     networkOpenvinoVersion = blob.version;
-    auto asset = assetManager.set("__blob", std::move(blob.data));
+    // Reference mapped blobs instead of copying them
+    auto asset = blob.memory != nullptr ? assetManager.set("__blob", std::move(blob.memory)) : assetManager.set("__blob", std::move(blob.data));
     properties.blobUri = asset->getRelativeUri();
-    properties.blobSize = static_cast<uint32_t>(asset->data.size());
+    properties.blobSize = static_cast<uint32_t>(asset->getSize());
 }
 
 void NeuralNetwork::setNumPoolFrames(int numFrames) {
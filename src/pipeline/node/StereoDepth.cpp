@@ -2,6 +2,7 @@
 
 // standard
 #include <fstream>
+#include <stdexcept>
 
 #include "spdlog/spdlog.h"
 #include "utility/Logging.hpp"
@@ -65,19 +66,31 @@ void StereoDepth::loadMeshData(const std::vector<std::uint8_t>& dataLeft, const
 }
 
 void StereoDepth::loadMeshFiles(const dai::Path& pathLeft, const dai::Path& pathRight) {
-    std::ifstream streamLeft(pathLeft, std::ios::binary);
-    if(!streamLeft.is_open()) {
-        throw std::runtime_error(fmt::format("StereoDepth | Cannot open mesh at path: {}", pathLeft));
-    }
-    std::vector<std::uint8_t> dataLeft = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(streamLeft), {});
-
-    std::ifstream streamRight(pathRight, std::ios::binary);
-    if(!streamRight.is_open()) {
-        throw std::runtime_error(fmt::format("StereoDepth | Cannot open mesh at path: {}", pathRight));
+    // Meshes are read in one go and moved into assets, instead of being copied by loadMeshData
+    const auto readMesh = [](const dai::Path& path) {
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if(!stream.is_open()) {
+            throw std::runtime_error(fmt::format("StereoDepth | Cannot open mesh at path: {}", path));
+        }
+        const auto size = stream.tellg();
+        if(size < 0 || !stream.seekg(0) || (size > 0 && stream.peek() == std::ifstream::traits_type::eof())) {
+            throw std::runtime_error(fmt::format("StereoDepth | Cannot read mesh at path: {}", path));
+        }
+        std::vector<std::uint8_t> data(static_cast<std::size_t>(size));
+        if(!stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            throw std::runtime_error(fmt::format("StereoDepth | Cannot read mesh at path: {}", path));
+        }
+        return data;
+    };
+    auto meshLeft = readMesh(pathLeft);
+    auto meshRight = readMesh(pathRight);
+    if(meshLeft.size() != meshRight.size()) {
+        throw std::runtime_error("StereoDepth | left and right mesh sizes must match");
     }
-    std::vector<std::uint8_t> dataRight = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(streamRight), {});
 
-    loadMeshData(dataLeft, dataRight);
+    properties.mesh.meshSize = static_cast<uint32_t>(meshLeft.size());
+    properties.mesh.meshLeftUri = assetManager.set("meshLeft", std::move(meshLeft), 64)->getRelativeUri();
+    properties.mesh.meshRightUri = assetManager.set("meshRight", std::move(meshRight), 64)->getRelativeUri();
 }
 
 void StereoDepth::setMeshStep(int width, int height) {
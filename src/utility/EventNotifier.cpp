@@ -0,0 +1,76 @@
+#include "depthai/utility/EventNotifier.hpp"
+
+// std
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+#elif !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// libraries
+#include "spdlog/fmt/fmt.h"
+
+namespace dai {
+
+EventNotifier::EventNotifier() {
+#if defined(__linux__)
+    readFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(readFd < 0) throw std::runtime_error(fmt::format("Couldn't create eventfd: {}", std::strerror(errno)));
+    writeFd = readFd;
+#elif !defined(_WIN32)
+    int fds[2];
+    if(pipe(fds) != 0) throw std::runtime_error(fmt::format("Couldn't create pipe: {}", std::strerror(errno)));
+    for(int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    readFd = fds[0];
+    writeFd = fds[1];
+#else
+    throw std::runtime_error("Pollable notifications aren't supported on this platform");
+#endif
+}
+
+EventNotifier::~EventNotifier() {
+#if !defined(_WIN32)
+    if(writeFd != readFd) close(writeFd);
+    close(readFd);
+#endif
+}
+
+int EventNotifier::getFd() const {
+    return readFd;
+}
+
+void EventNotifier::notify() {
+    if(signaled.exchange(true)) return;
+#if defined(__linux__)
+    const std::uint64_t value = 1;
+    (void)!write(writeFd, &value, sizeof(value));
+#elif !defined(_WIN32)
+    const char value = 1;
+    (void)!write(writeFd, &value, sizeof(value));
+#endif
+}
+
+void EventNotifier::clear() {
+    // Drain first, so a notification racing with clearing isn't lost
+#if defined(__linux__)
+    std::uint64_t value;
+    (void)!read(readFd, &value, sizeof(value));
+#elif !defined(_WIN32)
+    char buffer[64];
+    while(read(readFd, buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+    signaled = false;
+}
+
+}  // namespace dai
@@ -9,16 +9,16 @@ namespace utility {
 template <typename T>
 struct H26xParser {
    protected:
-    virtual void parseNal(const std::vector<std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out) = 0;
-    std::vector<SliceType> parseBytestream(const std::vector<std::uint8_t>& bs, bool breakOnFirst);
+    virtual void parseNal(const span<const std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out) = 0;
+    std::vector<SliceType> parseBytestream(const span<const std::uint8_t>& bs, bool breakOnFirst);
 
    public:
-    static std::vector<SliceType> getTypes(const std::vector<std::uint8_t>& bs, bool breakOnFirst);
+    static std::vector<SliceType> getTypes(const span<const std::uint8_t>& bs, bool breakOnFirst);
     virtual ~H26xParser() = default;
 };
 
 struct H264Parser : H26xParser<H264Parser> {
-    void parseNal(const std::vector<std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out);
+    void parseNal(const span<const std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out);
 };
 
 struct H265Parser : H26xParser<H265Parser> {
@@ -32,12 +32,12 @@ struct H265Parser : H26xParser<H265Parser> {
     unsigned int log2DiffMaxMinLumaCodingBlockSize = 0;  // In sequence parameter set
     unsigned int log2MinLumaCodingBlockSizeMinus3 = 0;   // In sequence parameter set
 
-    void parseNal(const std::vector<std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out);
+    void parseNal(const span<const std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out);
 };
 
 typedef unsigned int uint;
 typedef unsigned long ulong;
-typedef const std::vector<std::uint8_t> buf;
+typedef const span<const std::uint8_t> buf;
 
 SliceType getSliceType(uint num, Profile p) {
     switch(p) {
@@ -88,8 +88,8 @@ bool scodeEq(buf& bs, uint pos, buf code) {
 }
 
 uint findStart(buf& bs, uint pos) {
-    buf codeLong = {0, 0, 0, 1};
-    buf codeShort = {0, 0, 1};
+    static const std::uint8_t codeLong[] = {0, 0, 0, 1};
+    static const std::uint8_t codeShort[] = {0, 0, 1};
     uint size = bs.size();
     for(uint i = pos; i < size; ++i) {
         if(bs[i] == 0) {
@@ -104,8 +104,8 @@ uint findStart(buf& bs, uint pos) {
 }
 
 uint findEnd(buf& bs, uint pos) {
-    buf end1 = {0, 0, 0};
-    buf end2 = {0, 0, 1};
+    static const std::uint8_t end1[] = {0, 0, 0};
+    static const std::uint8_t end2[] = {0, 0, 1};
     uint size = bs.size();
     for(uint i = pos; i < size; ++i) {
         if(bs[i] == 0) {
@@ -0,0 +1,95 @@
+#include "depthai/utility/MappedFile.hpp"
+
+// std
+#include <stdexcept>
+
+// project
+#include "utility/spdlog-fmt.hpp"
+
+// Platform specific
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace dai {
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const dai::Path& path) {
+    const dai::Path::string_type nativePath = path;
+    fileHandle = CreateFileW(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = nullptr;
+        throw std::runtime_error(fmt::format("Cannot open file at path {}", path));
+    }
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error(fmt::format("Cannot get size of file at path {}", path));
+    }
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+    // Empty files can't be mapped
+    if(size == 0) return;
+
+    mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if(mappingHandle != nullptr) {
+        mapped = static_cast<std::uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+    }
+    if(mapped == nullptr) {
+        if(mappingHandle != nullptr) CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error(fmt::format("Cannot map file at path {}", path));
+    }
+}
+
+MappedFile::~MappedFile() {
+    if(mapped != nullptr) UnmapViewOfFile(mapped);
+    if(mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if(fileHandle != nullptr) CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const dai::Path& path) {
+    const dai::Path::string_type nativePath = path;
+    const int fd = ::open(nativePath.c_str(), O_RDONLY);
+    if(fd < 0) throw std::runtime_error(fmt::format("Cannot open file at path {}", path));
+    struct stat fileStat {};
+    if(::fstat(fd, &fileStat) != 0) {
+        ::close(fd);
+        throw std::runtime_error(fmt::format("Cannot get size of file at path {}", path));
+    }
+    size = static_cast<std::size_t>(fileStat.st_size);
+    // Empty files can't be mapped
+    if(size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // Mapping stays valid after closing the descriptor
+    ::close(fd);
+    if(address == MAP_FAILED) throw std::runtime_error(fmt::format("Cannot map file at path {}", path));
+    mapped = static_cast<std::uint8_t*>(address);
+}
+
+MappedFile::~MappedFile() {
+    if(mapped != nullptr) ::munmap(mapped, size);
+}
+
+#endif
+
+span<std::uint8_t> MappedFile::getData() {
+    return {mapped, size};
+}
+
+span<const std::uint8_t> MappedFile::getData() const {
+    return {mapped, size};
+}
+
+}  // namespace dai
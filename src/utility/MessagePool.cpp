@@ -0,0 +1,81 @@
+#include "depthai/utility/MessagePool.hpp"
+
+namespace dai {
+
+MessagePool::MessagePool() = default;
+MessagePool::MessagePool(Config config) : config(config) {}
+
+void MessagePool::release(std::type_index type, RawBuffer* obj) {
+    std::unique_ptr<RawBuffer> ptr(obj);
+
+    // Check limits first, reset outside of the lock
+    std::function<void(RawBuffer&)> reset;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto& pool = pools[type];
+        if(pool.idle.size() >= config.maxPooledPerType || (config.maxDataCapacity != 0 && ptr->data.capacity() > config.maxDataCapacity)) {
+            pool.stats.numDiscarded++;
+            return;
+        }
+        reset = pool.reset;
+    }
+
+    reset(*ptr);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    auto& pool = pools[type];
+    pool.stats.numReturned++;
+    pool.stats.numPooled++;
+    pool.stats.pooledDataCapacity += ptr->data.capacity();
+    pool.idle.push_back(std::move(ptr));
+}
+
+void MessagePool::setConfig(Config config) {
+    std::unique_lock<std::mutex> lock(mtx);
+    this->config = config;
+}
+
+MessagePool::Config MessagePool::getConfig() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return config;
+}
+
+MessagePool::Stats MessagePool::getStats() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    Stats total;
+    for(const auto& kv : pools) {
+        const auto& stats = kv.second.stats;
+        total.numAcquired += stats.numAcquired;
+        total.numReused += stats.numReused;
+        total.numReturned += stats.numReturned;
+        total.numDiscarded += stats.numDiscarded;
+        total.numPooled += stats.numPooled;
+        total.pooledDataCapacity += stats.pooledDataCapacity;
+    }
+    return total;
+}
+
+MessagePool::Stats MessagePool::getStats(DatatypeEnum datatype) const {
+    std::unique_lock<std::mutex> lock(mtx);
+    for(const auto& kv : pools) {
+        if(kv.second.reset && kv.second.datatype == datatype) return kv.second.stats;
+    }
+    return {};
+}
+
+void MessagePool::clear() {
+    std::vector<std::unique_ptr<RawBuffer>> toFree;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        for(auto& kv : pools) {
+            auto& pool = kv.second;
+            for(auto& obj : pool.idle) toFree.push_back(std::move(obj));
+            pool.idle.clear();
+            pool.stats.numPooled = 0;
+            pool.stats.pooledDataCapacity = 0;
+        }
+    }
+    // Objects are freed outside of the lock
+}
+
+}  // namespace dai
@@ -17,10 +17,16 @@
     #include <windows.h>
 #endif
 
-#ifndef _WIN32
+#if defined(_WIN32)
+    #include <direct.h>
+#else
     #include <unistd.h>
 #endif
 
+#include <sys/stat.h>
+
+#include <cstdlib>
+
 namespace dai {
 namespace platform {
 
@@ -75,5 +81,33 @@ std::string getTempPath() {
     return tmpPath;
 }
 
+std::string getCachePath() {
+#if defined(_WIN32) || defined(__USE_W32_SOCKETS)
+    const char* localAppData = std::getenv("LOCALAPPDATA");
+    if(localAppData != nullptr) return localAppData;
+#else
+    const char* xdgCacheHome = std::getenv("XDG_CACHE_HOME");
+    if(xdgCacheHome != nullptr && xdgCacheHome[0] != '\0') return xdgCacheHome;
+    const char* home = std::getenv("HOME");
+    if(home != nullptr && home[0] != '\0') return std::string(home) + "/.cache";
+#endif
+    return {};
+}
+
+bool createDirectories(const std::string& path) {
+    // Failures (eg. existing directories or drive letters) are ignored, only the resulting directory is checked
+    for(std::size_t i = 1; i <= path.size(); i++) {
+        if(i < path.size() && path[i] != '/' && path[i] != '\\') continue;
+        const auto parent = path.substr(0, i);
+#if defined(_WIN32)
+        _mkdir(parent.c_str());
+#else
+        mkdir(parent.c_str(), 0755);
+#endif
+    }
+    struct stat pathStat {};
+    return stat(path.c_str(), &pathStat) == 0 && (pathStat.st_mode & S_IFDIR) != 0;
+}
+
 }  // namespace platform
 }  // namespace dai
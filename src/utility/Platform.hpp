@@ -9,6 +9,10 @@ namespace platform {
 uint32_t getIPv4AddressAsBinary(std::string address);
 std::string getIPv4AddressAsString(std::uint32_t binary);
 std::string getTempPath();
+// Per-user cache directory ($XDG_CACHE_HOME, ~/.cache or %LOCALAPPDATA%), empty if not known
+std::string getCachePath();
+// Creates a directory and its missing parents, returns whether the directory exists afterwards
+bool createDirectories(const std::string& path);
 
 }  // namespace platform
 }  // namespace dai
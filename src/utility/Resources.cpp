@@ -3,6 +3,8 @@
 #include <array>
 #include <cassert>
 #include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <thread>
@@ -23,7 +25,9 @@
 #include "depthai-shared/utility/Serialization.hpp"
 
 // project
+#include "depthai/utility/MappedFile.hpp"
 #include "utility/Environment.hpp"
+#include "utility/Platform.hpp"
 #include "utility/spdlog-fmt.hpp"
 
 extern "C" {
@@ -72,7 +76,9 @@ std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, da
         cvDevice.wait(lock, [this]() { return readyDevice; });
     }
 
-    std::vector<std::uint8_t> finalFwBinary;
+    // Firmware binary, either mapped from file or pointing to resources
+    std::unique_ptr<MappedFile> fileFwBinary;
+    span<const std::uint8_t> fwBinary;
 
     // Get OpenVINO version
     auto& version = config.version;
@@ -89,17 +95,17 @@ std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, da
     }
     // Return binary from file if any of above paths are present
     if(!finalFwBinaryPath.empty()) {
-        // Load binary file at path
-        std::ifstream stream(finalFwBinaryPath, std::ios::binary);
-        if(!stream.is_open()) {
+        // Map binary file at path
+        try {
+            fileFwBinary = std::make_unique<MappedFile>(finalFwBinaryPath);
+        } catch(const std::runtime_error&) {
             // Throw an error
             // TODO(themarpe) - Unify exceptions into meaningful groups
             throw std::runtime_error(
                 fmt::format("File at path {}{} doesn't exist.", finalFwBinaryPath, !fwBinaryPath.empty() ? " pointed to by DEPTHAI_DEVICE_BINARY" : ""));
         }
         logger::warn("Overriding firmware: {}", finalFwBinaryPath);
-        // Read the file and return its contents
-        finalFwBinary = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {});
+        fwBinary = fileFwBinary->getData();
     } else {
 // Binaries are resource compiled
 #ifdef DEPTHAI_RESOURCE_COMPILED_BINARIES
@@ -112,9 +118,9 @@ std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, da
         }
 
         // Main FW
-        std::vector<std::uint8_t> depthaiBinary;
+        const std::vector<std::uint8_t>* depthaiBinary = nullptr;
         // Patch from main to specified
-        std::vector<std::uint8_t> depthaiPatch;
+        const std::vector<std::uint8_t>* depthaiPatch = nullptr;
 
         switch(version) {
             case OpenVINO::VERSION_2020_3:
@@ -122,56 +128,67 @@ std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, da
                 break;
 
             case OpenVINO::VERSION_2020_4:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2020_4_PATCH_PATH);
+                depthaiPatch = &resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2020_4_PATCH_PATH);
                 break;
 
             case OpenVINO::VERSION_2021_1:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_1_PATCH_PATH);
+                depthaiPatch = &resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_1_PATCH_PATH);
                 break;
 
             case OpenVINO::VERSION_2021_2:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_2_PATCH_PATH);
+                depthaiPatch = &resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_2_PATCH_PATH);
                 break;
 
             case OpenVINO::VERSION_2021_3:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_3_PATCH_PATH);
+                depthaiPatch = &resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_3_PATCH_PATH);
                 break;
 
             case OpenVINO::VERSION_2021_4:
             case OpenVINO::VERSION_2022_1:
             case MAIN_FW_VERSION:
-                depthaiBinary = resourceMapDevice.at(MAIN_FW_PATH);
+                depthaiBinary = &resourceMapDevice.at(MAIN_FW_PATH);
                 break;
         }
 
         // is patching required?
-        if(!depthaiPatch.empty()) {
-            logger::debug("Patching OpenVINO FW version from {} to {}", OpenVINO::getVersionName(MAIN_FW_VERSION), OpenVINO::getVersionName(version));
+        if(depthaiPatch != nullptr) {
+            // Patched binaries are kept, so devices booted with the same version don't patch again.
+            // Entries aren't modified once patched, so they can be read after unlocking
+            std::unique_lock<std::mutex> lock(mtxPatchedDevice);
+            auto& patchedBinary = patchedDeviceFirmware[version];
+            const auto patchedName = fmt::format("depthai-device-openvino-{}-patched.cmd", OpenVINO::getVersionName(version));
+            if(patchedBinary.empty() && !cacheDirDevice.empty() && loadCachedResource(cacheDirDevice + "/" + patchedName, patchedBinary)) {
+                logger::debug("Resources - OpenVINO {} FW loaded from cache", OpenVINO::getVersionName(version));
+            }
+            if(patchedBinary.empty()) {
+                logger::debug("Patching OpenVINO FW version from {} to {}", OpenVINO::getVersionName(MAIN_FW_VERSION), OpenVINO::getVersionName(version));
 
-            // Load full binary for patch
-            depthaiBinary = resourceMapDevice.at(MAIN_FW_PATH);
+                // Load full binary for patch
+                const auto& mainBinary = resourceMapDevice.at(MAIN_FW_PATH);
 
-            // Get new size
-            int64_t patchedSize = bspatch_mem_get_newsize(depthaiPatch.data(), depthaiPatch.size());
+                // Get new size
+                int64_t patchedSize = bspatch_mem_get_newsize(depthaiPatch->data(), depthaiPatch->size());
 
-            // Reserve space for patched binary
-            std::vector<std::uint8_t> tmpDepthaiBinary{};
-            tmpDepthaiBinary.resize(patchedSize);
+                // Reserve space for patched binary
+                std::vector<std::uint8_t> tmpDepthaiBinary{};
+                tmpDepthaiBinary.resize(patchedSize);
 
-            // Patch
-            int error = bspatch_mem(depthaiBinary.data(), depthaiBinary.size(), depthaiPatch.data(), depthaiPatch.size(), tmpDepthaiBinary.data());
+                // Patch
+                int error = bspatch_mem(mainBinary.data(), mainBinary.size(), depthaiPatch->data(), depthaiPatch->size(), tmpDepthaiBinary.data());
 
-            // if patch not successful
-            if(error > 0) {
-                throw std::runtime_error(fmt::format(
-                    "Error while patching OpenVINO FW version from {} to {}", OpenVINO::getVersionName(MAIN_FW_VERSION), OpenVINO::getVersionName(version)));
-            }
+                // if patch not successful
+                if(error > 0) {
+                    throw std::runtime_error(fmt::format(
+                        "Error while patching OpenVINO FW version from {} to {}", OpenVINO::getVersionName(MAIN_FW_VERSION), OpenVINO::getVersionName(version)));
+                }
 
-            // Change depthaiBinary to tmpDepthaiBinary
-            depthaiBinary = std::move(tmpDepthaiBinary);
+                patchedBinary = std::move(tmpDepthaiBinary);
+                if(!cacheDirDevice.empty()) storeCachedResource(cacheDirDevice, patchedName, patchedBinary);
+            }
+            depthaiBinary = &patchedBinary;
         }
 
-        finalFwBinary = std::move(depthaiBinary);
+        if(depthaiBinary != nullptr) fwBinary = {depthaiBinary->data(), depthaiBinary->size()};
 
 #else
         // Binaries from default path (TODO)
@@ -183,7 +200,11 @@ std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, da
     // Serialize preboot
     auto prebootPayload = utility::serialize(config.board);
     auto prebootHeader = createPrebootHeader(prebootPayload, BOARD_CONFIG_MAGIC1, BOARD_CONFIG_MAGIC2);
-    finalFwBinary.insert(finalFwBinary.begin(), prebootHeader.begin(), prebootHeader.end());
+    // Copy the binary only once, behind the header
+    std::vector<std::uint8_t> finalFwBinary;
+    finalFwBinary.reserve(prebootHeader.size() + fwBinary.size());
+    finalFwBinary.insert(finalFwBinary.end(), prebootHeader.begin(), prebootHeader.end());
+    finalFwBinary.insert(finalFwBinary.end(), fwBinary.begin(), fwBinary.end());
 
     // Return created firmware
     return finalFwBinary;
@@ -214,16 +235,19 @@ std::vector<std::uint8_t> Resources::getBootloaderFirmware(dai::bootloader::Type
     }
     dai::Path blBinaryPath = utility::getEnv(blEnvVar);
     if(!blBinaryPath.empty()) {
-        // Load binary file at path
-        std::ifstream stream(blBinaryPath, std::ios::binary);
-        if(!stream.is_open()) {
+        // Map binary file at path
+        std::unique_ptr<MappedFile> file;
+        try {
+            file = std::make_unique<MappedFile>(blBinaryPath);
+        } catch(const std::runtime_error&) {
             // Throw an error
             // TODO(themarpe) - Unify exceptions into meaningful groups
             throw std::runtime_error(fmt::format("File at path {} pointed to by {} doesn't exist.", blBinaryPath, blEnvVar));
         }
         logger::warn("Overriding bootloader {}: {}", blEnvVar, blBinaryPath);
-        // Read the file and return its content
-        return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {});
+        // Return a copy of its content
+        const auto data = file->getData();
+        return std::vector<std::uint8_t>(data.begin(), data.end());
     }
 
     switch(type) {
@@ -250,9 +274,100 @@ Resources& Resources::getInstance() {
     return instance;
 }
 
+// Cached resource file: magic, checksum (4B) and size (8B) of the resource, followed by the resource
+constexpr static std::array<char, 4> RESOURCE_CACHE_MAGIC = {'D', 'A', 'I', 'C'};
+constexpr static std::size_t RESOURCE_CACHE_HEADER_SIZE = 16;
+
+// Directory of cached resources extracted from an archive, empty if caching isn't enabled
+static std::string getResourceCacheDirectory(const std::string& archiveName, const void* archive, std::size_t size) {
+    std::string cacheDir = utility::getEnv("DEPTHAI_FIRMWARE_CACHE_DIR");
+    if(cacheDir.empty()) {
+        if(utility::getEnv("DEPTHAI_FIRMWARE_CACHE") != "1") return {};
+        const auto cachePath = platform::getCachePath();
+        if(cachePath.empty()) return {};
+        cacheDir = cachePath + "/depthai/firmware";
+    }
+    // Archive name contains the version, its checksum distinguishes builds of the same version
+    return fmt::format("{}/{}-{:08x}", cacheDir, archiveName, utility::checksum(archive, size));
+}
+
+bool Resources::loadCachedResource(const std::string& path, std::vector<std::uint8_t>& resource) {
+    // Read directly into the resource, as resources are kept in memory anyway
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if(!stream) {
+        // Not cached yet
+        return false;
+    }
+    const auto fileSize = stream.tellg();
+    std::array<char, RESOURCE_CACHE_HEADER_SIZE> header{};
+    if(fileSize < static_cast<std::streamoff>(RESOURCE_CACHE_HEADER_SIZE) || !stream.seekg(0) || !stream.read(header.data(), header.size())
+       || std::memcmp(header.data(), RESOURCE_CACHE_MAGIC.data(), RESOURCE_CACHE_MAGIC.size()) != 0) {
+        logger::warn("Cached resource {} is corrupted, ignoring it", path);
+        return false;
+    }
+    std::uint32_t checksum = 0;
+    std::uint64_t size = 0;
+    std::memcpy(&checksum, header.data() + 4, sizeof(checksum));
+    std::memcpy(&size, header.data() + 8, sizeof(size));
+    if(size != static_cast<std::uint64_t>(fileSize) - RESOURCE_CACHE_HEADER_SIZE) {
+        logger::warn("Cached resource {} is corrupted, ignoring it", path);
+        return false;
+    }
+    resource.resize(size);
+    if(!stream.read(reinterpret_cast<char*>(resource.data()), static_cast<std::streamsize>(size)) || utility::checksum(resource.data(), resource.size()) != checksum) {
+        logger::warn("Cached resource {} is corrupted, ignoring it", path);
+        resource.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Resources::loadCachedResources(const std::string& dir,
+                                    const std::vector<std::string>& names,
+                                    std::unordered_map<std::string, std::vector<std::uint8_t>>& resources) {
+    for(const auto& name : names) {
+        if(!loadCachedResource(dir + "/" + name, resources[name])) {
+            resources.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void Resources::storeCachedResource(const std::string& dir, const std::string& name, const std::vector<std::uint8_t>& resource) {
+    if(!platform::createDirectories(dir)) {
+        logger::debug("Cannot create resource cache directory {}", dir);
+        return;
+    }
+    // Written to a temporary file first, so other processes never see a partially written resource
+    const auto path = dir + "/" + name;
+    const auto unique = static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const auto tmpPath = fmt::format("{}.{:x}.tmp", path, unique);
+    {
+        const std::uint32_t checksum = utility::checksum(resource.data(), resource.size());
+        const std::uint64_t size = resource.size();
+        std::array<char, RESOURCE_CACHE_HEADER_SIZE> header{};
+        std::memcpy(header.data(), RESOURCE_CACHE_MAGIC.data(), RESOURCE_CACHE_MAGIC.size());
+        std::memcpy(header.data() + 4, &checksum, sizeof(checksum));
+        std::memcpy(header.data() + 8, &size, sizeof(size));
+
+        std::ofstream stream(tmpPath, std::ios::binary);
+        stream.write(header.data(), header.size());
+        stream.write(reinterpret_cast<const char*>(resource.data()), static_cast<std::streamsize>(resource.size()));
+        stream.close();
+        if(!stream.good()) {
+            logger::debug("Cannot write cached resource {}", path);
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+    // Fails if another process stored it meanwhile
+    if(std::rename(tmpPath.c_str(), path.c_str()) != 0) std::remove(tmpPath.c_str());
+}
+
 template <typename CV, typename BOOL, typename MTX, typename PATH, typename LIST, typename MAP>
-std::function<void()> getLazyTarXzFunction(MTX& mtx, CV& cv, BOOL& ready, PATH cmrcPath, LIST& resourceList, MAP& resourceMap) {
-    return [&mtx, &cv, &ready, cmrcPath, &resourceList, &resourceMap] {
+std::function<void()> getLazyTarXzFunction(MTX& mtx, CV& cv, BOOL& ready, PATH cmrcPath, LIST& resourceList, MAP& resourceMap, std::string& cacheDir) {
+    return [&mtx, &cv, &ready, cmrcPath, &resourceList, &resourceMap, &cacheDir] {
         using namespace std::chrono;
 
         // Get binaries from internal sources
@@ -261,6 +376,21 @@ std::function<void()> getLazyTarXzFunction(MTX& mtx, CV& cv, BOOL& ready, PATH c
 
         auto t1 = steady_clock::now();
 
+        // Load from cache if enabled and complete, so archive doesn't have to be decompressed
+        cacheDir = getResourceCacheDirectory(cmrcPath, tarXz.begin(), tarXz.size());
+        if(!cacheDir.empty()) {
+            const std::vector<std::string> names(std::begin(resourceList), std::end(resourceList));
+            if(Resources::loadCachedResources(cacheDir, names, resourceMap)) {
+                logger::debug("Resources - Archive '{}' loaded from cache {}: {}", cmrcPath, cacheDir, duration_cast<milliseconds>(steady_clock::now() - t1));
+                {
+                    std::unique_lock<std::mutex> l(mtx);
+                    ready = true;
+                }
+                cv.notify_all();
+                return;
+            }
+        }
+
         // Load tar.xz archive from memory
         struct archive* a = archive_read_new();
         archive_read_support_filter_xz(a);
@@ -328,6 +458,11 @@ std::function<void()> getLazyTarXzFunction(MTX& mtx, CV& cv, BOOL& ready, PATH c
             assert(resourceMap.count(resPath) > 0);
         }
 
+        // Store extracted resources, for following processes
+        if(!cacheDir.empty()) {
+            for(const auto& kv : resourceMap) Resources::storeCachedResource(cacheDir, kv.first, kv.second);
+        }
+
         auto t3 = steady_clock::now();
 
         // Debug - logs loading times
@@ -353,12 +488,12 @@ Resources::Resources() {
 
     // Device resources
     // Create a thread which lazy-loads firmware resources package
-    lazyThreadDevice = std::thread(getLazyTarXzFunction(mtxDevice, cvDevice, readyDevice, CMRC_DEPTHAI_DEVICE_TAR_XZ, RESOURCE_LIST_DEVICE, resourceMapDevice));
+    lazyThreadDevice = std::thread(getLazyTarXzFunction(mtxDevice, cvDevice, readyDevice, CMRC_DEPTHAI_DEVICE_TAR_XZ, RESOURCE_LIST_DEVICE, resourceMapDevice, cacheDirDevice));
 
     // Bootloader resources
     // Create a thread which lazy-loads firmware resources package
     lazyThreadBootloader = std::thread(
-        getLazyTarXzFunction(mtxBootloader, cvBootloader, readyBootloader, CMRC_DEPTHAI_BOOTLOADER_TAR_XZ, RESOURCE_LIST_BOOTLOADER, resourceMapBootloader));
+        getLazyTarXzFunction(mtxBootloader, cvBootloader, readyBootloader, CMRC_DEPTHAI_BOOTLOADER_TAR_XZ, RESOURCE_LIST_BOOTLOADER, resourceMapBootloader, cacheDirBootloader));
 }
 
 Resources::~Resources() {
@@ -25,14 +25,30 @@ class Resources {
     std::thread lazyThreadDevice;
     bool readyDevice;
     std::unordered_map<std::string, std::vector<std::uint8_t>> resourceMapDevice;
+    // Firmware patched to an OpenVINO version
+    mutable std::mutex mtxPatchedDevice;
+    mutable std::unordered_map<OpenVINO::Version, std::vector<std::uint8_t>> patchedDeviceFirmware;
+    // Directory of cached resources, empty if caching isn't enabled. Set before 'readyDevice'
+    std::string cacheDirDevice;
 
     mutable std::mutex mtxBootloader;
     mutable std::condition_variable cvBootloader;
     std::thread lazyThreadBootloader;
     bool readyBootloader;
     std::unordered_map<std::string, std::vector<std::uint8_t>> resourceMapBootloader;
+    std::string cacheDirBootloader;
 
 public:
+    // Reads a cached resource, verifying its size and checksum. Returns false if not cached, truncated or corrupted
+    static bool loadCachedResource(const std::string& path, std::vector<std::uint8_t>& resource);
+    // Loads all named resources from cache directory. Returns false and clears 'resources' if any of them can't be loaded,
+    // in which case they are extracted from the archive instead
+    static bool loadCachedResources(const std::string& dir,
+                                    const std::vector<std::string>& names,
+                                    std::unordered_map<std::string, std::vector<std::uint8_t>>& resources);
+    // Stores a resource into cache directory, ignoring failures
+    static void storeCachedResource(const std::string& dir, const std::string& name, const std::vector<std::uint8_t>& resource);
+
     static Resources& getInstance();
     Resources(Resources const&) = delete;
     void operator=(Resources const&) = delete;
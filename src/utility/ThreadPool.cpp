@@ -0,0 +1,138 @@
+#include "depthai/utility/ThreadPool.hpp"
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// libraries
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+struct ThreadPool::State {
+    struct Worker {
+        std::mutex mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<unsigned> nextWorker{0};
+    std::mutex sleepMtx;
+    std::condition_variable sleepCv;
+    std::size_t numQueued{0};
+    bool stopping{false};
+
+    bool tryGetTask(unsigned index, std::function<void()>& task);
+    void run(unsigned index);
+};
+
+namespace {
+// Pool state and index of the worker running on the current thread
+thread_local const void* currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned numThreads) : state(std::make_shared<State>()) {
+    if(numThreads == 0) numThreads = std::thread::hardware_concurrency();
+    if(numThreads == 0) numThreads = 1;
+
+    state->workers.reserve(numThreads);
+    for(unsigned i = 0; i < numThreads; i++) {
+        state->workers.push_back(std::make_unique<State::Worker>());
+    }
+    threads.reserve(numThreads);
+    for(unsigned i = 0; i < numThreads; i++) {
+        threads.emplace_back([state = state, i]() { state->run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(state->sleepMtx);
+        state->stopping = true;
+    }
+    state->sleepCv.notify_all();
+
+    for(auto& thread : threads) {
+        if(thread.get_id() == std::this_thread::get_id()) {
+            // Destroyed from within a task, the thread finishes by itself
+            thread.detach();
+        } else if(thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    auto& workers = state->workers;
+    // Keep tasks submitted by a worker local to it, otherwise distribute round robin
+    const unsigned index = currentPool == state.get() ? currentWorker : state->nextWorker++ % workers.size();
+    {
+        std::unique_lock<std::mutex> lock(workers[index]->mtx);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::unique_lock<std::mutex> lock(state->sleepMtx);
+        state->numQueued++;
+    }
+    state->sleepCv.notify_one();
+}
+
+unsigned ThreadPool::getNumThreads() const {
+    return static_cast<unsigned>(threads.size());
+}
+
+bool ThreadPool::State::tryGetTask(unsigned index, std::function<void()>& task) {
+    // Own tasks first, oldest first
+    {
+        auto& own = *workers[index];
+        std::unique_lock<std::mutex> lock(own.mtx);
+        if(!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    // Then steal from the back of the others
+    for(std::size_t i = 1; i < workers.size(); i++) {
+        auto& victim = *workers[(index + i) % workers.size()];
+        std::unique_lock<std::mutex> lock(victim.mtx);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::State::run(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            sleepCv.wait(lock, [this]() { return numQueued > 0 || stopping; });
+            // Finish remaining tasks before stopping
+            if(numQueued == 0) return;
+            numQueued--;
+        }
+
+        // A task is reserved by the decrement above, it can only be in flight of being queued
+        std::function<void()> task;
+        while(!tryGetTask(index, task)) {
+            std::this_thread::yield();
+        }
+
+        try {
+            task();
+        } catch(const std::exception& ex) {
+            logger::error("ThreadPool task threw an exception: {}", ex.what());
+        }
+    }
+}
+
+}  // namespace dai
@@ -0,0 +1,250 @@
+#include "depthai/xlink/DeviceRegistry.hpp"
+
+// std
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// libraries
+#include <XLink/XLink.h>
+
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+namespace {
+
+// Identifies a device across scans. Name of a USB device changes on boot, so its mxid is preferred
+std::string getKey(const DeviceInfo& device) {
+    return std::to_string(static_cast<int>(device.protocol)) + ":" + (device.mxid.empty() ? device.name : device.mxid);
+}
+
+std::vector<DeviceInfo> scanConnectedDevices(XLinkProtocol_t protocol) {
+    return XLinkConnection::getAllConnectedDevices(X_LINK_ANY_STATE, false, protocol);
+}
+
+}  // namespace
+
+std::shared_ptr<DeviceRegistry> DeviceRegistry::getInstance() {
+    static const auto instance = std::make_shared<DeviceRegistry>();
+    return instance;
+}
+
+bool DeviceRegistry::matches(const DeviceInfo& device, const DeviceInfo& pattern, bool matchName) {
+    if(matchName && !pattern.name.empty() && device.name != pattern.name) return false;
+    if(!pattern.mxid.empty() && device.mxid != pattern.mxid) return false;
+    if(pattern.state != X_LINK_ANY_STATE && device.state != pattern.state) return false;
+    if(pattern.protocol != X_LINK_ANY_PROTOCOL && device.protocol != pattern.protocol) return false;
+    if(pattern.platform != X_LINK_ANY_PLATFORM && device.platform != pattern.platform) return false;
+    return true;
+}
+
+DeviceRegistry::DeviceRegistry() : DeviceRegistry(Config{}) {}
+
+DeviceRegistry::DeviceRegistry(Config cfg) : config(std::move(cfg)) {
+    if(config.protocols.empty()) throw std::invalid_argument("DeviceRegistry requires at least one protocol");
+    for(const auto& protocol : config.protocols) {
+        ProtocolState state;
+        state.protocol = protocol;
+        protocols.push_back(std::move(state));
+    }
+    for(std::size_t i = 0; i < protocols.size(); i++) {
+        scanningThreads.emplace_back([this, i]() { scan(i); });
+    }
+}
+
+DeviceRegistry::~DeviceRegistry() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        running = false;
+    }
+    scanCv.notify_all();
+    scannedCv.notify_all();
+    for(auto& thread : scanningThreads) {
+        if(thread.joinable()) thread.join();
+    }
+}
+
+std::vector<DeviceInfo> DeviceRegistry::getDevices() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::vector<DeviceInfo> devices;
+    for(const auto& state : protocols) {
+        devices.insert(devices.end(), state.devices.begin(), state.devices.end());
+    }
+    return devices;
+}
+
+DeviceRegistry::CallbackId DeviceRegistry::addCallback(Callback callback) {
+    CallbackId id;
+    {
+        std::unique_lock<std::mutex> lock(callbacksMtx);
+        id = uniqueCallbackId++;
+        callbacks[id] = std::move(callback);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        numCallbacks++;
+    }
+    // Start periodic scanning
+    scanCv.notify_all();
+    return id;
+}
+
+bool DeviceRegistry::removeCallback(CallbackId callbackId) {
+    {
+        std::unique_lock<std::mutex> lock(callbacksMtx);
+        if(callbacks.erase(callbackId) == 0) return false;
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    numCallbacks--;
+    return true;
+}
+
+std::tuple<bool, DeviceInfo> DeviceRegistry::waitForDevice(Selector select, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock(mtx);
+    // Only scans started from now on are considered
+    std::vector<std::uint64_t> numStartedBefore;
+    for(auto& state : protocols) {
+        numStartedBefore.push_back(state.numStarted);
+        state.scanRequested = true;
+    }
+    numWaiters++;
+    scanCv.notify_all();
+
+    std::tuple<bool, DeviceInfo> result{false, {}};
+    while(running) {
+        std::vector<DeviceInfo> devices;
+        bool anyScanned = false;
+        bool allScanned = true;
+        for(std::size_t i = 0; i < protocols.size(); i++) {
+            const auto& state = protocols[i];
+            if(state.numFound > numStartedBefore[i]) {
+                anyScanned = true;
+                devices.insert(devices.end(), state.devices.begin(), state.devices.end());
+            }
+            if(state.numCompleted <= numStartedBefore[i]) allScanned = false;
+        }
+
+        DeviceInfo selected;
+        if(anyScanned && select(devices, selected)) {
+            result = std::make_tuple(true, selected);
+            break;
+        }
+        // Scans in progress are waited for past the deadline
+        if(std::chrono::steady_clock::now() >= deadline && allScanned) break;
+        if(std::chrono::steady_clock::now() >= deadline) {
+            scannedCv.wait(lock);
+        } else {
+            scannedCv.wait_until(lock, deadline);
+        }
+    }
+    numWaiters--;
+    return result;
+}
+
+std::tuple<bool, DeviceInfo> DeviceRegistry::waitForDevice(const DeviceInfo& pattern, std::chrono::milliseconds timeout, bool nameHintOnly) {
+    return waitForDevice(
+        [&pattern, nameHintOnly](const std::vector<DeviceInfo>& devices, DeviceInfo& selected) {
+            for(const auto& device : devices) {
+                if(matches(device, pattern)) {
+                    selected = device;
+                    return true;
+                }
+            }
+            if(nameHintOnly) {
+                for(const auto& device : devices) {
+                    if(matches(device, pattern, false)) {
+                        selected = device;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        },
+        timeout);
+}
+
+void DeviceRegistry::scan(std::size_t index) {
+    const auto scanner = config.scanner ? config.scanner : Scanner(scanConnectedDevices);
+    const auto protocol = protocols[index].protocol;
+
+    while(true) {
+        std::uint64_t scanNumber = 0;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            auto& state = protocols[index];
+            // Wait for a request or for the next periodic scan. Without waiters or callbacks nothing is scanned
+            while(running && !state.scanRequested) {
+                if(numWaiters > 0) {
+                    if(scanCv.wait_for(lock, config.activeScanInterval) == std::cv_status::timeout) break;
+                } else if(numCallbacks > 0) {
+                    if(scanCv.wait_for(lock, config.idleScanInterval) == std::cv_status::timeout) break;
+                } else {
+                    scanCv.wait(lock);
+                }
+            }
+            if(!running) return;
+            state.scanRequested = false;
+            scanNumber = ++state.numStarted;
+        }
+
+        std::vector<DeviceInfo> devices;
+        bool found = true;
+        try {
+            devices = scanner(protocol);
+        } catch(const std::exception& ex) {
+            logger::debug("Scanning for {} devices failed: {}", XLinkProtocolToStr(protocol), ex.what());
+            found = false;
+        }
+
+        std::vector<std::pair<Event, DeviceInfo>> events;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            auto& state = protocols[index];
+            if(found) {
+                std::unordered_map<std::string, const DeviceInfo*> previous;
+                for(const auto& device : state.devices) previous[getKey(device)] = &device;
+                for(const auto& device : devices) {
+                    auto it = previous.find(getKey(device));
+                    if(it == previous.end()) {
+                        events.emplace_back(Event::ADDED, device);
+                        continue;
+                    }
+                    const auto& before = *it->second;
+                    if(before.state != device.state || before.name != device.name || before.status != device.status) {
+                        events.emplace_back(Event::STATE_CHANGED, device);
+                    }
+                    previous.erase(it);
+                }
+                for(const auto& device : state.devices) {
+                    if(previous.count(getKey(device)) > 0) events.emplace_back(Event::REMOVED, device);
+                }
+                state.devices = std::move(devices);
+                state.numFound = scanNumber;
+            }
+            state.numCompleted = scanNumber;
+        }
+        scannedCv.notify_all();
+
+        for(const auto& event : events) {
+            // Callbacks are called without the lock held, so they may add or remove callbacks, themselves included
+            std::map<CallbackId, Callback> currentCallbacks;
+            {
+                std::unique_lock<std::mutex> lock(callbacksMtx);
+                currentCallbacks = callbacks;
+            }
+            for(const auto& kv : currentCallbacks) {
+                try {
+                    kv.second(event.first, event.second);
+                } catch(const std::exception& ex) {
+                    logger::error("Device registry callback with id: {} threw an exception: {}", kv.first, ex.what());
+                }
+            }
+        }
+    }
+}
+
+}  // namespace dai
@@ -0,0 +1,189 @@
+#include "depthai/xlink/StreamReactor.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+// libraries
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+struct StreamReactor::Entry {
+    StreamId id;
+    std::unique_ptr<PacketStream> stream;
+    PacketHandler onPacket;
+    ErrorHandler onError;
+    // Held while the stream is serviced
+    std::mutex busy;
+    std::atomic<bool> removed{false};
+
+    Entry(StreamId id, std::unique_ptr<PacketStream> stream, PacketHandler onPacket, ErrorHandler onError)
+        : id(id), stream(std::move(stream)), onPacket(std::move(onPacket)), onError(std::move(onError)) {}
+};
+
+namespace {
+// Entry being serviced by the current thread
+thread_local const void* currentEntry = nullptr;
+}  // namespace
+
+StreamReactor::StreamReactor() : StreamReactor(Config{}) {}
+
+StreamReactor::StreamReactor(Config cfg) : config(cfg), callbackPool(std::make_shared<ThreadPool>(std::max(1u, cfg.numCallbackThreads))) {
+    const unsigned numThreads = std::max(1u, config.numThreads);
+    workers.reserve(numThreads);
+    for(unsigned i = 0; i < numThreads; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for(auto& worker : workers) {
+        auto* w = worker.get();
+        worker->thread = std::thread([this, w]() { run(*w); });
+    }
+}
+
+StreamReactor::~StreamReactor() {
+    running = false;
+    for(auto& worker : workers) {
+        // Lock, so a thread about to wait for streams sees 'running' changed
+        { std::unique_lock<std::mutex> lock(worker->mtx); }
+        worker->cv.notify_all();
+    }
+    for(auto& worker : workers) {
+        if(worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+StreamReactor::StreamId StreamReactor::add(XLinkStream&& stream, PacketHandler onPacket, ErrorHandler onError) {
+    return add(std::make_unique<XLinkStream>(std::move(stream)), std::move(onPacket), std::move(onError));
+}
+
+StreamReactor::StreamId StreamReactor::add(std::unique_ptr<PacketStream> stream, PacketHandler onPacket, ErrorHandler onError) {
+    if(stream == nullptr) throw std::invalid_argument("PacketStream passed is not valid (nullptr)");
+    const StreamId id = nextId++;
+    auto entry = std::make_shared<Entry>(id, std::move(stream), std::move(onPacket), std::move(onError));
+
+    // Assign to the thread with the least streams
+    Worker* target = nullptr;
+    std::size_t minEntries = 0;
+    for(auto& worker : workers) {
+        std::unique_lock<std::mutex> lock(worker->mtx);
+        if(target == nullptr || worker->entries.size() < minEntries) {
+            target = worker.get();
+            minEntries = worker->entries.size();
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(target->mtx);
+        target->entries.push_back(std::move(entry));
+        target->version++;
+    }
+    target->cv.notify_all();
+    return id;
+}
+
+void StreamReactor::remove(StreamId id) {
+    for(auto& worker : workers) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::unique_lock<std::mutex> lock(worker->mtx);
+            auto it = std::find_if(worker->entries.begin(), worker->entries.end(), [id](const std::shared_ptr<Entry>& e) { return e->id == id; });
+            if(it == worker->entries.end()) continue;
+            entry = *it;
+            worker->entries.erase(it);
+            worker->version++;
+        }
+
+        entry->removed = true;
+        // Wait for the handler to finish, unless removed from within it
+        if(currentEntry != entry.get()) {
+            std::unique_lock<std::mutex> busy(entry->busy);
+        }
+        return;
+    }
+}
+
+StreamReactor::Config StreamReactor::getConfig() const {
+    return config;
+}
+
+StreamReactor::Stats StreamReactor::getStats() const {
+    Stats stats;
+    stats.numPackets = numPackets;
+    stats.numIdlePasses = numIdlePasses;
+    for(const auto& worker : workers) {
+        std::unique_lock<std::mutex> lock(worker->mtx);
+        stats.numStreams += worker->entries.size();
+    }
+    return stats;
+}
+
+std::shared_ptr<ThreadPool> StreamReactor::getCallbackPool() const {
+    return callbackPool;
+}
+
+void StreamReactor::run(Worker& worker) {
+    std::vector<std::shared_ptr<Entry>> entries;
+    std::uint64_t version = 0;
+    // Whether the previous pass read no packets, and which stream to wait on in the next one
+    bool waiting = false;
+    std::size_t waitIndex = 0;
+
+    while(running) {
+        // Refresh the local copy of streams, only if they changed. Without streams wait for one to be added
+        {
+            std::unique_lock<std::mutex> lock(worker.mtx);
+            worker.cv.wait(lock, [this, &worker]() { return !running || !worker.entries.empty(); });
+            if(!running) break;
+            if(worker.version != version) {
+                entries = worker.entries;
+                version = worker.version;
+                if(waitIndex >= entries.size()) waitIndex = 0;
+            }
+        }
+
+        bool idle = true;
+        for(std::size_t i = 0; i < entries.size(); i++) {
+            auto& entry = entries[i];
+            // Poll the streams, except for the one waited on after a pass without packets
+            const auto timeout = waiting && i == waitIndex ? config.readTimeout : std::chrono::milliseconds(0);
+            std::unique_lock<std::mutex> busy(entry->busy);
+            if(entry->removed) continue;
+            currentEntry = entry.get();
+            try {
+                StreamPacketDesc packet;
+                if(entry->stream->readMove(packet, timeout)) {
+                    idle = false;
+                    numPackets++;
+                    entry->onPacket(*entry->stream, std::move(packet));
+                }
+            } catch(const std::exception& ex) {
+                // Unregister the stream before reporting, the error handler may remove it as well (eg. by closing its queue)
+                entry->removed = true;
+                {
+                    std::unique_lock<std::mutex> lock(worker.mtx);
+                    auto it = std::find(worker.entries.begin(), worker.entries.end(), entry);
+                    if(it != worker.entries.end()) {
+                        worker.entries.erase(it);
+                        worker.version++;
+                    }
+                }
+                try {
+                    entry->onError(ex);
+                } catch(const std::exception& handlerEx) {
+                    logger::error("StreamReactor error handler threw an exception: {}", handlerEx.what());
+                }
+            }
+            currentEntry = nullptr;
+        }
+
+        if(idle) {
+            numIdlePasses++;
+            // Wait on the streams in turn
+            if(waiting) waitIndex = (waitIndex + 1) % entries.size();
+        }
+        waiting = idle;
+    }
+}
+
+}  // namespace dai
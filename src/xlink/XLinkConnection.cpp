@@ -11,6 +11,8 @@
 
 // project
 #include "depthai/utility/Initialization.hpp"
+#include "depthai/utility/MappedFile.hpp"
+#include "depthai/xlink/DeviceRegistry.hpp"
 #include "utility/Environment.hpp"
 #include "utility/spdlog-fmt.hpp"
 
@@ -111,14 +113,23 @@ constexpr std::chrono::milliseconds XLinkConnection::WAIT_FOR_CONNECT_TIMEOUT;
 constexpr std::chrono::milliseconds XLinkConnection::POLLING_DELAY_TIME;
 
 std::vector<DeviceInfo> XLinkConnection::getAllConnectedDevices(XLinkDeviceState_t state, bool skipInvalidDevices) {
+    return getAllConnectedDevices(state, skipInvalidDevices, getDefaultProtocol());
+}
+
+std::vector<DeviceInfo> XLinkConnection::getAllConnectedDevices(XLinkDeviceState_t state, bool skipInvalidDevices, XLinkProtocol_t protocol) {
     initialize();
 
+    // Protocol specified by DEPTHAI_PROTOCOL excludes others
+    const auto defaultProtocol = getDefaultProtocol();
+    if(defaultProtocol != X_LINK_ANY_PROTOCOL && protocol != X_LINK_ANY_PROTOCOL && protocol != defaultProtocol) return {};
+    if(protocol == X_LINK_ANY_PROTOCOL) protocol = defaultProtocol;
+
     std::vector<DeviceInfo> devices;
 
     unsigned int numdev = 0;
     std::array<deviceDesc_t, 64> deviceDescAll = {};
     deviceDesc_t suitableDevice = {};
-    suitableDevice.protocol = getDefaultProtocol();
+    suitableDevice.protocol = protocol;
     suitableDevice.platform = X_LINK_ANY_PLATFORM;
     suitableDevice.state = state;
 
@@ -366,10 +377,16 @@ bool XLinkConnection::getRebootOnDestruction() const {
 }
 
 bool XLinkConnection::bootAvailableDevice(const deviceDesc_t& deviceToBoot, const dai::Path& pathToMvcmd) {
-    std::ifstream fwStream(pathToMvcmd, std::ios::binary);
-    if(!fwStream.is_open()) throw std::runtime_error(fmt::format("Cannot boot firmware, binary at path: {} doesn't exist", pathToMvcmd));
-    std::vector<uint8_t> package = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(fwStream), {});
-    return bootAvailableDevice(deviceToBoot, package);
+    // Boot directly from the mapped file
+    std::unique_ptr<MappedFile> package;
+    try {
+        package = std::make_unique<MappedFile>(pathToMvcmd);
+    } catch(const std::runtime_error&) {
+        throw std::runtime_error(fmt::format("Cannot boot firmware, binary at path: {} doesn't exist", pathToMvcmd));
+    }
+    auto mvcmd = package->getData();
+    auto status = XLinkBootMemory(&deviceToBoot, mvcmd.data(), static_cast<unsigned long>(mvcmd.size()));
+    return status == X_LINK_SUCCESS;
 }
 
 bool XLinkConnection::bootAvailableDevice(const deviceDesc_t& deviceToBoot, std::vector<std::uint8_t>& mvcmd) {
@@ -412,27 +429,38 @@ void XLinkConnection::initDevice(const DeviceInfo& deviceToInit, XLinkDeviceStat
         }
     }
 
+    // Devices with a name (eg. IP address outside of broadcast reach) are searched for directly,
+    // others are waited for in the registry's scans
+    const auto findDevice = [](const DeviceInfo& device, milliseconds timeout, bool nameHintOnly) {
+        if(device.name.empty()) return DeviceRegistry::getInstance()->waitForDevice(device, timeout, nameHintOnly);
+
+        auto desc = device.getXLinkDeviceDesc();
+        desc.nameHintOnly = nameHintOnly;
+        deviceDesc_t foundDeviceDesc = {};
+        auto tstart = steady_clock::now();
+        do {
+            if(XLinkFindFirstSuitableDevice(desc, &foundDeviceDesc) == X_LINK_SUCCESS) return std::make_tuple(true, DeviceInfo(foundDeviceDesc));
+            std::this_thread::sleep_for(POLLING_DELAY_TIME);
+        } while(steady_clock::now() - tstart < timeout);
+        return std::make_tuple(false, DeviceInfo{});
+    };
+
     // boot device
+    auto tBootStart = steady_clock::now();
     if(bootDevice) {
         DeviceInfo deviceToBoot = lastDeviceInfo;
         deviceToBoot.state = X_LINK_UNBOOTED;
 
-        deviceDesc_t foundDeviceDesc = {};
-
         // Wait for the device to be available
-        auto tstart = steady_clock::now();
-        do {
-            rc = XLinkFindFirstSuitableDevice(deviceToBoot.getXLinkDeviceDesc(), &foundDeviceDesc);
-            if(rc == X_LINK_SUCCESS) break;
-            std::this_thread::sleep_for(POLLING_DELAY_TIME);
-        } while(steady_clock::now() - tstart < bootupTimeout);
+        bool found = false;
+        std::tie(found, lastDeviceInfo) = findDevice(deviceToBoot, bootupTimeout, false);
 
         // If device not found
-        if(rc != X_LINK_SUCCESS) {
-            throw std::runtime_error("Failed to find device (" + deviceToBoot.name + "), error message: " + convertErrorCodeToString(rc));
+        if(!found) {
+            throw std::runtime_error("Failed to find device (" + deviceToBoot.name + "), error message: " + convertErrorCodeToString(X_LINK_DEVICE_NOT_FOUND));
         }
 
-        lastDeviceInfo = DeviceInfo(foundDeviceDesc);
+        const auto foundDeviceDesc = lastDeviceInfo.getXLinkDeviceDesc();
 
         bool bootStatus;
         if(bootWithPath) {
@@ -445,6 +473,9 @@ void XLinkConnection::initDevice(const DeviceInfo& deviceToInit, XLinkDeviceStat
         }
     }
 
+    auto tBootEnd = steady_clock::now();
+    if(bootDevice) bootTime = tBootEnd - tBootStart;
+
     // Search for booted device
     {
         // Create description of device to look for
@@ -452,27 +483,15 @@ void XLinkConnection::initDevice(const DeviceInfo& deviceToInit, XLinkDeviceStat
         // Has to match expected state
         bootedDeviceInfo.state = expectedState;
 
-        // Prepare descriptor to search for
-        auto bootedDescInfo = bootedDeviceInfo.getXLinkDeviceDesc();
-        // Use "name" as hint only, but might still change
-        bootedDescInfo.nameHintOnly = true;
-
         logger::debug("Searching for booted device: {}, name used as hint only", bootedDeviceInfo.toString());
 
-        // Find booted device
-        deviceDesc_t foundDeviceDesc = {};
-        auto tstart = steady_clock::now();
-        do {
-            rc = XLinkFindFirstSuitableDevice(bootedDescInfo, &foundDeviceDesc);
-            if(rc == X_LINK_SUCCESS) break;
-            std::this_thread::sleep_for(POLLING_DELAY_TIME);
-        } while(steady_clock::now() - tstart < bootupTimeout);
+        // Find booted device. Use "name" as hint only, but might still change
+        bool found = false;
+        std::tie(found, lastDeviceInfo) = findDevice(bootedDeviceInfo, bootupTimeout, true);
 
-        if(rc != X_LINK_SUCCESS) {
-            throw std::runtime_error("Failed to find device after booting, error message: " + convertErrorCodeToString(rc));
+        if(!found) {
+            throw std::runtime_error("Failed to find device after booting, error message: " + convertErrorCodeToString(X_LINK_DEVICE_NOT_FOUND));
         }
-
-        lastDeviceInfo = DeviceInfo(foundDeviceDesc);
     }
 
     // Try to connect to device
@@ -494,6 +513,16 @@ void XLinkConnection::initDevice(const DeviceInfo& deviceToInit, XLinkDeviceStat
         deviceInfo = lastDeviceInfo;
         deviceInfo.state = X_LINK_BOOTED;
     }
+
+    connectTime = steady_clock::now() - tBootEnd;
+}
+
+std::chrono::nanoseconds XLinkConnection::getBootTime() const {
+    return bootTime;
+}
+
+std::chrono::nanoseconds XLinkConnection::getConnectTime() const {
+    return connectTime;
 }
 
 int XLinkConnection::getLinkId() const {
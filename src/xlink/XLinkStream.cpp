@@ -6,6 +6,7 @@
 
 // project
 #include "depthai/xlink/XLinkConnection.hpp"
+#include "utility/Environment.hpp"
 
 namespace dai {
 
@@ -34,7 +35,11 @@ XLinkStream::XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std:
 
 // Move constructor
 XLinkStream::XLinkStream(XLinkStream&& other)
-    : connection(std::move(other.connection)), streamName(std::exchange(other.streamName, {})), streamId(std::exchange(other.streamId, INVALID_STREAM_ID)) {
+    : connection(std::move(other.connection)),
+      streamName(std::exchange(other.streamName, {})),
+      streamId(std::exchange(other.streamId, INVALID_STREAM_ID)),
+      gatherBuffer(std::move(other.gatherBuffer)),
+      profiler(std::exchange(other.profiler, std::make_shared<StreamProfiler>())) {
     // Set other's streamId to INVALID_STREAM_ID to prevent closing
 }
 
@@ -43,6 +48,8 @@ XLinkStream& XLinkStream::operator=(XLinkStream&& other) {
         connection = std::move(other.connection);
         streamId = std::exchange(other.streamId, INVALID_STREAM_ID);
         streamName = std::exchange(other.streamName, {});
+        gatherBuffer = std::move(other.gatherBuffer);
+        profiler = std::exchange(other.profiler, std::make_shared<StreamProfiler>());
     }
     return *this;
 }
@@ -73,12 +80,20 @@ StreamPacketDesc::~StreamPacketDesc() noexcept {
     XLinkDeallocateMoveData(data, length);
 }
 
+StreamPacketMemory::StreamPacketMemory(StreamPacketDesc&& packet, std::size_t size) : packet(std::move(packet)), size(size) {
+    if(size > this->packet.length) throw std::invalid_argument("StreamPacketMemory size larger than packet length");
+}
+
+span<std::uint8_t> StreamPacketMemory::getData() {
+    return {packet.data, size};
+}
+
 ////////////////////
 // BLOCKING VERSIONS
 ////////////////////
 
 void XLinkStream::write(const std::uint8_t* data, std::size_t size) {
-    auto status = XLinkWriteData(streamId, data, static_cast<int>(size));
+    auto status = writeData(data, size);
     if(status != X_LINK_SUCCESS) {
         throw XLinkWriteError(status, streamName);
     }
@@ -91,9 +106,43 @@ void XLinkStream::write(const std::vector<std::uint8_t>& data) {
     write(data.data(), data.size());
 }
 
+void XLinkStream::write(const std::vector<span<const std::uint8_t>>& segments) {
+    std::vector<span<const std::uint8_t>> nonEmpty;
+    nonEmpty.reserve(segments.size());
+    for(const auto& segment : segments) {
+        if(!segment.empty()) nonEmpty.push_back(segment);
+    }
+
+    // Single segment can be written directly
+    if(nonEmpty.empty()) {
+        write(static_cast<const std::uint8_t*>(nullptr), 0);
+        return;
+    } else if(nonEmpty.size() == 1) {
+        write(nonEmpty[0].data(), nonEmpty[0].size());
+        return;
+    }
+
+    // XLink sends up to two buffers as a single packet. The first segment is sent in place,
+    // further segments are gathered with the second one into a buffer which keeps its capacity
+    span<const std::uint8_t> rest = nonEmpty[1];
+    if(nonEmpty.size() > 2) {
+        gatherBuffer.clear();
+        for(std::size_t i = 1; i < nonEmpty.size(); i++) gatherBuffer.insert(gatherBuffer.end(), nonEmpty[i].begin(), nonEmpty[i].end());
+        rest = {gatherBuffer.data(), gatherBuffer.size()};
+    }
+    auto status = writeData(nonEmpty[0].data(), nonEmpty[0].size(), rest.data(), rest.size());
+    if(status != X_LINK_SUCCESS) {
+        throw XLinkWriteError(status, streamName);
+    }
+}
+
+void XLinkStream::shrinkGatherBuffer() {
+    std::vector<std::uint8_t>().swap(gatherBuffer);
+}
+
 void XLinkStream::read(std::vector<std::uint8_t>& data) {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveData(streamId, &packet);
+    const auto status = readMoveData(packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
@@ -102,7 +151,7 @@ void XLinkStream::read(std::vector<std::uint8_t>& data) {
 
 void XLinkStream::read(std::vector<std::uint8_t>& data, XLinkTimespec& timestampReceived) {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveData(streamId, &packet);
+    const auto status = readMoveData(packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
@@ -124,7 +173,7 @@ std::vector<std::uint8_t> XLinkStream::read(XLinkTimespec& timestampReceived) {
 
 StreamPacketDesc XLinkStream::readMove() {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveData(streamId, &packet);
+    const auto status = readMoveData(packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
@@ -156,7 +205,7 @@ void XLinkStream::writeSplit(const void* d, std::size_t size, std::size_t split)
     XLinkError_t ret = X_LINK_SUCCESS;
     while(remaining > 0) {
         sizeToTransmit = remaining > split ? split : remaining;
-        ret = XLinkWriteData(streamId, data + currentOffset, static_cast<int>(sizeToTransmit));
+        ret = writeData(data + currentOffset, sizeToTransmit);
         if(ret != X_LINK_SUCCESS) {
             throw XLinkWriteError(ret, streamName);
         }
@@ -174,7 +223,7 @@ void XLinkStream::writeSplit(const std::vector<uint8_t>& data, std::size_t split
 //////////////////////
 
 bool XLinkStream::write(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout) {
-    auto status = XLinkWriteDataWithTimeout(streamId, data, static_cast<int>(size), static_cast<unsigned int>(timeout.count()));
+    auto status = writeData(data, size, timeout);
     if(status == X_LINK_SUCCESS) {
         return true;
     } else if(status == X_LINK_TIMEOUT) {
@@ -194,7 +243,7 @@ bool XLinkStream::write(const std::vector<std::uint8_t>& data, std::chrono::mill
 
 bool XLinkStream::read(std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout) {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
+    const auto status = readMoveData(packet, timeout);
     if(status == X_LINK_SUCCESS) {
         data = std::vector<std::uint8_t>(packet.data, packet.data + packet.length);
         return true;
@@ -206,7 +255,7 @@ bool XLinkStream::read(std::vector<std::uint8_t>& data, std::chrono::millisecond
 }
 
 bool XLinkStream::readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout) {
-    const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
+    const auto status = readMoveData(packet, timeout);
     if(status == X_LINK_SUCCESS) {
         return true;
     } else if(status == X_LINK_TIMEOUT) {
@@ -216,6 +265,26 @@ bool XLinkStream::readMove(StreamPacketDesc& packet, const std::chrono::millisec
     }
 }
 
+tl::optional<StreamPacketDesc> XLinkStream::readMove(std::chrono::milliseconds timeout) {
+    StreamPacketDesc packet;
+    if(!readMove(packet, timeout)) return tl::nullopt;
+    return tl::optional<StreamPacketDesc>(std::move(packet));
+}
+
+std::size_t XLinkStream::readMoveMany(std::vector<StreamPacketDesc>& packets, std::chrono::milliseconds timeout, std::size_t maxNumPackets) {
+    std::size_t numRead = 0;
+    auto wait = timeout;
+    while(numRead < maxNumPackets) {
+        StreamPacketDesc packet;
+        if(!readMove(packet, wait)) break;
+        packets.push_back(std::move(packet));
+        numRead++;
+        // Only the first read waits, following ones take what's already pending
+        wait = std::chrono::milliseconds(0);
+    }
+    return numRead;
+}
+
 bool XLinkStream::readRaw(streamPacketDesc_t*& pPacket, std::chrono::milliseconds timeout) {
     auto status = XLinkReadDataWithTimeout(streamId, &pPacket, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
@@ -231,6 +300,111 @@ streamId_t XLinkStream::getStreamId() const {
     return streamId;
 }
 
+StreamProfilingData XLinkStream::getProfilingData() const {
+    return profiler->getData();
+}
+
+std::shared_ptr<StreamProfiler> XLinkStream::getProfiler() const {
+    return profiler;
+}
+
+////////////////
+// PROFILING //
+///////////////
+
+XLinkError_t XLinkStream::readMoveData(StreamPacketDesc& packet) {
+    if(!StreamProfiler::isEnabled()) return XLinkReadMoveData(streamId, &packet);
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto status = XLinkReadMoveData(streamId, &packet);
+    profiler->recordRead(std::chrono::steady_clock::now() - t1, status == X_LINK_SUCCESS ? &packet : nullptr);
+    return status;
+}
+
+XLinkError_t XLinkStream::readMoveData(StreamPacketDesc& packet, std::chrono::milliseconds timeout) {
+    if(!StreamProfiler::isEnabled()) return XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
+    profiler->recordRead(std::chrono::steady_clock::now() - t1, status == X_LINK_SUCCESS ? &packet : nullptr);
+    return status;
+}
+
+XLinkError_t XLinkStream::writeData(const std::uint8_t* data, std::size_t size) {
+    if(!StreamProfiler::isEnabled()) return XLinkWriteData(streamId, data, static_cast<int>(size));
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto status = XLinkWriteData(streamId, data, static_cast<int>(size));
+    profiler->recordWrite(std::chrono::steady_clock::now() - t1, size, status == X_LINK_SUCCESS);
+    return status;
+}
+
+XLinkError_t XLinkStream::writeData(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout) {
+    if(!StreamProfiler::isEnabled()) {
+        return XLinkWriteDataWithTimeout(streamId, data, static_cast<int>(size), static_cast<unsigned int>(timeout.count()));
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto status = XLinkWriteDataWithTimeout(streamId, data, static_cast<int>(size), static_cast<unsigned int>(timeout.count()));
+    profiler->recordWrite(std::chrono::steady_clock::now() - t1, size, status == X_LINK_SUCCESS);
+    return status;
+}
+
+XLinkError_t XLinkStream::writeData(const std::uint8_t* data1, std::size_t size1, const std::uint8_t* data2, std::size_t size2) {
+    if(!StreamProfiler::isEnabled()) return XLinkWriteData2(streamId, data1, static_cast<int>(size1), data2, static_cast<int>(size2));
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto status = XLinkWriteData2(streamId, data1, static_cast<int>(size1), data2, static_cast<int>(size2));
+    profiler->recordWrite(std::chrono::steady_clock::now() - t1, size1 + size2, status == X_LINK_SUCCESS);
+    return status;
+}
+
+static std::atomic<bool>& profilingEnabled() {
+    static std::atomic<bool> enabled{utility::getEnv("DEPTHAI_PROFILING") == "1"};
+    return enabled;
+}
+
+void StreamProfiler::setEnabled(bool enabled) {
+    profilingEnabled() = enabled;
+}
+
+bool StreamProfiler::isEnabled() {
+    return profilingEnabled().load(std::memory_order_relaxed);
+}
+
+void StreamProfiler::recordRead(std::chrono::steady_clock::duration duration, const streamPacketDesc_t* packet) {
+    // Reads which timed out only measure idle waiting
+    if(packet == nullptr) return;
+    readBlockedNs += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    numPacketsRead++;
+    numBytesRead += packet->length;
+    readTime.record(duration);
+
+    // Only if the remote timestamped the packet
+    if(packet->tRemoteSent.tv_sec != 0 || packet->tRemoteSent.tv_nsec != 0) {
+        const auto sent = std::chrono::seconds(packet->tRemoteSent.tv_sec) + std::chrono::nanoseconds(packet->tRemoteSent.tv_nsec);
+        const auto received = std::chrono::seconds(packet->tReceived.tv_sec) + std::chrono::nanoseconds(packet->tReceived.tv_nsec);
+        latency.record(received - sent);
+    }
+}
+
+void StreamProfiler::recordWrite(std::chrono::steady_clock::duration duration, std::size_t size, bool written) {
+    writeBlockedNs += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    if(!written) return;
+    numPacketsWritten++;
+    numBytesWritten += size;
+    writeTime.record(duration);
+}
+
+StreamProfilingData StreamProfiler::getData() const {
+    StreamProfilingData data;
+    data.numPacketsRead = numPacketsRead;
+    data.numBytesRead = numBytesRead;
+    data.numPacketsWritten = numPacketsWritten;
+    data.numBytesWritten = numBytesWritten;
+    data.readTime = readTime.getSnapshot();
+    data.writeTime = writeTime.getSnapshot();
+    data.readBlockedTime = std::chrono::nanoseconds(readBlockedNs.load());
+    data.writeBlockedTime = std::chrono::nanoseconds(writeBlockedNs.load());
+    data.latency = latency.getSnapshot();
+    return data;
+}
+
 XLinkReadError::XLinkReadError(XLinkError_t status, const std::string& streamName)
     : XLinkError(status, streamName, fmt::format("Couldn't read data from stream: '{}' ({})", streamName, XLinkConnection::convertErrorCodeToString(status))) {}
 
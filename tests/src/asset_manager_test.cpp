@@ -0,0 +1,128 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/utility/MappedFile.hpp>
+
+namespace {
+
+std::string writeFile(const std::string& name, const std::vector<std::uint8_t>& contents) {
+    std::ofstream file(name, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    return name;
+}
+
+}  // namespace
+
+TEST_CASE("Assets reference mapped files through serialization") {
+    std::vector<std::uint8_t> contents(1000, 3);
+    const auto path = writeFile("asset_manager_test_asset.bin", contents);
+
+    {
+        dai::AssetManager assetManager;
+        assetManager.set("first", std::vector<std::uint8_t>(100, 1), 64);
+        auto mapped = assetManager.set("mapped", std::make_shared<dai::MappedFile>(path), 64);
+        auto loaded = assetManager.set("loaded", dai::Path(path), 32);
+        assetManager.set("last", std::vector<std::uint8_t>(30, 2), 16);
+        REQUIRE(mapped->data.empty());
+        REQUIRE(mapped->getSize() == contents.size());
+        // Mapping is opt-in, files loaded by path are read
+        REQUIRE(loaded->memory == nullptr);
+        REQUIRE(loaded->data == contents);
+
+        // Referencing storage matches the copied one
+        dai::AssetsMutable copiedAssets, referencedAssets;
+        std::vector<std::uint8_t> copied;
+        dai::AssetStorage referenced;
+        assetManager.serialize(copiedAssets, copied);
+        assetManager.serialize(referencedAssets, referenced);
+        REQUIRE(referenced.size() == copied.size());
+        REQUIRE(referenced.toVector() == copied);
+
+        // Also when read in chunks
+        for(std::size_t chunk : {1, 7, 64, 4096}) {
+            std::vector<std::uint8_t> gathered;
+            for(std::size_t offset = 0; offset < referenced.size(); offset += chunk) {
+                for(const auto& segment : referenced.getSegments(offset, std::min(chunk, referenced.size() - offset))) {
+                    gathered.insert(gathered.end(), segment.begin(), segment.end());
+                }
+            }
+            REQUIRE(gathered == copied);
+        }
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Loading an unreadable path throws") {
+    dai::AssetManager assetManager;
+    REQUIRE_THROWS_AS(assetManager.set("missing", dai::Path("asset_manager_test_missing.bin")), std::runtime_error);
+    // A directory opens, but can't be read
+    REQUIRE_THROWS_AS(assetManager.set("directory", dai::Path(".")), std::runtime_error);
+
+    const auto path = writeFile("asset_manager_test_empty.bin", {});
+    REQUIRE(assetManager.set("empty", dai::Path(path))->data.empty());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Identical assets are stored once") {
+    std::vector<std::uint8_t> blob(1000);
+    for(std::size_t i = 0; i < blob.size(); i++) blob[i] = static_cast<std::uint8_t>(i);
+    auto other = blob;
+    other.back()++;
+
+    const auto makeAsset = [](const std::vector<std::uint8_t>& data, std::uint32_t alignment) {
+        auto asset = std::make_shared<dai::Asset>();
+        asset->data = data;
+        asset->alignment = alignment;
+        return asset;
+    };
+
+    dai::AssetStorage storage;
+    const auto otherOffset = storage.append(makeAsset(other, 64));
+    const auto blobOffset = storage.append(makeAsset(blob, 64));
+    const auto duplicateOffset = storage.append(makeAsset(blob, 64));
+    // Offset of the stored asset doesn't satisfy this alignment
+    const auto alignedOffset = storage.append(makeAsset(blob, 4096));
+
+    REQUIRE(duplicateOffset == blobOffset);
+    REQUIRE(otherOffset != blobOffset);
+    REQUIRE(alignedOffset != blobOffset);
+    REQUIRE(alignedOffset % 4096 == 0);
+    REQUIRE(storage.getDeduplicatedSize() == blob.size());
+
+    // Each offset still points to its contents
+    const auto data = storage.toVector();
+    const auto contentsAt = [&](std::size_t offset) { return std::vector<std::uint8_t>(data.begin() + offset, data.begin() + offset + blob.size()); };
+    REQUIRE(contentsAt(duplicateOffset) == blob);
+    REQUIRE(contentsAt(alignedOffset) == blob);
+    REQUIRE(contentsAt(otherOffset) == other);
+}
+
+TEST_CASE("Nodes sharing a blob reference the same asset") {
+    dai::Pipeline p;
+    auto nn1 = p.create<dai::node::NeuralNetwork>();
+    auto nn2 = p.create<dai::node::NeuralNetwork>();
+    nn1->setBlobPath(BLOB_PATH);
+    nn2->setBlobPath(BLOB_PATH);
+
+    dai::PipelineSchema schema;
+    dai::Assets assets;
+    dai::AssetStorage storage;
+    p.serialize(schema, assets, storage);
+
+    const auto& first = assets.map.at("/node/" + std::to_string(nn1->id) + "/__blob");
+    const auto& second = assets.map.at("/node/" + std::to_string(nn2->id) + "/__blob");
+    REQUIRE(first.offset == second.offset);
+    REQUIRE(first.size == second.size);
+    REQUIRE(storage.getDeduplicatedSize() == first.size);
+    REQUIRE(storage.size() < 2 * static_cast<std::size_t>(first.size));
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/device/CallbackExecutor.hpp>
+#include <depthai/utility/ThreadPool.hpp>
+
+TEST_CASE("Thread pool executes all tasks") {
+    std::atomic<int> count{0};
+    std::atomic<int> nestedCount{0};
+    {
+        dai::ThreadPool pool(4);
+        REQUIRE(pool.getNumThreads() == 4);
+        for(int i = 0; i < 1000; i++) {
+            pool.submit([&count, &nestedCount, &pool, i]() {
+                count++;
+                // Tasks submitted from a worker are executed as well
+                if(i % 10 == 0) pool.submit([&nestedCount]() { nestedCount++; });
+            });
+        }
+    }
+    REQUIRE(count == 1000);
+    REQUIRE(nestedCount == 100);
+}
+
+TEST_CASE("Inline executor") {
+    auto executor = std::make_shared<dai::CallbackExecutor>(dai::CallbackExecutor::Config{});
+    const auto id = std::this_thread::get_id();
+    std::thread::id executedOn;
+    REQUIRE(executor->execute([&executedOn]() { executedOn = std::this_thread::get_id(); }));
+    REQUIRE(executedOn == id);
+}
+
+TEST_CASE("Executors keep task order") {
+    auto pool = std::make_shared<dai::ThreadPool>(4);
+    for(auto mode : {dai::CallbackExecutor::Mode::THREAD, dai::CallbackExecutor::Mode::POOL}) {
+        dai::CallbackExecutor::Config config;
+        config.mode = mode;
+        config.maxPending = 4;
+        config.pool = pool;
+        auto executor = std::make_shared<dai::CallbackExecutor>(config);
+
+        std::vector<int> executed;
+        for(int i = 0; i < 100; i++) {
+            REQUIRE(executor->execute([&executed, i]() { executed.push_back(i); }));
+        }
+        executor->stop();
+
+        REQUIRE(executed.size() == 100);
+        for(int i = 0; i < 100; i++) REQUIRE(executed[i] == i);
+
+        auto stats = executor->getStats();
+        REQUIRE(stats.numScheduled == 100);
+        REQUIRE(stats.numExecuted == 100);
+        REQUIRE(stats.numDropped == 0);
+        REQUIRE(stats.maxNumPending <= 4);
+    }
+}
+
+TEST_CASE("Executor destroyed from within one of its tasks") {
+    // As a queue switching executors from within a callback drops the last reference to the previous one
+    dai::CallbackExecutor::Config config;
+    config.mode = dai::CallbackExecutor::Mode::THREAD;
+    auto owner = std::make_shared<dai::CallbackExecutor>(config);
+    std::mutex ownerMtx;
+    std::atomic<int> numExecuted{0};
+    std::promise<void> finished;
+    auto future = finished.get_future();
+    {
+        std::unique_lock<std::mutex> lock(ownerMtx);
+        REQUIRE(owner->execute([&owner, &ownerMtx, &numExecuted]() {
+            std::shared_ptr<dai::CallbackExecutor> last;
+            {
+                std::unique_lock<std::mutex> lock(ownerMtx);
+                last = std::move(owner);
+            }
+            last.reset();
+            numExecuted++;
+        }));
+        REQUIRE(owner->execute([&numExecuted]() { numExecuted++; }));
+        REQUIRE(owner->execute([&finished]() { finished.set_value(); }));
+    }
+
+    // Pending tasks are still executed after the executor is gone
+    REQUIRE(future.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    REQUIRE(numExecuted == 2);
+}
+
+TEST_CASE("Executor overflow policies") {
+    for(auto policy : {dai::CallbackExecutor::OverflowPolicy::DROP_OLDEST, dai::CallbackExecutor::OverflowPolicy::DROP_NEWEST}) {
+        dai::CallbackExecutor::Config config;
+        config.mode = dai::CallbackExecutor::Mode::THREAD;
+        config.maxPending = 2;
+        config.overflowPolicy = policy;
+        auto executor = std::make_shared<dai::CallbackExecutor>(config);
+
+        // Block the executor thread
+        std::atomic<bool> release{false};
+        std::atomic<bool> started{false};
+        executor->execute([&]() {
+            started = true;
+            while(!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        while(!started) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::vector<int> executed;
+        REQUIRE(executor->execute([&executed]() { executed.push_back(1); }));
+        REQUIRE(executor->execute([&executed]() { executed.push_back(2); }));
+        REQUIRE_FALSE(executor->execute([&executed]() { executed.push_back(3); }));
+        release = true;
+        executor->stop();
+
+        if(policy == dai::CallbackExecutor::OverflowPolicy::DROP_OLDEST) {
+            REQUIRE(executed == std::vector<int>{2, 3});
+        } else {
+            REQUIRE(executed == std::vector<int>{1, 2});
+        }
+        REQUIRE(executor->getStats().numDropped == 1);
+    }
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// Include depthai library
+#include <depthai/utility/ConflatingQueue.hpp>
+
+TEST_CASE("Only the latest element is kept") {
+    dai::ConflatingQueue<int> queue;
+    for(int i = 0; i < 10; i++) REQUIRE(queue.push(std::make_shared<int>(i)));
+    REQUIRE(queue.getNumOverwritten() == 9);
+
+    std::shared_ptr<int> value;
+    REQUIRE(queue.front(value));
+    REQUIRE(*value == 9);
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(*value == 9);
+    REQUIRE(queue.empty());
+    REQUIRE_FALSE(queue.tryPop(value));
+    REQUIRE(queue.getNumOverwritten() == 9);
+}
+
+TEST_CASE("Waiting consumer is woken up by push") {
+    dai::ConflatingQueue<int> queue;
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(std::make_shared<int>(42));
+    });
+
+    std::shared_ptr<int> value;
+    REQUIRE(queue.waitAndPop(value));
+    REQUIRE(*value == 42);
+    producer.join();
+
+    REQUIRE_FALSE(queue.tryWaitAndPop(value, std::chrono::milliseconds(10)));
+}
+
+TEST_CASE("Destruct wakes up waiting consumers") {
+    dai::ConflatingQueue<int> queue;
+    std::atomic<bool> popped{true};
+    std::thread consumer([&queue, &popped]() {
+        std::shared_ptr<int> value;
+        popped = queue.waitAndPop(value);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.destruct();
+    consumer.join();
+    REQUIRE_FALSE(popped);
+    REQUIRE_FALSE(queue.push(std::make_shared<int>(1)));
+}
+
+TEST_CASE("Consumers only ever see increasing elements") {
+    dai::ConflatingQueue<int> queue;
+    constexpr int numElements = 100000;
+    std::atomic<bool> ordered{true};
+    std::atomic<int> numPopped{0};
+
+    std::thread consumer([&]() {
+        int last = -1;
+        std::shared_ptr<int> value;
+        while(queue.waitAndPop(value)) {
+            if(*value <= last) ordered = false;
+            last = *value;
+            numPopped++;
+            if(last == numElements - 1) break;
+        }
+    });
+    for(int i = 0; i < numElements; i++) queue.push(std::make_shared<int>(i));
+    consumer.join();
+
+    REQUIRE(ordered);
+    // Every element was either consumed or overwritten
+    REQUIRE(numPopped + queue.getNumOverwritten() == numElements);
+}
+
+TEST_CASE("Peeking never makes the queue appear empty") {
+    dai::ConflatingQueue<int> queue;
+    queue.push(std::make_shared<int>(0));
+
+    std::atomic<bool> running{true};
+    std::thread peeker([&]() {
+        std::shared_ptr<int> value;
+        while(running) queue.front(value);
+    });
+
+    // Nothing pops, so the slot is never empty
+    int numEmpty = 0;
+    for(int i = 0; i < 100000; i++) {
+        if(queue.empty()) numEmpty++;
+        std::shared_ptr<int> value;
+        if(!queue.front(value)) numEmpty++;
+    }
+    running = false;
+    peeker.join();
+    REQUIRE(numEmpty == 0);
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <vector>
+
+// Inludes common necessary includes for development using depthai library
+#include "depthai/depthai.hpp"
+#include "depthai/device/DeviceGroup.hpp"
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+constexpr auto NUM_MESSAGES = 50;
+constexpr auto TEST_TIMEOUT = 20s;
+
+int main() {
+    auto availableDevices = dai::Device::getAllAvailableDevices();
+    if(availableDevices.empty()) {
+        cout << "No devices available" << endl;
+        return 1;
+    }
+
+    // Create pipeline
+    dai::Pipeline pipeline;
+    auto camRgb = pipeline.create<dai::node::ColorCamera>();
+    auto xoutRgb = pipeline.create<dai::node::XLinkOut>();
+    xoutRgb->setStreamName("rgb");
+    camRgb->setPreviewSize(300, 300);
+    camRgb->setBoardSocket(dai::CameraBoardSocket::CAM_A);
+    camRgb->preview.link(xoutRgb->input);
+
+    dai::DeviceGroup group(availableDevices, pipeline);
+    cout << "Opened " << group.size() << " devices in " << duration_cast<milliseconds>(group.getStartupTime()).count() << "ms, firmware prepared in "
+         << duration_cast<milliseconds>(group.getFirmwarePreparationTime()).count() << "ms" << endl;
+    if(group.size() != availableDevices.size()) return 1;
+
+    const auto timings = group.getStartupTimings();
+    for(std::size_t i = 0; i < group.size(); i++) {
+        const auto& timing = timings[i];
+        cout << "Device " << availableDevices[i].getMxId() << " - firmware: " << duration_cast<milliseconds>(timing.firmware).count()
+             << "ms, boot: " << duration_cast<milliseconds>(timing.boot).count() << "ms, connect: " << duration_cast<milliseconds>(timing.connect).count()
+             << "ms, setup: " << duration_cast<milliseconds>(timing.setup).count() << "ms, pipeline: " << duration_cast<milliseconds>(timing.pipeline).count()
+             << "ms, total: " << duration_cast<milliseconds>(timing.total).count() << "ms" << endl;
+        if(timing.connect <= 0ns || timing.total < timing.boot + timing.connect + timing.pipeline) return 1;
+    }
+
+    // Each device runs its pipeline
+    vector<int> counters(group.size(), 0);
+    bool finished = false;
+    auto t1 = steady_clock::now();
+    do {
+        finished = true;
+        for(std::size_t i = 0; i < group.size(); i++) {
+            if(group.getDevice(i)->getOutputQueue("rgb")->tryGet<dai::ImgFrame>()) counters[i]++;
+            if(counters[i] < NUM_MESSAGES) finished = false;
+        }
+        std::this_thread::sleep_for(1ms);
+    } while(!finished && steady_clock::now() - t1 < TEST_TIMEOUT);
+
+    return finished ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/xlink/DeviceRegistry.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Devices "connected" for the fake scanner
+class FakeDevices {
+   public:
+    void set(std::vector<dai::DeviceInfo> newDevices) {
+        std::unique_lock<std::mutex> lock(mtx);
+        devices = std::move(newDevices);
+    }
+
+    dai::DeviceRegistry::Scanner scanner(std::chrono::milliseconds tcpScanTime = 0ms) {
+        return [this, tcpScanTime](XLinkProtocol_t protocol) {
+            if(protocol == X_LINK_TCP_IP) std::this_thread::sleep_for(tcpScanTime);
+            std::vector<dai::DeviceInfo> found;
+            std::unique_lock<std::mutex> lock(mtx);
+            for(const auto& device : devices) {
+                if(device.protocol == protocol) found.push_back(device);
+            }
+            return found;
+        };
+    }
+
+   private:
+    std::mutex mtx;
+    std::vector<dai::DeviceInfo> devices;
+};
+
+dai::DeviceInfo usbDevice(XLinkDeviceState_t state, std::string name = "1.1") {
+    return dai::DeviceInfo(std::move(name), "14442C10D13EABCE00", state, X_LINK_USB_VSC, X_LINK_MYRIAD_X, X_LINK_SUCCESS);
+}
+
+dai::DeviceInfo tcpDevice() {
+    return dai::DeviceInfo("192.168.1.10", "14442C10D13EABCE01", X_LINK_BOOTLOADER, X_LINK_TCP_IP, X_LINK_MYRIAD_X, X_LINK_SUCCESS);
+}
+
+}  // namespace
+
+TEST_CASE("Callbacks are called on device changes") {
+    FakeDevices devices;
+    dai::DeviceRegistry::Config config;
+    config.idleScanInterval = 10ms;
+    config.scanner = devices.scanner();
+    dai::DeviceRegistry registry(config);
+
+    std::mutex mtx;
+    std::vector<std::pair<dai::DeviceRegistry::Event, dai::DeviceInfo>> events;
+    registry.addCallback([&](dai::DeviceRegistry::Event event, const dai::DeviceInfo& device) {
+        std::unique_lock<std::mutex> lock(mtx);
+        events.emplace_back(event, device);
+    });
+    const auto waitForEvents = [&](std::size_t num) {
+        const auto start = std::chrono::steady_clock::now();
+        while(std::chrono::steady_clock::now() - start < 1s) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                if(events.size() >= num) return true;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    };
+
+    devices.set({usbDevice(X_LINK_UNBOOTED)});
+    REQUIRE(waitForEvents(1));
+    // Booting changes name and state, device is identified by its mxid
+    devices.set({usbDevice(X_LINK_BOOTED, "1.1.2")});
+    REQUIRE(waitForEvents(2));
+    devices.set({});
+    REQUIRE(waitForEvents(3));
+
+    std::unique_lock<std::mutex> lock(mtx);
+    REQUIRE(events.size() == 3);
+    REQUIRE(events[0].first == dai::DeviceRegistry::Event::ADDED);
+    REQUIRE(events[0].second.state == X_LINK_UNBOOTED);
+    REQUIRE(events[1].first == dai::DeviceRegistry::Event::STATE_CHANGED);
+    REQUIRE(events[1].second.state == X_LINK_BOOTED);
+    REQUIRE(events[1].second.name == "1.1.2");
+    REQUIRE(events[2].first == dai::DeviceRegistry::Event::REMOVED);
+    REQUIRE(registry.getDevices().empty());
+}
+
+TEST_CASE("Callbacks can remove themselves") {
+    FakeDevices devices;
+    dai::DeviceRegistry::Config config;
+    config.idleScanInterval = 10ms;
+    config.scanner = devices.scanner();
+    dai::DeviceRegistry registry(config);
+
+    std::mutex mtx;
+    dai::DeviceRegistry::CallbackId oneShotId = 0;
+    int numOneShotCalls = 0;
+    int numOtherCalls = 0;
+    {
+        // Hold the lock, so the id is set before the callback can run
+        std::unique_lock<std::mutex> lock(mtx);
+        oneShotId = registry.addCallback([&](dai::DeviceRegistry::Event, const dai::DeviceInfo&) {
+            std::unique_lock<std::mutex> lock(mtx);
+            numOneShotCalls++;
+            registry.removeCallback(oneShotId);
+        });
+    }
+    registry.addCallback([&](dai::DeviceRegistry::Event, const dai::DeviceInfo&) {
+        std::unique_lock<std::mutex> lock(mtx);
+        numOtherCalls++;
+    });
+    const auto waitForCalls = [&](int num) {
+        const auto start = std::chrono::steady_clock::now();
+        while(std::chrono::steady_clock::now() - start < 1s) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                if(numOtherCalls >= num) return true;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    };
+
+    devices.set({usbDevice(X_LINK_UNBOOTED)});
+    REQUIRE(waitForCalls(1));
+    devices.set({});
+    REQUIRE(waitForCalls(2));
+
+    std::unique_lock<std::mutex> lock(mtx);
+    REQUIRE(numOneShotCalls == 1);
+    REQUIRE_FALSE(registry.removeCallback(oneShotId));
+}
+
+TEST_CASE("Waiting returns once a device is found") {
+    FakeDevices devices;
+    dai::DeviceRegistry::Config config;
+    config.scanner = devices.scanner();
+    dai::DeviceRegistry registry(config);
+
+    dai::DeviceInfo pattern;
+    pattern.state = X_LINK_BOOTLOADER;
+
+    auto start = std::chrono::steady_clock::now();
+    bool found = false;
+    dai::DeviceInfo device;
+    std::tie(found, device) = registry.waitForDevice(pattern, 100ms);
+    REQUIRE_FALSE(found);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 100ms);
+
+    std::thread connect([&devices]() {
+        std::this_thread::sleep_for(50ms);
+        devices.set({usbDevice(X_LINK_UNBOOTED), tcpDevice()});
+    });
+    start = std::chrono::steady_clock::now();
+    std::tie(found, device) = registry.waitForDevice(pattern, 5s);
+    connect.join();
+    REQUIRE(found);
+    REQUIRE(device.name == "192.168.1.10");
+    REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+}
+
+TEST_CASE("Devices found before waiting are not returned") {
+    FakeDevices devices;
+    dai::DeviceRegistry::Config config;
+    config.scanner = devices.scanner();
+    dai::DeviceRegistry registry(config);
+
+    devices.set({usbDevice(X_LINK_UNBOOTED)});
+    bool found = false;
+    std::tie(found, std::ignore) = registry.waitForDevice(dai::DeviceInfo{}, 1s);
+    REQUIRE(found);
+
+    // Registry still lists the device, but a fresh scan doesn't find it
+    devices.set({});
+    REQUIRE(registry.getDevices().size() == 1);
+    std::tie(found, std::ignore) = registry.waitForDevice(dai::DeviceInfo{}, 0ms);
+    REQUIRE_FALSE(found);
+}
+
+TEST_CASE("Slow protocols don't delay others") {
+    FakeDevices devices;
+    devices.set({usbDevice(X_LINK_UNBOOTED)});
+    dai::DeviceRegistry::Config config;
+    config.scanner = devices.scanner(500ms);
+    dai::DeviceRegistry registry(config);
+
+    const auto start = std::chrono::steady_clock::now();
+    bool found = false;
+    dai::DeviceInfo device;
+    std::tie(found, device) = registry.waitForDevice(dai::DeviceInfo{}, 1s);
+    REQUIRE(found);
+    REQUIRE(device.protocol == X_LINK_USB_VSC);
+    REQUIRE(std::chrono::steady_clock::now() - start < 250ms);
+}
+
+TEST_CASE("Name is used as hint only if requested") {
+    FakeDevices devices;
+    devices.set({usbDevice(X_LINK_BOOTED, "1.1.2")});
+    dai::DeviceRegistry::Config config;
+    config.scanner = devices.scanner();
+    dai::DeviceRegistry registry(config);
+
+    auto pattern = usbDevice(X_LINK_BOOTED);
+    bool found = false;
+    dai::DeviceInfo device;
+    std::tie(found, device) = registry.waitForDevice(pattern, 50ms);
+    REQUIRE_FALSE(found);
+    std::tie(found, device) = registry.waitForDevice(pattern, 50ms, true);
+    REQUIRE(found);
+    REQUIRE(device.name == "1.1.2");
+
+    REQUIRE(dai::DeviceRegistry::matches(device, dai::DeviceInfo{}));
+    pattern.state = X_LINK_UNBOOTED;
+    REQUIRE_FALSE(dai::DeviceRegistry::matches(device, pattern, false));
+}
@@ -0,0 +1,406 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/pipeline/datatype/IMUData.hpp>
+#include <depthai/pipeline/datatype/ImgFrame.hpp>
+#include <depthai/pipeline/datatype/MessageGroup.hpp>
+#include <depthai/pipeline/datatype/NNData.hpp>
+
+#include "simulator/DeviceSimulator.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Echo passes messages back") {
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    auto out = simulator.getOutputQueue("out");
+
+    dai::ImgFrame frame;
+    frame.setType(dai::ImgFrame::Type::BGR888p);
+    frame.setWidth(300);
+    frame.setHeight(200);
+    frame.setData(std::vector<std::uint8_t>(300 * 200 * 3, 7));
+    for(int i = 0; i < 10; i++) {
+        frame.setSequenceNum(i);
+        in->send(frame);
+    }
+
+    for(int i = 0; i < 10; i++) {
+        bool timedOut = false;
+        auto received = out->get<dai::ImgFrame>(1s, timedOut);
+        REQUIRE_FALSE(timedOut);
+        REQUIRE(received->getSequenceNum() == i);
+        REQUIRE(received->getWidth() == 300);
+        REQUIRE(received->getData().size() == 300 * 200 * 3);
+        REQUIRE(received->getData()[0] == 7);
+    }
+}
+
+TEST_CASE("Input queue keeps order through its pipeline and reports throughput") {
+    for(unsigned depth : {1u, 2u, 4u}) {
+        dai::DeviceSimulator simulator;
+        simulator.addEcho("in", "out");
+        auto in = simulator.getInputQueue("in", 4, true);
+        auto out = simulator.getOutputQueue("out");
+        in->setPipelineDepth(depth);
+
+        constexpr int numMessages = 200;
+        constexpr std::size_t size = 10000;
+        std::atomic<int> numInOrder{0};
+        std::thread reader([&]() {
+            for(int i = 0; i < numMessages; i++) {
+                bool timedOut = false;
+                auto received = out->get<dai::Buffer>(1s, timedOut);
+                if(timedOut || received->getSequenceNum() != i) return;
+                numInOrder++;
+            }
+        });
+        for(int i = 0; i < numMessages; i++) {
+            dai::Buffer buffer;
+            buffer.setSequenceNum(i);
+            buffer.setData(std::vector<std::uint8_t>(size, static_cast<std::uint8_t>(i)));
+            in->send(buffer);
+        }
+        reader.join();
+        REQUIRE(numInOrder == numMessages);
+
+        // Counters are updated after the write returns
+        auto stats = in->getStats();
+        for(int i = 0; i < 100 && stats.numSent < numMessages; i++) {
+            std::this_thread::sleep_for(10ms);
+            stats = in->getStats();
+        }
+        REQUIRE(stats.numSent == numMessages);
+        REQUIRE(stats.bytesSent > numMessages * size);
+        REQUIRE(stats.queue.numPushed == numMessages);
+        REQUIRE(stats.queue.numPopped == numMessages);
+        REQUIRE(stats.queue.numDropped == 0);
+        REQUIRE(stats.queue.maxQueued <= 4);
+        REQUIRE(stats.serializeTime.count == numMessages);
+        REQUIRE(stats.writeTime.count == numMessages);
+        REQUIRE(stats.messagesPerSecond > 0);
+        REQUIRE(stats.megabytesPerSecond > 0);
+        REQUIRE(stats.writeMegabytesPerSecond > 0);
+    }
+}
+
+static void echoMessageGroups(bool lazyMetadata) {
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    // Reading thread blocks on the full queue, so the stream fills up and groups are read in one batch with their members
+    auto out = simulator.getOutputQueue("out", 1, true);
+    out->setLazyMetadata(lazyMetadata);
+
+    constexpr int numGroups = 10;
+    for(int i = 0; i < numGroups; i++) {
+        dai::Buffer buffer;
+        buffer.setSequenceNum(i);
+        buffer.setData(std::vector<std::uint8_t>(100, static_cast<std::uint8_t>(i)));
+        dai::ImgFrame frame;
+        frame.setSequenceNum(i);
+        frame.setWidth(4);
+        frame.setHeight(2);
+        frame.setData(std::vector<std::uint8_t>(8, static_cast<std::uint8_t>(i)));
+        dai::MessageGroup group;
+        group.setSequenceNum(i);
+        group.add("buffer", buffer);
+        group.add("frame", frame);
+        in->send(group);
+
+        // A plain message follows each group
+        dai::Buffer after;
+        after.setSequenceNum(1000 + i);
+        in->send(after);
+    }
+    std::this_thread::sleep_for(200ms);
+
+    for(int i = 0; i < numGroups; i++) {
+        bool timedOut = false;
+        auto group = out->get<dai::MessageGroup>(1s, timedOut);
+        REQUIRE_FALSE(timedOut);
+        REQUIRE(group != nullptr);
+        REQUIRE(group->getSequenceNum() == i);
+        REQUIRE(group->getNumMessages() == 2);
+        auto buffer = group->get<dai::Buffer>("buffer");
+        REQUIRE(buffer != nullptr);
+        REQUIRE(buffer->getSequenceNum() == i);
+        REQUIRE(buffer->getData() == std::vector<std::uint8_t>(100, static_cast<std::uint8_t>(i)));
+        auto frame = group->get<dai::ImgFrame>("frame");
+        REQUIRE(frame != nullptr);
+        REQUIRE(frame->getSequenceNum() == i);
+        REQUIRE(frame->getWidth() == 4);
+
+        auto after = out->get<dai::Buffer>(1s, timedOut);
+        REQUIRE_FALSE(timedOut);
+        REQUIRE(after != nullptr);
+        REQUIRE(after->getSequenceNum() == 1000 + i);
+    }
+}
+
+TEST_CASE("Echo passes message groups back") {
+    echoMessageGroups(false);
+}
+
+TEST_CASE("Echo passes message groups back, with lazy metadata") {
+    echoMessageGroups(true);
+}
+
+TEST_CASE("Backend is switched while the reading thread waits on a full queue") {
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    auto out = simulator.getOutputQueue("out", 2, true);
+
+    constexpr int numMessages = 20;
+    for(int i = 0; i < numMessages; i++) {
+        dai::Buffer buffer;
+        buffer.setSequenceNum(i);
+        in->send(buffer);
+    }
+    // Let the reading thread block on the full queue
+    std::this_thread::sleep_for(100ms);
+
+    const dai::DataOutputQueue::QueueBackend backends[] = {
+        dai::DataOutputQueue::QueueBackend::RING, dai::DataOutputQueue::QueueBackend::LOCKING, dai::DataOutputQueue::QueueBackend::RING};
+    for(int i = 0; i < numMessages; i++) {
+        if(i % 5 == 0) out->setQueueBackend(backends[(i / 5) % 3]);
+        bool timedOut = false;
+        auto received = out->get<dai::Buffer>(1s, timedOut);
+        REQUIRE_FALSE(timedOut);
+        REQUIRE(received->getSequenceNum() == i);
+    }
+}
+
+TEST_CASE("Backend is switched into a smaller blocking queue while the reading thread pushes") {
+    using Backend = dai::DataOutputQueue::QueueBackend;
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    auto out = simulator.getOutputQueue("out", 8, true);
+    out->setQueueBackend(Backend::RING);
+    // Holds fewer messages than the full ring
+    out->setMaxBytes(2500);
+
+    constexpr int numMessages = 40;
+    for(int i = 0; i < numMessages; i++) {
+        dai::Buffer buffer;
+        buffer.setSequenceNum(i);
+        buffer.setData(std::vector<std::uint8_t>(1000));
+        in->send(buffer);
+    }
+    // Let the reading thread block on the full ring
+    std::this_thread::sleep_for(100ms);
+
+    // Switching from the consumer thread must not wait for a consumer
+    const auto t1 = std::chrono::steady_clock::now();
+    for(auto backend : {Backend::LOCKING, Backend::RING, Backend::LOCKING, Backend::RING, Backend::LOCKING}) {
+        out->setQueueBackend(backend);
+    }
+    REQUIRE(std::chrono::steady_clock::now() - t1 < 1s);
+
+    // Messages which didn't fit are dropped, the rest keep their order
+    int numReceived = 0;
+    std::int64_t last = -1;
+    while(true) {
+        bool timedOut = false;
+        auto received = out->get<dai::Buffer>(500ms, timedOut);
+        if(timedOut) break;
+        REQUIRE(received->getSequenceNum() > last);
+        last = received->getSequenceNum();
+        numReceived++;
+        // Keep switching while the reading thread pushes the rest
+        if(numReceived % 3 == 0) out->setQueueBackend(numReceived % 2 == 0 ? Backend::RING : Backend::LOCKING);
+    }
+    const auto stats = out->getStats();
+    REQUIRE(stats.queue.numDropped > 0);
+    REQUIRE(numReceived + stats.queue.numDropped == numMessages);
+}
+
+TEST_CASE("Input queue keeps order while conflating is switched during sends") {
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    auto out = simulator.getOutputQueue("out", 1000, false);
+
+    constexpr int numMessages = 2000;
+    std::thread sender([&]() {
+        for(int i = 0; i < numMessages; i++) {
+            dai::Buffer buffer;
+            buffer.setSequenceNum(i);
+            in->send(buffer);
+        }
+    });
+    for(int i = 0; i < 100; i++) {
+        in->setConflating(i % 2 == 0);
+        std::this_thread::sleep_for(1ms);
+    }
+    sender.join();
+
+    // Conflating drops messages, but never reorders them or holds back the latest one
+    std::int64_t last = -1;
+    while(last != numMessages - 1) {
+        bool timedOut = false;
+        auto received = out->get<dai::Buffer>(1s, timedOut);
+        REQUIRE_FALSE(timedOut);
+        REQUIRE(received->getSequenceNum() > last);
+        last = received->getSequenceNum();
+    }
+}
+
+TEST_CASE("Generators produce messages at configured rate") {
+    dai::DeviceSimulator simulator;
+    dai::DeviceSimulator::GeneratorConfig config;
+    config.fps = 100;
+    config.width = 640;
+    config.height = 400;
+    simulator.addGenerator("frames", config);
+    config.type = dai::DeviceSimulator::MessageType::IMU_DATA;
+    config.numImuPackets = 5;
+    simulator.addGenerator("imu", config);
+    config.type = dai::DeviceSimulator::MessageType::NN_DATA;
+    config.layerSize = 256;
+    simulator.addGenerator("nn", config);
+
+    auto frames = simulator.getOutputQueue("frames", 4, false);
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < 20; i++) {
+        auto frame = frames->get<dai::ImgFrame>();
+        REQUIRE(frame->getWidth() == 640);
+        REQUIRE(frame->getData().size() == 640 * 400 * 3 / 2);
+    }
+    // 20 frames at 100 fps take about 200 ms
+    REQUIRE(std::chrono::steady_clock::now() - start >= 150ms);
+
+    auto imu = simulator.getOutputQueue("imu")->get<dai::IMUData>();
+    REQUIRE(imu->packets.size() == 5);
+    auto nn = simulator.getOutputQueue("nn")->get<dai::NNData>();
+    REQUIRE(nn->getLayerUInt8("output").size() == 256);
+}
+
+TEST_CASE("Closing the simulator closes its queues") {
+    dai::DeviceSimulator simulator;
+    simulator.addGenerator("frames", {});
+    simulator.addEcho("in", "out");
+    auto frames = simulator.getOutputQueue("frames");
+    auto in = simulator.getInputQueue("in");
+    frames->get<dai::ImgFrame>();
+
+    const auto start = std::chrono::steady_clock::now();
+    simulator.close();
+    REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+    REQUIRE(frames->isClosed());
+    REQUIRE(in->isClosed());
+    REQUIRE_THROWS(frames->get<dai::ImgFrame>());
+    REQUIRE_THROWS(simulator.addGenerator("other", {}));
+}
+
+TEST_CASE("Streams are profiled") {
+    const bool wasEnabled = dai::StreamProfiler::isEnabled();
+    dai::StreamProfiler::setEnabled(true);
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    auto out = simulator.getOutputQueue("out");
+
+    dai::Buffer buffer;
+    buffer.setData(std::vector<std::uint8_t>(1000));
+    for(int i = 0; i < 5; i++) in->send(buffer);
+    for(int i = 0; i < 5; i++) out->get<dai::Buffer>();
+
+    const auto written = in->getProfilingData();
+    REQUIRE(written.numPacketsWritten == 5);
+    REQUIRE(written.numBytesWritten > 5 * 1000);
+    REQUIRE(written.writeTime.count == 5);
+    REQUIRE(written.numPacketsRead == 0);
+
+    const auto read = out->getProfilingData();
+    REQUIRE(read.numPacketsRead == 5);
+    REQUIRE(read.numBytesRead == written.numBytesWritten);
+    REQUIRE(read.readTime.count == 5);
+    REQUIRE(read.latency.count == 5);
+    REQUIRE(read.readBlockedTime == read.readTime.total);
+    dai::StreamProfiler::setEnabled(wasEnabled);
+}
+
+TEST_CASE("Streams aren't profiled unless enabled") {
+    const bool wasEnabled = dai::StreamProfiler::isEnabled();
+    dai::StreamProfiler::setEnabled(false);
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    auto out = simulator.getOutputQueue("out");
+
+    dai::Buffer buffer;
+    buffer.setData(std::vector<std::uint8_t>(1000));
+    in->send(buffer);
+    out->get<dai::Buffer>();
+
+    REQUIRE(in->getProfilingData().numPacketsWritten == 0);
+    REQUIRE(out->getProfilingData().numPacketsRead == 0);
+    REQUIRE(out->getProfilingData().readBlockedTime.count() == 0);
+    dai::StreamProfiler::setEnabled(wasEnabled);
+}
+
+TEST_CASE("Unknown and duplicate streams throw") {
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    REQUIRE_THROWS(simulator.getOutputQueue("in"));
+    REQUIRE_THROWS(simulator.getInputQueue("out"));
+    REQUIRE_THROWS(simulator.addGenerator("out", {}));
+    REQUIRE_THROWS(simulator.addEcho("a", "a"));
+}
+
+TEST_CASE("Host side throughput of simulated streams", "[.][benchmark]") {
+    dai::DeviceSimulator::GeneratorConfig config;
+    config.fps = 0;
+
+    BENCHMARK("100 1080p NV12 frames") {
+        dai::DeviceSimulator simulator;
+        simulator.addGenerator("frames", config);
+        auto frames = simulator.getOutputQueue("frames");
+        for(int i = 0; i < 100; i++) frames->get<dai::ImgFrame>();
+    };
+
+    BENCHMARK("100 1080p NV12 frames, zero copy") {
+        dai::DeviceSimulator simulator;
+        simulator.addGenerator("frames", config);
+        auto frames = simulator.getOutputQueue("frames");
+        frames->setZeroCopy(true);
+        for(int i = 0; i < 100; i++) frames->get<dai::ImgFrame>();
+    };
+
+    BENCHMARK("1000 IMUData messages") {
+        dai::DeviceSimulator::GeneratorConfig imuConfig = config;
+        imuConfig.type = dai::DeviceSimulator::MessageType::IMU_DATA;
+        dai::DeviceSimulator simulator;
+        simulator.addGenerator("imu", imuConfig);
+        auto imu = simulator.getOutputQueue("imu");
+        for(int i = 0; i < 1000; i++) imu->get<dai::IMUData>();
+    };
+
+    BENCHMARK("100 1080p NV12 frames echoed") {
+        dai::DeviceSimulator simulator;
+        simulator.addEcho("in", "out");
+        auto in = simulator.getInputQueue("in");
+        // Messages are taken by the callback, queue only keeps the latest
+        auto out = simulator.getOutputQueue("out", 1, false);
+        dai::ImgFrame frame;
+        frame.setType(dai::ImgFrame::Type::NV12);
+        frame.setWidth(1920);
+        frame.setHeight(1080);
+        frame.setData(std::vector<std::uint8_t>(1920 * 1080 * 3 / 2));
+        std::atomic<int> numReceived{0};
+        out->addCallback([&numReceived](std::shared_ptr<dai::ADatatype>) { numReceived++; });
+        for(int i = 0; i < 100; i++) in->send(frame);
+        while(numReceived < 100) std::this_thread::yield();
+    };
+}
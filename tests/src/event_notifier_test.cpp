@@ -0,0 +1,28 @@
+#include <catch2/catch_all.hpp>
+
+// Include depthai library
+#include <depthai/utility/EventNotifier.hpp>
+
+#if !defined(_WIN32)
+    #include <poll.h>
+
+static bool isReadable(int fd) {
+    pollfd pfd{fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN) != 0;
+}
+
+TEST_CASE("File descriptor is readable only while notified") {
+    dai::EventNotifier notifier;
+    REQUIRE_FALSE(isReadable(notifier.getFd()));
+
+    notifier.notify();
+    notifier.notify();
+    REQUIRE(isReadable(notifier.getFd()));
+
+    notifier.clear();
+    REQUIRE_FALSE(isReadable(notifier.getFd()));
+
+    notifier.notify();
+    REQUIRE(isReadable(notifier.getFd()));
+}
+#endif
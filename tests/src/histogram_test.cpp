@@ -0,0 +1,52 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/utility/Histogram.hpp>
+
+using namespace std::chrono;
+
+TEST_CASE("Buckets cover consecutive ranges") {
+    for(std::size_t i = 0; i + 1 < dai::Histogram::NUM_BUCKETS; i++) {
+        REQUIRE(dai::Histogram::bucketUpperBound(i) + 1 == dai::Histogram::bucketLowerBound(i + 1));
+        REQUIRE(dai::Histogram::bucketIndex(dai::Histogram::bucketLowerBound(i)) == i);
+        REQUIRE(dai::Histogram::bucketIndex(dai::Histogram::bucketUpperBound(i)) == i);
+    }
+    REQUIRE(dai::Histogram::bucketIndex(UINT64_MAX) == dai::Histogram::NUM_BUCKETS - 1);
+}
+
+TEST_CASE("Snapshot summarizes recorded durations") {
+    dai::Histogram histogram;
+    for(int i = 1; i <= 100; i++) histogram.record(microseconds(i));
+
+    const auto snapshot = histogram.getSnapshot();
+    REQUIRE(snapshot.count == 100);
+    REQUIRE(snapshot.min == microseconds(1));
+    REQUIRE(snapshot.max == microseconds(100));
+    REQUIRE(snapshot.mean() == nanoseconds(50500));
+    // Within bucket resolution
+    REQUIRE(snapshot.percentile(50) >= microseconds(50));
+    REQUIRE(snapshot.percentile(50) <= microseconds(63));
+    REQUIRE(snapshot.percentile(100) == microseconds(100));
+}
+
+TEST_CASE("Concurrent recording counts every duration") {
+    dai::Histogram histogram;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++) {
+        threads.emplace_back([&histogram]() {
+            for(int i = 0; i < 10000; i++) histogram.record(nanoseconds(i));
+        });
+    }
+    for(auto& thread : threads) thread.join();
+
+    const auto snapshot = histogram.getSnapshot();
+    REQUIRE(snapshot.count == 40000);
+    std::uint64_t sum = 0;
+    for(auto bucket : snapshot.buckets) sum += bucket;
+    REQUIRE(sum == 40000);
+}
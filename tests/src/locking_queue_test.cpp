@@ -0,0 +1,172 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/utility/LockingQueue.hpp>
+
+TEST_CASE("Non blocking queue overwrites oldest elements over byte limit") {
+    dai::LockingQueue<std::vector<char>> queue(100, false);
+    queue.setSizeFunction([](const std::vector<char>& el) { return el.size(); });
+    queue.setMaxBytes(250);
+
+    for(int i = 0; i < 5; i++) REQUIRE(queue.push(std::vector<char>(100, static_cast<char>(i))));
+    REQUIRE(queue.getBytes() == 200);
+
+    std::vector<char> firstBytes;
+    queue.consumeAll([&firstBytes](std::vector<char>& el) { firstBytes.push_back(el[0]); });
+    REQUIRE(firstBytes == std::vector<char>{3, 4});
+    REQUIRE(queue.getBytes() == 0);
+}
+
+TEST_CASE("Element larger than byte limit is accepted into empty queue") {
+    dai::LockingQueue<std::vector<char>> queue(100, true);
+    queue.setSizeFunction([](const std::vector<char>& el) { return el.size(); });
+    queue.setMaxBytes(10);
+
+    REQUIRE(queue.push(std::vector<char>(100)));
+    REQUIRE_FALSE(queue.tryWaitAndPush(std::vector<char>(1), std::chrono::milliseconds(10)));
+
+    std::vector<char> el;
+    REQUIRE(queue.tryPop(el));
+    REQUIRE(queue.tryWaitAndPush(std::vector<char>(1), std::chrono::milliseconds(10)));
+}
+
+TEST_CASE("Shared memory budget caps multiple queues") {
+    auto budget = std::make_shared<dai::MemoryBudget>(300);
+    dai::LockingQueue<std::vector<char>> queue1(100, false), queue2(100, true);
+    for(auto* queue : {&queue1, &queue2}) {
+        queue->setSizeFunction([](const std::vector<char>& el) { return el.size(); });
+        queue->setMemoryBudget(budget);
+    }
+
+    for(int i = 0; i < 3; i++) REQUIRE(queue1.push(std::vector<char>(100)));
+    REQUIRE(budget->getUsedBytes() == 300);
+
+    // Empty queue always accepts an element
+    REQUIRE(queue2.push(std::vector<char>(100)));
+    REQUIRE(budget->getUsedBytes() == 400);
+
+    // Blocking queue waits for budget freed by another queue
+    std::atomic<bool> pushed{false};
+    std::thread producer([&]() { pushed = queue2.push(std::vector<char>(100)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(pushed);
+    queue1.consumeAll([](std::vector<char>&) {});
+    producer.join();
+    REQUIRE(pushed);
+    REQUIRE(budget->getUsedBytes() == 200);
+
+    // Non blocking queue only drops its own elements
+    REQUIRE(queue1.push(std::vector<char>(100)));
+    REQUIRE(queue1.push(std::vector<char>(100)));
+    REQUIRE(queue1.push(std::vector<char>(100)));
+    REQUIRE(queue1.getBytes() == 100);
+    REQUIRE(budget->getUsedBytes() == 300);
+}
+
+TEST_CASE("Push waiting for memory budget is woken up") {
+    auto budget = std::make_shared<dai::MemoryBudget>(100);
+    dai::LockingQueue<std::vector<char>> other(100, true), queue(100, true);
+    for(auto* q : {&other, &queue}) {
+        q->setSizeFunction([](const std::vector<char>& el) { return el.size(); });
+        q->setMemoryBudget(budget);
+    }
+    REQUIRE(other.push(std::vector<char>(100)));
+    REQUIRE(queue.push(std::vector<char>(10)));
+
+    // By a raised limit
+    std::atomic<bool> pushed{false};
+    std::thread producer([&]() { pushed = queue.push(std::vector<char>(10)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(pushed);
+    budget->setMaxBytes(200);
+    producer.join();
+    REQUIRE(pushed);
+
+    // By destruction of the queue
+    budget->setMaxBytes(100);
+    producer = std::thread([&]() { pushed = queue.push(std::vector<char>(10)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.destruct();
+    producer.join();
+    REQUIRE_FALSE(pushed);
+}
+
+TEST_CASE("Destroyed queue releases its memory budget") {
+    auto budget = std::make_shared<dai::MemoryBudget>();
+    {
+        dai::LockingQueue<std::vector<char>> queue(100, true);
+        queue.setSizeFunction([](const std::vector<char>& el) { return el.size(); });
+        queue.setMemoryBudget(budget);
+        queue.push(std::vector<char>(10));
+        queue.push(std::vector<char>(20));
+        REQUIRE(budget->getUsedBytes() == 30);
+    }
+    REQUIRE(budget->getUsedBytes() == 0);
+}
+
+TEST_CASE("Queue statistics count drops and high-water mark") {
+    dai::LockingQueue<std::vector<char>> queue(3, false);
+    queue.setSizeFunction([](const std::vector<char>& el) { return el.size(); });
+
+    for(int i = 0; i < 5; i++) queue.push(std::vector<char>(10));
+    std::vector<char> el;
+    REQUIRE(queue.tryPop(el));
+
+    const auto stats = queue.getStats();
+    REQUIRE(stats.numPushed == 5);
+    REQUIRE(stats.numDropped == 2);
+    REQUIRE(stats.bytesDropped == 20);
+    REQUIRE(stats.numPopped == 1);
+    REQUIRE(stats.maxQueued == 3);
+    REQUIRE(stats.maxQueuedBytes == 30);
+    REQUIRE(stats.dwellTime.count == 1);
+}
+
+namespace {
+// Frames as a string: keyframes are upper case, frames depending on the ones before them lower case
+std::string pushFrames(dai::LockingQueue<char>& queue, const std::string& frames) {
+    for(char frame : frames) queue.push(frame);
+    std::string queued;
+    queue.consumeAll([&queued](char& frame) { queued.push_back(frame); });
+    return queued;
+}
+}  // namespace
+
+TEST_CASE("Dependent runs are dropped instead of keyframes") {
+    dai::LockingQueue<char> queue(4, false);
+    queue.setDependencyFunction([](const char& frame) { return std::islower(frame) != 0; });
+
+    // Oldest run of dependent frames goes first, keyframes stay
+    REQUIRE(pushFrames(queue, "AbcDe") == "ADe");
+    REQUIRE(pushFrames(queue, "AbCdEf") == "ACEf");
+
+    // Once a run up to the newest frame was dropped, following dependent frames are dropped until a keyframe
+    REQUIRE(pushFrames(queue, "AbcdefGh") == "AGh");
+
+    // Without dependent frames queued, keyframes stay and the incoming frame is dropped instead
+    REQUIRE(pushFrames(queue, "ABCDE") == "ABCD");
+    REQUIRE(pushFrames(queue, "ABCDe") == "ABCD");
+
+    // Frames depending on a dropped keyframe are dropped as well, even once there is room for them
+    for(char frame : std::string("ABCDE")) queue.push(frame);
+    char popped = 0;
+    REQUIRE(queue.tryPop(popped));
+    REQUIRE(pushFrames(queue, "fG") == "BCDG");
+
+    auto stats = queue.getStats();
+    REQUIRE(stats.numPushed == 36);
+    REQUIRE(stats.numDropped == 13);
+
+    // Oldest element is dropped without a dependency function
+    queue.setDependencyFunction(nullptr);
+    REQUIRE(pushFrames(queue, "AbcDe") == "bcDe");
+}
@@ -0,0 +1,51 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Include depthai library
+#include <depthai/utility/MappedFile.hpp>
+
+namespace {
+
+std::string writeFile(const std::string& name, const std::vector<std::uint8_t>& contents) {
+    std::ofstream file(name, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    return name;
+}
+
+}  // namespace
+
+TEST_CASE("MappedFile exposes file contents") {
+    std::vector<std::uint8_t> contents(100000);
+    for(std::size_t i = 0; i < contents.size(); i++) contents[i] = static_cast<std::uint8_t>(i * 7);
+    const auto path = writeFile("mapped_file_test.bin", contents);
+
+    {
+        dai::MappedFile file(path);
+        auto data = file.getData();
+        REQUIRE(data.size() == contents.size());
+        REQUIRE(std::vector<std::uint8_t>(data.begin(), data.end()) == contents);
+
+        // Writes stay private to the mapping
+        data[0] = static_cast<std::uint8_t>(contents[0] + 1);
+    }
+    dai::MappedFile file(path);
+    REQUIRE(file.getData()[0] == contents[0]);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("MappedFile handles empty files") {
+    const auto path = writeFile("mapped_file_test_empty.bin", {});
+    dai::MappedFile file(path);
+    REQUIRE(file.getData().size() == 0);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("MappedFile throws on missing file") {
+    REQUIRE_THROWS(dai::MappedFile("mapped_file_test_missing.bin"));
+}
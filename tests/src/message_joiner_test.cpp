@@ -0,0 +1,210 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/device/MessageJoiner.hpp>
+#include <depthai/pipeline/datatype/Buffer.hpp>
+
+using namespace std::chrono_literals;
+
+static std::shared_ptr<dai::Buffer> message(std::chrono::microseconds ts) {
+    auto msg = std::make_shared<dai::Buffer>();
+    msg->setTimestampDevice(std::chrono::steady_clock::time_point(ts));
+    msg->setTimestamp(std::chrono::steady_clock::time_point(ts));
+    return msg;
+}
+
+static std::chrono::microseconds timestampOf(const std::shared_ptr<dai::MessageGroup>& group, const std::string& name) {
+    auto ts = group->get<dai::Buffer>(name)->getTimestampDevice().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(ts);
+}
+
+TEST_CASE("Messages within threshold are joined") {
+    dai::MessageJoiner::Config config;
+    config.threshold = 2ms;
+    dai::MessageJoiner joiner({"a", "b"}, config);
+
+    joiner.push("a", message(10000us));
+    REQUIRE(joiner.tryGet() == nullptr);
+    joiner.push("b", message(11000us));
+
+    auto group = joiner.tryGet();
+    REQUIRE(group != nullptr);
+    REQUIRE(group->getNumMessages() == 2);
+    REQUIRE(timestampOf(group, "a") == 10000us);
+    REQUIRE(timestampOf(group, "b") == 11000us);
+    REQUIRE(group->isSynced(2000000));
+    REQUIRE(group->getSequenceNum() == 0);
+}
+
+TEST_CASE("Nearest messages are joined and unmatched ones dropped") {
+    dai::MessageJoiner::Config config;
+    config.threshold = 5ms;
+    dai::MessageJoiner joiner({"fast", "slow"}, config);
+
+    // 'fast' runs at twice the rate of 'slow'
+    for(int i = 0; i < 4; i++) joiner.push("fast", message(std::chrono::microseconds(i * 16667)));
+    joiner.push("slow", message(33000us));
+
+    auto group = joiner.tryGet();
+    REQUIRE(group != nullptr);
+    REQUIRE(timestampOf(group, "fast") == 33334us);
+    REQUIRE(joiner.tryGet() == nullptr);
+
+    // Messages older than a grouped one are dropped on arrival
+    joiner.push("slow", message(20000us));
+    auto stats = joiner.getStats();
+    REQUIRE(stats.numGroups == 1);
+    REQUIRE(stats.numDropped == 3);
+}
+
+TEST_CASE("Messages arriving out of order are joined") {
+    dai::MessageJoiner::Config config;
+    config.threshold = 1ms;
+    dai::MessageJoiner joiner({"a", "b"}, config);
+
+    joiner.push("a", message(20000us));
+    joiner.push("a", message(10000us));
+    joiner.push("b", message(10100us));
+    joiner.push("b", message(20100us));
+
+    auto first = joiner.tryGet();
+    auto second = joiner.tryGet();
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    REQUIRE(timestampOf(first, "a") == 10000us);
+    REQUIRE(timestampOf(second, "a") == 20000us);
+}
+
+TEST_CASE("Buffers are bounded") {
+    dai::MessageJoiner::Config config;
+    config.maxBufferSize = 3;
+    dai::MessageJoiner joiner({"a", "b"}, config);
+
+    for(int i = 0; i < 10; i++) joiner.push("a", message(std::chrono::microseconds(i * 1000)));
+    REQUIRE(joiner.getStats().numDropped == 7);
+}
+
+TEST_CASE("Timed out messages are dropped or emitted partially") {
+    dai::MessageJoiner::Config config;
+    config.threshold = 2ms;
+    config.timeout = 20ms;
+
+    SECTION("Drop") {
+        config.timeoutPolicy = dai::MessageJoiner::TimeoutPolicy::DROP;
+        dai::MessageJoiner joiner({"a", "b", "c"}, config);
+        joiner.push("a", message(10000us));
+        std::this_thread::sleep_for(30ms);
+        joiner.push("b", message(10500us));
+
+        REQUIRE(joiner.tryGet() == nullptr);
+        REQUIRE(joiner.getStats().numDropped == 1);
+    }
+
+    SECTION("Emit partial") {
+        config.timeoutPolicy = dai::MessageJoiner::TimeoutPolicy::EMIT_PARTIAL;
+        dai::MessageJoiner joiner({"a", "b", "c"}, config);
+        joiner.push("a", message(10000us));
+        std::this_thread::sleep_for(30ms);
+        joiner.push("b", message(10500us));
+
+        auto group = joiner.tryGet();
+        REQUIRE(group != nullptr);
+        REQUIRE(group->getNumMessages() == 2);
+        REQUIRE(joiner.getStats().numPartialGroups == 1);
+    }
+}
+
+TEST_CASE("Groups completed by different threads are emitted in sequence order") {
+    dai::MessageJoiner::Config config;
+    config.maxGroups = 1000;
+    dai::MessageJoiner joiner({"a", "b"}, config);
+
+    std::vector<std::int64_t> sequenceNums;
+    joiner.setCallback([&](std::shared_ptr<dai::MessageGroup> group) {
+        // Callbacks are never called concurrently, the vector needs no lock
+        sequenceNums.push_back(group->getSequenceNum());
+        std::this_thread::yield();
+    });
+
+    constexpr int numMessages = 1000;
+    const auto pushAll = [&](const std::string& stream) {
+        for(int i = 0; i < numMessages; i++) joiner.push(stream, message(std::chrono::microseconds(i * 33333)));
+    };
+    std::thread a(pushAll, "a");
+    std::thread b(pushAll, "b");
+    a.join();
+    b.join();
+
+    REQUIRE(sequenceNums.size() == joiner.getStats().numGroups);
+    REQUIRE(!sequenceNums.empty());
+    for(std::size_t i = 0; i < sequenceNums.size(); i++) {
+        REQUIRE(sequenceNums[i] == static_cast<std::int64_t>(i));
+        auto group = joiner.tryGet();
+        REQUIRE(group != nullptr);
+        REQUIRE(group->getSequenceNum() == static_cast<std::int64_t>(i));
+    }
+}
+
+TEST_CASE("Unknown stream throws") {
+    dai::MessageJoiner joiner({"a"});
+    REQUIRE_THROWS(joiner.push("b", message(0us)));
+    REQUIRE_THROWS(dai::MessageJoiner({"a", "a"}));
+}
+
+namespace {
+constexpr int NUM_STREAMS = 8;
+constexpr int FPS = 60;
+
+// Pushes a second of 60 fps messages of 8 streams, with timestamp jitter and interleaved arrival
+std::uint64_t joinSecond(dai::MessageJoiner& joiner, std::mt19937& rng, int second) {
+    std::uniform_int_distribution<int> jitter(-1000, 1000);
+    std::uniform_int_distribution<int> stream(0, NUM_STREAMS - 1);
+    std::vector<std::string> names = joiner.getStreams();
+    std::uint64_t numGroups = 0;
+    for(int frame = 0; frame < FPS; frame++) {
+        const auto base = std::chrono::microseconds((second * FPS + frame) * 1000000 / FPS);
+        const auto offset = stream(rng);
+        for(int i = 0; i < NUM_STREAMS; i++) {
+            const auto s = (i + offset) % NUM_STREAMS;
+            joiner.push(names[s], message(base + std::chrono::microseconds(jitter(rng))));
+        }
+        while(joiner.tryGet() != nullptr) numGroups++;
+    }
+    return numGroups;
+}
+}  // namespace
+
+TEST_CASE("All frames of 8 streams at 60 fps are joined") {
+    dai::MessageJoiner::Config config;
+    config.threshold = 3ms;
+    std::vector<std::string> names;
+    for(int i = 0; i < NUM_STREAMS; i++) names.push_back("stream" + std::to_string(i));
+    dai::MessageJoiner joiner(names, config);
+
+    std::mt19937 rng(42);
+    REQUIRE(joinSecond(joiner, rng, 0) == FPS);
+    REQUIRE(joiner.getStats().numDropped == 0);
+    REQUIRE(joiner.getStats().interval.max <= 3ms);
+}
+
+TEST_CASE("Message joining at 8 streams and 60 fps", "[.][benchmark]") {
+    dai::MessageJoiner::Config config;
+    config.threshold = 3ms;
+    std::vector<std::string> names;
+    for(int i = 0; i < NUM_STREAMS; i++) names.push_back("stream" + std::to_string(i));
+    dai::MessageJoiner joiner(names, config);
+    std::mt19937 rng(42);
+    int second = 0;
+
+    BENCHMARK("1 s of messages (480)") {
+        return joinSecond(joiner, rng, second++);
+    };
+}
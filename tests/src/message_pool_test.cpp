@@ -0,0 +1,85 @@
+#include <catch2/catch_all.hpp>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/pipeline/datatype/StreamMessageParser.hpp>
+#include <depthai/utility/MessagePool.hpp>
+
+TEST_CASE("Released objects are reused") {
+    auto pool = std::make_shared<dai::MessagePool>();
+
+    auto frame = pool->acquire<dai::RawImgFrame>();
+    frame->data.resize(1024);
+    frame->fb.width = 32;
+    const auto* ptr = frame.get();
+    frame = nullptr;
+
+    auto stats = pool->getStats(dai::DatatypeEnum::ImgFrame);
+    REQUIRE(stats.numReturned == 1);
+    REQUIRE(stats.numPooled == 1);
+    REQUIRE(stats.pooledDataCapacity >= 1024);
+
+    auto reused = pool->acquire<dai::RawImgFrame>();
+    REQUIRE(reused.get() == ptr);
+    REQUIRE(reused->data.empty());
+    REQUIRE(reused->data.capacity() >= 1024);
+    REQUIRE(reused->fb.width == 0);
+    REQUIRE(pool->getStats().numReused == 1);
+}
+
+TEST_CASE("Pool limits") {
+    dai::MessagePool::Config config;
+    config.maxPooledPerType = 1;
+    config.maxDataCapacity = 100;
+    auto pool = std::make_shared<dai::MessagePool>(config);
+
+    auto a = pool->acquire<dai::RawBuffer>();
+    auto b = pool->acquire<dai::RawBuffer>();
+    auto c = pool->acquire<dai::RawBuffer>();
+    c->data.resize(1000);
+    a = nullptr;
+    b = nullptr;
+    c = nullptr;
+
+    auto stats = pool->getStats(dai::DatatypeEnum::Buffer);
+    REQUIRE(stats.numPooled == 1);
+    REQUIRE(stats.numDiscarded == 2);
+
+    pool->clear();
+    REQUIRE(pool->getStats().numPooled == 0);
+}
+
+TEST_CASE("Objects outlive the pool") {
+    auto pool = std::make_shared<dai::MessagePool>();
+    auto buf = pool->acquire<dai::RawBuffer>();
+    pool = nullptr;
+    buf->data.resize(10);
+    buf = nullptr;
+}
+
+TEST_CASE("Parse message using pool") {
+    auto pool = std::make_shared<dai::MessagePool>();
+
+    dai::ImgFrame frm;
+    frm.setData(std::vector<std::uint8_t>(100, 7));
+    frm.setWidth(10);
+    auto ser = dai::StreamMessageParser::serializeMessage(frm);
+
+    for(int i = 0; i < 3; i++) {
+        streamPacketDesc_t packet;
+        packet.data = ser.data();
+        packet.length = ser.size();
+
+        dai::DatatypeEnum type;
+        auto msg = dai::StreamMessageParser::parseMessageToADatatype(&packet, type, pool);
+        REQUIRE(type == dai::DatatypeEnum::ImgFrame);
+        auto img = std::dynamic_pointer_cast<dai::ImgFrame>(msg);
+        REQUIRE(img != nullptr);
+        REQUIRE(img->getWidth() == 10);
+        REQUIRE(img->getData() == std::vector<std::uint8_t>(100, 7));
+    }
+
+    auto stats = pool->getStats(dai::DatatypeEnum::ImgFrame);
+    REQUIRE(stats.numAcquired == 3);
+    REQUIRE(stats.numReused == 2);
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include "depthai/device/Device.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/node/ColorCamera.hpp"
+#include "depthai/pipeline/node/MonoCamera.hpp"
+#include "depthai/pipeline/node/XLinkOut.hpp"
+
+using namespace std::chrono_literals;
+
+dai::Pipeline getPipeline() {
+    dai::Pipeline pipeline;
+    auto camNode = pipeline.create<dai::node::ColorCamera>();
+    auto monoNode = pipeline.create<dai::node::MonoCamera>();
+    auto xoutPreview = pipeline.create<dai::node::XLinkOut>();
+    auto xoutMono = pipeline.create<dai::node::XLinkOut>();
+    camNode->setPreviewSize(300, 300);
+    camNode->preview.link(xoutPreview->input);
+    monoNode->setCamera("left");
+    monoNode->out.link(xoutMono->input);
+    xoutPreview->setStreamName("preview");
+    xoutMono->setStreamName("mono");
+    return pipeline;
+}
+
+// Minimal coroutine which starts eagerly and signals completion
+struct Task {
+    struct promise_type {
+        Task get_return_object() {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+};
+
+TEST_CASE("getAsync future completes with next message") {
+    dai::Device device(getPipeline());
+    auto queue = device.getOutputQueue("preview", 4, false);
+
+    for(int i = 0; i < 10; i++) {
+        auto future = queue->getAsync();
+        REQUIRE(future.wait_for(10s) == std::future_status::ready);
+        REQUIRE(std::dynamic_pointer_cast<dai::ImgFrame>(future.get()) != nullptr);
+    }
+}
+
+TEST_CASE("getAnyAsync retrieves a single message") {
+    dai::Device device(getPipeline());
+    auto preview = device.getOutputQueue("preview", 4, false);
+    auto mono = device.getOutputQueue("mono", 4, false);
+
+    for(int i = 0; i < 10; i++) {
+        auto future = dai::DataOutputQueue::getAnyAsync({preview, mono});
+        REQUIRE(future.wait_for(10s) == std::future_status::ready);
+        auto result = future.get();
+        REQUIRE((result.first == "preview" || result.first == "mono"));
+        REQUIRE(result.second != nullptr);
+    }
+}
+
+TEST_CASE("getAnyAsync doesn't keep waiters completed by another queue") {
+    dai::Device device(getPipeline());
+    auto preview = device.getOutputQueue("preview", 4, false);
+    auto drained = device.getOutputQueue("mono", 4, false);
+    // Keep one queue drained, so only 'preview' completes the waits
+    drained->setMaxSize(0);
+
+    std::vector<std::weak_ptr<int>> tokens;
+    for(int i = 0; i < 10; i++) {
+        auto token = std::make_shared<int>(i);
+        tokens.push_back(token);
+        auto promise = std::make_shared<std::promise<std::string>>();
+        auto future = promise->get_future();
+        dai::DataOutputQueue::getAnyAsync({preview, drained}, [token, promise](std::string name, std::shared_ptr<dai::ADatatype>, std::exception_ptr) {
+            promise->set_value(std::move(name));
+        });
+        REQUIRE(future.wait_for(10s) == std::future_status::ready);
+        REQUIRE(future.get() == "preview");
+    }
+
+    // Waiters left on the drained queue are dropped as new ones are added, only the last one remains
+    tokens.pop_back();
+    for(const auto& token : tokens) REQUIRE(token.expired());
+}
+
+TEST_CASE("Pending getAsync fails once queue is closed") {
+    dai::Device device(getPipeline());
+    auto queue = device.getOutputQueue("preview", 4, false);
+
+    // Keep the queue drained, so the future stays pending until close
+    queue->setMaxSize(0);
+    auto future = queue->getAsync();
+    queue->close();
+    REQUIRE(future.wait_for(10s) == std::future_status::ready);
+    REQUIRE_THROWS(future.get());
+}
+
+// Shared with the coroutine, which may outlive the test if it times out (resumed with an error once queues close)
+struct ConsumerState {
+    std::atomic<int> numFrames{0};
+    std::atomic<bool> done{false};
+};
+
+// Parameters are copied into the coroutine frame, so it doesn't reference any locals of the test
+Task consume(std::shared_ptr<dai::DataOutputQueue> preview, std::shared_ptr<dai::DataOutputQueue> mono, std::shared_ptr<ConsumerState> state) {
+    try {
+        for(int i = 0; i < 10; i++) {
+            auto frame = std::dynamic_pointer_cast<dai::ImgFrame>(co_await preview->next());
+            if(frame != nullptr) state->numFrames++;
+        }
+        std::vector<std::shared_ptr<dai::DataOutputQueue>> queues{preview, mono};
+        auto [name, msg] = co_await dai::DataOutputQueue::nextAny(queues);
+        if(msg != nullptr) state->numFrames++;
+        state->done = true;
+    } catch(const std::exception&) {
+        // Queue closed before all messages arrived
+    }
+}
+
+TEST_CASE("Coroutine awaits messages") {
+    dai::Device device(getPipeline());
+    auto preview = device.getOutputQueue("preview", 4, false);
+    auto mono = device.getOutputQueue("mono", 4, false);
+
+    auto state = std::make_shared<ConsumerState>();
+    consume(preview, mono, state);
+
+    const auto start = std::chrono::steady_clock::now();
+    while(!state->done && std::chrono::steady_clock::now() - start < 10s) std::this_thread::sleep_for(10ms);
+    REQUIRE(state->done);
+    REQUIRE(state->numFrames == 11);
+}
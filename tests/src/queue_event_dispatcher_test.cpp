@@ -0,0 +1,227 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/device/QueueEventDispatcher.hpp>
+
+using namespace std::chrono_literals;
+using QueueId = dai::QueueEventDispatcher::QueueId;
+
+TEST_CASE("Events are returned in order they were pushed") {
+    dai::QueueEventDispatcher dispatcher(16);
+    auto a = dispatcher.addQueue("a");
+    auto b = dispatcher.addQueue("b");
+    auto c = dispatcher.addQueue("c");
+    REQUIRE(dispatcher.addQueue("b") == b);
+
+    dispatcher.push(a);
+    dispatcher.push(c);
+    dispatcher.push(b);
+    dispatcher.push(a);
+
+    // Events of other queues are kept
+    REQUIRE(dispatcher.wait({a, b}, 10, 0us) == std::vector<std::string>{"a", "b", "a"});
+    REQUIRE(dispatcher.getNumPending() == 1);
+    REQUIRE(dispatcher.wait({c}, 10, 0us) == std::vector<std::string>{"c"});
+    REQUIRE(dispatcher.wait({a, b, c}, 10, 0us).empty());
+}
+
+TEST_CASE("Number of events returned is limited") {
+    dai::QueueEventDispatcher dispatcher(16);
+    auto a = dispatcher.addQueue("a");
+    for(int i = 0; i < 5; i++) dispatcher.push(a);
+
+    REQUIRE(dispatcher.wait({a}, 2, 0us).size() == 2);
+    REQUIRE(dispatcher.wait({a}, 0, 0us).size() == 1);
+    REQUIRE(dispatcher.getNumPending() == 2);
+}
+
+TEST_CASE("Oldest events are discarded over the limit") {
+    dai::QueueEventDispatcher dispatcher(3);
+    auto a = dispatcher.addQueue("a");
+    auto b = dispatcher.addQueue("b");
+    dispatcher.push(a);
+    dispatcher.push(b);
+    dispatcher.push(b);
+    dispatcher.push(a);
+
+    REQUIRE(dispatcher.getNumPending() == 3);
+    REQUIRE(dispatcher.wait({a, b}, 10, 0us) == std::vector<std::string>{"b", "b", "a"});
+}
+
+TEST_CASE("Lookup and clear") {
+    dai::QueueEventDispatcher dispatcher(16);
+    auto a = dispatcher.addQueue("a");
+    dispatcher.push(a);
+
+    QueueId id = 100;
+    REQUIRE(dispatcher.findQueue("a", id));
+    REQUIRE(id == a);
+    REQUIRE_FALSE(dispatcher.findQueue("b", id));
+
+    dispatcher.clear();
+    REQUIRE_FALSE(dispatcher.findQueue("a", id));
+    REQUIRE(dispatcher.getNumPending() == 0);
+    // Stale ids are ignored
+    dispatcher.push(a);
+    REQUIRE(dispatcher.getNumPending() == 0);
+}
+
+TEST_CASE("Wait times out") {
+    dai::QueueEventDispatcher dispatcher(16);
+    auto a = dispatcher.addQueue("a");
+    auto b = dispatcher.addQueue("b");
+    dispatcher.push(b);
+
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(dispatcher.wait({a}, 1, 20ms).empty());
+    REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+}
+
+TEST_CASE("Waiters are woken by events of their queues") {
+    dai::QueueEventDispatcher dispatcher(16);
+    auto a = dispatcher.addQueue("a");
+    auto b = dispatcher.addQueue("b");
+
+    std::atomic<int> numA{0}, numB{0};
+    std::thread waiterA([&]() {
+        for(int i = 0; i < 3; i++) numA += static_cast<int>(dispatcher.wait({a}, 1, -1us).size());
+    });
+    std::thread waiterB([&]() {
+        for(int i = 0; i < 3; i++) numB += static_cast<int>(dispatcher.wait({b}, 1, -1us).size());
+    });
+
+    for(int i = 0; i < 3; i++) {
+        dispatcher.push(b);
+        dispatcher.push(a);
+    }
+    waiterA.join();
+    waiterB.join();
+
+    REQUIRE(numA == 3);
+    REQUIRE(numB == 3);
+    REQUIRE(dispatcher.getNumPending() == 0);
+}
+
+TEST_CASE("Events left over the limit are handed to other waiters") {
+    dai::QueueEventDispatcher dispatcher(16);
+    auto a = dispatcher.addQueue("a");
+
+    // Several waiters on the same queue, each taking a single event
+    constexpr int NUM_WAITERS = 4;
+    std::atomic<int> numEvents{0};
+    std::vector<std::thread> waiters;
+    for(int i = 0; i < NUM_WAITERS; i++) {
+        waiters.emplace_back([&]() { numEvents += static_cast<int>(dispatcher.wait({a}, 1, 5s).size()); });
+    }
+    std::this_thread::sleep_for(20ms);
+    for(int i = 0; i < NUM_WAITERS; i++) dispatcher.push(a);
+    for(auto& waiter : waiters) waiter.join();
+
+    REQUIRE(numEvents == NUM_WAITERS);
+}
+
+namespace {
+
+// Previous implementation: a single deque of names, scanned under one mutex, notifying all waiters
+class NameEventQueue {
+    std::vector<std::string> names;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::string> events;
+
+   public:
+    explicit NameEventQueue(std::vector<std::string> names) : names(std::move(names)) {}
+
+    void push(std::string name) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            events.push_back(std::move(name));
+        }
+        cv.notify_all();
+    }
+
+    std::vector<std::string> wait(const std::vector<std::string>& queueNames, std::size_t maxNumEvents, std::chrono::microseconds timeout) {
+        for(const auto& name : queueNames) {
+            if(std::find(names.begin(), names.end(), name) == names.end()) throw std::runtime_error("Queue doesn't exist");
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        std::vector<std::string> found;
+        cv.wait_for(lock, timeout, [&]() {
+            for(auto it = events.begin(); it != events.end() && found.size() < maxNumEvents;) {
+                if(std::find(queueNames.begin(), queueNames.end(), *it) != queueNames.end()) {
+                    found.push_back(*it);
+                    it = events.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            return !found.empty();
+        });
+        return found;
+    }
+};
+
+constexpr int NUM_WAITERS = 4;
+constexpr int NUM_EVENTS = 20000;
+
+// Waiters each handle a slice of the streams, one at a time, while a producer pushes events round robin
+template <typename Push, typename Wait>
+void dispatchEvents(int numStreams, Push push, Wait wait) {
+    std::atomic<int> numReceived{0};
+    std::vector<std::thread> waiters;
+    for(int w = 0; w < NUM_WAITERS; w++) {
+        waiters.emplace_back([&, w]() {
+            std::vector<int> streams;
+            for(int s = w; s < numStreams; s += NUM_WAITERS) streams.push_back(s);
+            if(streams.empty()) return;
+            while(numReceived < NUM_EVENTS) numReceived += static_cast<int>(wait(streams));
+        });
+    }
+    for(int i = 0; i < NUM_EVENTS; i++) push(i % numStreams);
+    for(auto& waiter : waiters) waiter.join();
+}
+
+}  // namespace
+
+TEST_CASE("Queue event dispatch scaling", "[.][benchmark]") {
+    for(int numStreams : {4, 16, 32, 64}) {
+        std::vector<std::string> names;
+        for(int s = 0; s < numStreams; s++) names.push_back("stream" + std::to_string(s));
+
+        BENCHMARK("Name deque, " + std::to_string(numStreams) + " streams") {
+            NameEventQueue events(names);
+            dispatchEvents(
+                numStreams,
+                [&](int s) { events.push(names[s]); },
+                [&](const std::vector<int>& streams) {
+                    std::vector<std::string> streamNames;
+                    for(auto s : streams) streamNames.push_back(names[s]);
+                    return events.wait(streamNames, 16, 1ms).size();
+                });
+        };
+
+        BENCHMARK("Dispatcher, " + std::to_string(numStreams) + " streams") {
+            dai::QueueEventDispatcher dispatcher(NUM_EVENTS);
+            std::vector<QueueId> ids;
+            for(const auto& name : names) ids.push_back(dispatcher.addQueue(name));
+            dispatchEvents(
+                numStreams,
+                [&](int s) { dispatcher.push(ids[s]); },
+                [&](const std::vector<int>& streams) {
+                    std::vector<QueueId> streamIds;
+                    for(auto s : streams) streamIds.push_back(ids[s]);
+                    return dispatcher.wait(streamIds, 16, 1ms).size();
+                });
+        };
+    }
+}
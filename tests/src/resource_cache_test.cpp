@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include "utility/Resources.hpp"
+
+namespace {
+
+const std::string CACHE_DIR = "resource_cache_test";
+
+std::vector<std::uint8_t> makeResource(std::size_t size, std::uint8_t seed) {
+    std::vector<std::uint8_t> resource(size);
+    for(std::size_t i = 0; i < size; i++) resource[i] = static_cast<std::uint8_t>(i * 31 + seed);
+    return resource;
+}
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(const std::string& path, const std::vector<char>& contents) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+}  // namespace
+
+TEST_CASE("Stored resources are loaded from cache") {
+    const auto resource = makeResource(100000, 1);
+    dai::Resources::storeCachedResource(CACHE_DIR, "stored.bin", resource);
+    // Storing again replaces the file
+    dai::Resources::storeCachedResource(CACHE_DIR, "stored.bin", resource);
+
+    std::vector<std::uint8_t> loaded;
+    REQUIRE(dai::Resources::loadCachedResource(CACHE_DIR + "/stored.bin", loaded));
+    REQUIRE(loaded == resource);
+
+    // Written completely to a temporary file, then renamed: header and resource
+    REQUIRE(readFile(CACHE_DIR + "/stored.bin").size() == 16 + resource.size());
+
+    std::remove((CACHE_DIR + "/stored.bin").c_str());
+}
+
+TEST_CASE("Missing, truncated and corrupted cached resources aren't loaded") {
+    std::vector<std::uint8_t> loaded;
+    REQUIRE_FALSE(dai::Resources::loadCachedResource(CACHE_DIR + "/missing.bin", loaded));
+
+    dai::Resources::storeCachedResource(CACHE_DIR, "damaged.bin", makeResource(1000, 2));
+    const auto path = CACHE_DIR + "/damaged.bin";
+    const auto contents = readFile(path);
+
+    auto truncated = contents;
+    truncated.resize(contents.size() - 1);
+    writeFile(path, truncated);
+    REQUIRE_FALSE(dai::Resources::loadCachedResource(path, loaded));
+
+    // Shorter than the header
+    truncated.resize(8);
+    writeFile(path, truncated);
+    REQUIRE_FALSE(dai::Resources::loadCachedResource(path, loaded));
+
+    auto corrupted = contents;
+    corrupted.back() ^= 1;
+    writeFile(path, corrupted);
+    REQUIRE_FALSE(dai::Resources::loadCachedResource(path, loaded));
+
+    writeFile(path, contents);
+    REQUIRE(dai::Resources::loadCachedResource(path, loaded));
+    REQUIRE(loaded == makeResource(1000, 2));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Archive is extracted unless all resources are cached") {
+    const std::vector<std::string> names = {"first.bin", "second.bin"};
+    dai::Resources::storeCachedResource(CACHE_DIR, names[0], makeResource(1000, 3));
+    dai::Resources::storeCachedResource(CACHE_DIR, names[1], makeResource(2000, 4));
+
+    std::unordered_map<std::string, std::vector<std::uint8_t>> resources;
+    REQUIRE(dai::Resources::loadCachedResources(CACHE_DIR, names, resources));
+    REQUIRE(resources.size() == 2);
+    REQUIRE(resources.at("second.bin") == makeResource(2000, 4));
+
+    // A single corrupted resource falls back to the archive
+    auto contents = readFile(CACHE_DIR + "/second.bin");
+    contents[contents.size() / 2] ^= 1;
+    writeFile(CACHE_DIR + "/second.bin", contents);
+    REQUIRE_FALSE(dai::Resources::loadCachedResources(CACHE_DIR, names, resources));
+    REQUIRE(resources.empty());
+
+    for(const auto& name : names) std::remove((CACHE_DIR + "/" + name).c_str());
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <memory>
+#include <thread>
+
+// Include depthai library
+#include <depthai/utility/RingQueue.hpp>
+
+TEST_CASE("Non blocking queue overwrites oldest elements") {
+    dai::RingQueue<int> queue(3, false);
+    for(int i = 0; i < 10; i++) REQUIRE(queue.push(i));
+
+    std::vector<int> elements;
+    REQUIRE(queue.consumeAll([&elements](int& el) { elements.push_back(el); }));
+    REQUIRE(elements == std::vector<int>{7, 8, 9});
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Queue grows up to max size") {
+    dai::RingQueue<int> queue(100, false);
+    for(int i = 0; i < 150; i++) queue.push(i);
+
+    int value = -1;
+    REQUIRE(queue.front(value));
+    REQUIRE(value == 50);
+
+    std::vector<int> elements;
+    queue.consumeAll([&elements](int& el) { elements.push_back(el); });
+    REQUIRE(elements.size() == 100);
+    REQUIRE(elements.back() == 149);
+}
+
+TEST_CASE("Max size of 0 discards elements") {
+    dai::RingQueue<int> queue(0, true);
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Timeouts") {
+    dai::RingQueue<int> queue(1, true);
+    int value;
+    REQUIRE_FALSE(queue.tryWaitAndPop(value, std::chrono::milliseconds(10)));
+    REQUIRE(queue.tryWaitAndPush(1, std::chrono::milliseconds(10)));
+    REQUIRE_FALSE(queue.tryWaitAndPush(2, std::chrono::milliseconds(10)));
+    REQUIRE(queue.tryWaitAndPop(value, std::chrono::milliseconds(10)));
+    REQUIRE(value == 1);
+}
+
+TEST_CASE("Destruct wakes up waiting consumers") {
+    dai::RingQueue<int> queue(4, true);
+    std::atomic<bool> popped{true};
+    std::thread consumer([&queue, &popped]() {
+        int value;
+        popped = queue.waitAndPop(value);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.destruct();
+    consumer.join();
+    REQUIRE_FALSE(popped);
+}
+
+TEST_CASE("Blocking producer with multiple consumers") {
+    constexpr int NUM_ELEMENTS = 100000;
+    dai::RingQueue<std::shared_ptr<int>> queue(8, true);
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+    std::atomic<bool> ordered{true};
+
+    auto consume = [&]() {
+        std::shared_ptr<int> value;
+        int last = -1;
+        while(queue.waitAndPop(value)) {
+            // Each consumer sees elements in order
+            if(*value <= last) ordered = false;
+            last = *value;
+            sum += *value;
+            if(++count == NUM_ELEMENTS) queue.destruct();
+        }
+    };
+    std::thread consumer1(consume);
+    std::thread consumer2(consume);
+    bool pushed = true;
+    for(int i = 0; i < NUM_ELEMENTS; i++) pushed = queue.push(std::make_shared<int>(i)) && pushed;
+    consumer1.join();
+    consumer2.join();
+
+    REQUIRE(pushed);
+    REQUIRE(ordered);
+    REQUIRE(sum == static_cast<long long>(NUM_ELEMENTS) * (NUM_ELEMENTS - 1) / 2);
+}
@@ -0,0 +1,331 @@
+#include "DeviceSimulator.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <new>
+
+// project
+#include <depthai/pipeline/datatype/IMUData.hpp>
+#include <depthai/pipeline/datatype/ImgFrame.hpp>
+#include <depthai/pipeline/datatype/NNData.hpp>
+#include <depthai/pipeline/datatype/StreamMessageParser.hpp>
+
+// libraries
+#include <XLink/XLink.h>
+#include <XLink/XLinkPlatform.h>
+
+namespace dai {
+
+namespace {
+// Packets are allocated as XLink allocates received ones, so they are released by XLinkDeallocateMoveData
+constexpr std::uint32_t PACKET_ALIGNMENT = 64;
+// Bounds how long the echo takes to notice closing
+constexpr std::chrono::milliseconds READ_TIMEOUT{100};
+
+XLinkTimespec now() {
+    const auto time = std::chrono::steady_clock::now().time_since_epoch();
+    const auto sec = std::chrono::duration_cast<std::chrono::seconds>(time);
+    XLinkTimespec timespec{};
+    timespec.tv_sec = static_cast<decltype(timespec.tv_sec)>(sec.count());
+    timespec.tv_nsec = static_cast<decltype(timespec.tv_nsec)>(std::chrono::duration_cast<std::chrono::nanoseconds>(time - sec).count());
+    return timespec;
+}
+
+StreamPacketDesc allocatePacket(std::size_t size) {
+    const auto alignedSize = static_cast<std::uint32_t>((size + PACKET_ALIGNMENT - 1) / PACKET_ALIGNMENT * PACKET_ALIGNMENT);
+    StreamPacketDesc packet;
+    packet.data = static_cast<std::uint8_t*>(XLinkPlatformAllocateData(alignedSize, PACKET_ALIGNMENT));
+    if(packet.data == nullptr) throw std::bad_alloc();
+    packet.length = static_cast<std::uint32_t>(size);
+    packet.tRemoteSent = now();
+    return packet;
+}
+
+std::shared_ptr<Buffer> createMessage(const DeviceSimulator::GeneratorConfig& config) {
+    switch(config.type) {
+        case DeviceSimulator::MessageType::IMG_FRAME: {
+            auto frame = std::make_shared<ImgFrame>();
+            frame->setType(ImgFrame::Type::NV12);
+            frame->setWidth(config.width);
+            frame->setHeight(config.height);
+            frame->setData(std::vector<std::uint8_t>(static_cast<std::size_t>(config.width) * config.height * 3 / 2));
+            return frame;
+        }
+        case DeviceSimulator::MessageType::IMU_DATA: {
+            auto imu = std::make_shared<IMUData>();
+            imu->packets.resize(config.numImuPackets);
+            return imu;
+        }
+        case DeviceSimulator::MessageType::NN_DATA: {
+            auto nnData = std::make_shared<NNData>();
+            nnData->setLayer("output", std::vector<std::uint8_t>(config.layerSize));
+            return nnData;
+        }
+    }
+    throw std::invalid_argument("Unknown generated message type");
+}
+
+// Queue constructors taking a PacketStream are only accessible to derived classes
+class SimulatedOutputQueue : public DataOutputQueue {
+   public:
+    SimulatedOutputQueue(std::unique_ptr<PacketStream> stream, const std::string& name) : DataOutputQueue(std::move(stream), name) {}
+};
+
+class SimulatedInputQueue : public DataInputQueue {
+   public:
+    SimulatedInputQueue(std::unique_ptr<PacketStream> stream, const std::string& name) : DataInputQueue(std::move(stream), name) {}
+};
+}  // namespace
+
+// SIMULATED STREAM
+struct SimulatedStream::Channel {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<StreamPacketDesc> packets;
+    const std::size_t capacity;
+    bool closed = false;
+
+    explicit Channel(std::size_t capacity) : capacity(std::max<std::size_t>(capacity, 1)) {}
+
+    // Blocks while full, returns false once closed
+    bool push(StreamPacketDesc&& packet) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]() { return closed || packets.size() < capacity; });
+            if(closed) return false;
+            packets.push_back(std::move(packet));
+        }
+        cv.notify_all();
+        return true;
+    }
+
+    // Returns false on timeout, or once closed
+    bool pop(StreamPacketDesc& packet, std::chrono::milliseconds timeout, bool& isClosed) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait_for(lock, timeout, [this]() { return closed || !packets.empty(); });
+            isClosed = closed;
+            if(closed || packets.empty()) return false;
+            packet = std::move(packets.front());
+            packets.pop_front();
+        }
+        packet.tReceived = now();
+        cv.notify_all();
+        return true;
+    }
+
+    void close() {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            closed = true;
+            packets.clear();
+        }
+        cv.notify_all();
+    }
+};
+
+SimulatedStream::SimulatedStream(std::shared_ptr<Channel> channel, std::string name) : channel(std::move(channel)), name(std::move(name)) {}
+
+void SimulatedStream::write(const std::vector<span<const std::uint8_t>>& segments) {
+    const auto t1 = std::chrono::steady_clock::now();
+    std::size_t size = 0;
+    for(const auto& segment : segments) size += segment.size();
+    auto packet = allocatePacket(size);
+    std::size_t offset = 0;
+    for(const auto& segment : segments) {
+        if(segment.empty()) continue;
+        std::memcpy(packet.data + offset, segment.data(), segment.size());
+        offset += segment.size();
+    }
+    const bool written = channel->push(std::move(packet));
+    if(StreamProfiler::isEnabled()) profiler->recordWrite(std::chrono::steady_clock::now() - t1, size, written);
+    if(!written) throw XLinkWriteError(X_LINK_COMMUNICATION_NOT_OPEN, name);
+}
+
+bool SimulatedStream::readMove(StreamPacketDesc& packet, std::chrono::milliseconds timeout) {
+    bool closed = false;
+    const auto t1 = std::chrono::steady_clock::now();
+    const bool read = channel->pop(packet, timeout, closed);
+    if(StreamProfiler::isEnabled()) profiler->recordRead(std::chrono::steady_clock::now() - t1, read ? &packet : nullptr);
+    if(read) return true;
+    if(closed) throw XLinkReadError(X_LINK_COMMUNICATION_NOT_OPEN, name);
+    return false;
+}
+
+std::size_t SimulatedStream::readMoveMany(std::vector<StreamPacketDesc>& packets, std::chrono::milliseconds timeout, std::size_t maxNumPackets) {
+    std::size_t numRead = 0;
+    auto wait = timeout;
+    while(numRead < maxNumPackets) {
+        StreamPacketDesc packet;
+        if(!readMove(packet, wait)) break;
+        packets.push_back(std::move(packet));
+        numRead++;
+        wait = std::chrono::milliseconds(0);
+    }
+    return numRead;
+}
+
+const std::string& SimulatedStream::getName() const {
+    return name;
+}
+
+StreamProfilingData SimulatedStream::getProfilingData() const {
+    return profiler->getData();
+}
+
+std::shared_ptr<StreamProfiler> SimulatedStream::getProfiler() const {
+    return profiler;
+}
+
+// DEVICE SIMULATOR
+DeviceSimulator::DeviceSimulator() : DeviceSimulator(Config{}) {}
+
+DeviceSimulator::DeviceSimulator(Config config) : config(config) {}
+
+DeviceSimulator::~DeviceSimulator() {
+    close();
+}
+
+std::shared_ptr<SimulatedStream::Channel> DeviceSimulator::createChannel(const std::string& name) {
+    if(!running) throw std::runtime_error("DeviceSimulator is closed");
+    if(name.empty()) throw std::invalid_argument("Stream name cannot be empty");
+    if(outputQueueMap.count(name) > 0 || inputQueueMap.count(name) > 0 || openedChannels.count(name) > 0) {
+        throw std::invalid_argument("Stream name '" + name + "' is already used");
+    }
+    auto channel = std::make_shared<SimulatedStream::Channel>(config.streamCapacity);
+    channels.push_back(channel);
+    return channel;
+}
+
+void DeviceSimulator::addGenerator(const std::string& stream, GeneratorConfig generatorConfig) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto channel = createChannel(stream);
+    outputQueueMap[stream] = std::make_shared<SimulatedOutputQueue>(std::make_unique<SimulatedStream>(channel, stream), stream);
+    behaviours.emplace_back([this, channel, generatorConfig]() { generate(channel, generatorConfig); });
+}
+
+void DeviceSimulator::addEcho(const std::string& inputStream, const std::string& outputStream) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(inputStream == outputStream) throw std::invalid_argument("Echo input and output streams must differ");
+    auto input = createChannel(inputStream);
+    auto output = createChannel(outputStream);
+    inputQueueMap[inputStream] = std::make_shared<SimulatedInputQueue>(std::make_unique<SimulatedStream>(input, inputStream), inputStream);
+    outputQueueMap[outputStream] = std::make_shared<SimulatedOutputQueue>(std::make_unique<SimulatedStream>(output, outputStream), outputStream);
+    behaviours.emplace_back([this, input, inputStream, output]() { echo(SimulatedStream(input, inputStream), output); });
+}
+
+std::shared_ptr<DataOutputQueue> DeviceSimulator::getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(outputQueueMap.count(name) == 0) {
+        throw std::runtime_error("Queue for stream name '" + name + "' doesn't exist");
+    }
+
+    // Modify max size and blocking
+    outputQueueMap.at(name)->setMaxSize(maxSize);
+    outputQueueMap.at(name)->setBlocking(blocking);
+    return outputQueueMap.at(name);
+}
+
+std::shared_ptr<DataInputQueue> DeviceSimulator::getInputQueue(const std::string& name, unsigned int maxSize, bool blocking) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(inputQueueMap.count(name) == 0) {
+        throw std::runtime_error("Queue for stream name '" + name + "' doesn't exist");
+    }
+
+    // Modify max size and blocking
+    inputQueueMap.at(name)->setMaxSize(maxSize);
+    inputQueueMap.at(name)->setBlocking(blocking);
+    return inputQueueMap.at(name);
+}
+
+std::unique_ptr<SimulatedStream> DeviceSimulator::openStream(const std::string& name) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = openedChannels.find(name);
+    if(it == openedChannels.end()) {
+        it = openedChannels.emplace(name, createChannel(name)).first;
+    }
+    return std::make_unique<SimulatedStream>(it->second, name);
+}
+
+void DeviceSimulator::close() {
+    if(!running.exchange(false)) return;
+
+    std::vector<std::thread> threads;
+    std::unordered_map<std::string, std::shared_ptr<DataOutputQueue>> outputQueues;
+    std::unordered_map<std::string, std::shared_ptr<DataInputQueue>> inputQueues;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        // Unblocks behaviours and queues waiting on streams
+        for(auto& channel : channels) channel->close();
+        threads = std::move(behaviours);
+        outputQueues = std::move(outputQueueMap);
+        inputQueues = std::move(inputQueueMap);
+    }
+    stopCv.notify_all();
+    for(auto& thread : threads) {
+        if(thread.joinable()) thread.join();
+    }
+
+    // Queues notice closed streams and close themselves, close them explicitly to wait for their threads
+    for(auto& kv : outputQueues) kv.second->close();
+    for(auto& kv : inputQueues) kv.second->close();
+}
+
+bool DeviceSimulator::isClosed() const {
+    return !running;
+}
+
+void DeviceSimulator::generate(std::shared_ptr<SimulatedStream::Channel> output, GeneratorConfig generatorConfig) {
+    try {
+        // Message is created once, only its sequence number and timestamps change
+        auto msg = createMessage(generatorConfig);
+        const auto raw = msg->getRaw();
+        const bool limited = generatorConfig.fps > 0;
+        const auto period = limited ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / generatorConfig.fps))
+                                    : std::chrono::steady_clock::duration::zero();
+
+        auto next = std::chrono::steady_clock::now();
+        for(std::int64_t sequenceNum = 0; running; sequenceNum++) {
+            if(limited) {
+                std::unique_lock<std::mutex> lock(mtx);
+                if(stopCv.wait_until(lock, next, [this]() { return !running; })) break;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            msg->setSequenceNum(sequenceNum);
+            msg->setTimestamp(now);
+            msg->setTimestampDevice(now);
+
+            // Same packet as XLinkOut sends: data followed by serialized metadata
+            const auto metadata = StreamMessageParser::serializeMetadata(raw);
+            auto packet = allocatePacket(raw->data.size() + metadata.size());
+            std::copy(raw->data.begin(), raw->data.end(), packet.data);
+            std::copy(metadata.begin(), metadata.end(), packet.data + raw->data.size());
+            if(!output->push(std::move(packet))) break;
+
+            // Keep the rate, without catching up after being blocked by a slow reader
+            next = std::max(next + period, std::chrono::steady_clock::now());
+        }
+    } catch(const std::exception& ex) {
+        std::cerr << "DeviceSimulator generator stopped: " << ex.what() << std::endl;
+    }
+}
+
+void DeviceSimulator::echo(SimulatedStream input, std::shared_ptr<SimulatedStream::Channel> output) {
+    try {
+        while(running) {
+            StreamPacketDesc packet;
+            if(!input.readMove(packet, READ_TIMEOUT)) continue;
+            // Packet is passed on as is, without copying
+            if(!output->push(std::move(packet))) break;
+        }
+    } catch(const std::exception& ex) {
+        // Reading throws once the simulator is closed
+        if(running) std::cerr << "DeviceSimulator echo stopped: " << ex.what() << std::endl;
+    }
+}
+
+}  // namespace dai
@@ -0,0 +1,185 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include <depthai/device/DataQueue.hpp>
+#include <depthai/utility/span.hpp>
+#include <depthai/xlink/XLinkStream.hpp>
+
+namespace dai {
+
+/**
+ * In-process stream of a DeviceSimulator.
+ * Packets flow from the writer to the reader and are buffered up to the simulator's stream capacity,
+ * after which writes block, as a device waiting for the host to read does.
+ */
+class SimulatedStream : public PacketStream {
+   public:
+    struct Channel;
+
+    SimulatedStream(std::shared_ptr<Channel> channel, std::string name);
+
+    // Blocking, throws XLinkWriteError once the simulator is closed
+    void write(const std::vector<span<const std::uint8_t>>& segments) override;
+    // Timeout, throw XLinkReadError once the simulator is closed
+    bool readMove(StreamPacketDesc& packet, std::chrono::milliseconds timeout) override;
+    std::size_t readMoveMany(std::vector<StreamPacketDesc>& packets, std::chrono::milliseconds timeout, std::size_t maxNumPackets = SIZE_MAX) override;
+
+    const std::string& getName() const;
+    StreamProfilingData getProfilingData() const;
+    std::shared_ptr<StreamProfiler> getProfiler() const override;
+
+   private:
+    std::shared_ptr<Channel> channel;
+    std::string name;
+    std::shared_ptr<StreamProfiler> profiler{std::make_shared<StreamProfiler>()};
+};
+
+/**
+ * Local stand-in for a device, for testing and benchmarking host side message handling without hardware.
+ * Test helper only, not part of the library.
+ *
+ * Provides the same DataOutputQueue and DataInputQueue classes as Device, exchanging packets of the same format
+ * (message data followed by serialized metadata) with built-in behaviours running on their own threads,
+ * instead of a pipeline running on the device. Queue, parsing and threading throughput of the host is thus
+ * measured without the device or the link being the bottleneck.
+ *
+ * Only the data queues are simulated. XLink itself (connection, USB/TCP transport, stream opening),
+ * the RPC and logging channels, Device and Pipeline startup are not, so tests of those still need a device.
+ */
+class DeviceSimulator {
+   public:
+    /// Type of messages a generator produces
+    enum class MessageType {
+        /// NV12 ImgFrame
+        IMG_FRAME,
+        /// IMUData with accelerometer and gyroscope packets
+        IMU_DATA,
+        /// NNData with a single U8 layer
+        NN_DATA
+    };
+
+    struct GeneratorConfig {
+        MessageType type = MessageType::IMG_FRAME;
+        /// Messages generated per second, 0 generates as fast as messages are read
+        float fps = 30.0f;
+        /// ImgFrame resolution
+        unsigned width = 1920;
+        unsigned height = 1080;
+        /// Number of IMU packets per IMUData message
+        unsigned numImuPackets = 20;
+        /// Size of the NNData layer, in bytes
+        std::size_t layerSize = 1000;
+    };
+
+    struct Config {
+        /// Number of packets buffered per stream before writers block
+        unsigned streamCapacity = 4;
+    };
+
+    /**
+     * Creates a simulator with default configuration
+     */
+    DeviceSimulator();
+
+    /**
+     * Creates a simulator
+     * @param config Simulator configuration
+     */
+    explicit DeviceSimulator(Config config);
+    DeviceSimulator(const DeviceSimulator&) = delete;
+    DeviceSimulator& operator=(const DeviceSimulator&) = delete;
+
+    /**
+     * Closes the simulator and its queues
+     */
+    ~DeviceSimulator();
+
+    /**
+     * Starts generating synthetic messages into a stream, at configured rate, and creates its output queue.
+     * Each message gets the next sequence number and the current time as (device and host) timestamp
+     *
+     * @param stream Name of the stream messages are generated into
+     * @param config Generated messages
+     */
+    void addGenerator(const std::string& stream, GeneratorConfig config);
+
+    /**
+     * Starts passing packets written to a stream back through another stream, as an XLinkIn linked to an XLinkOut does.
+     * Creates an input queue of the first and an output queue of the second stream
+     *
+     * @param inputStream Name of the stream read from
+     * @param outputStream Name of the stream written to
+     */
+    void addEcho(const std::string& inputStream, const std::string& outputStream);
+
+    /**
+     * Gets an output queue corresponding to stream name. If it doesn't exist it throws
+     *
+     * @param name Queue/stream name
+     * @param maxSize Maximum number of messages in queue
+     * @param blocking Queue behavior once full. True specifies blocking and false overwriting of oldest messages
+     * @returns Smart pointer to DataOutputQueue
+     */
+    std::shared_ptr<DataOutputQueue> getOutputQueue(const std::string& name, unsigned int maxSize = 16, bool blocking = true);
+
+    /**
+     * Gets an input queue corresponding to stream name. If it doesn't exist it throws
+     *
+     * @param name Queue/stream name
+     * @param maxSize Maximum number of messages in queue
+     * @param blocking Queue behavior once full. True specifies blocking and false overwriting of oldest messages
+     * @returns Smart pointer to DataInputQueue
+     */
+    std::shared_ptr<DataInputQueue> getInputQueue(const std::string& name, unsigned int maxSize = 16, bool blocking = true);
+
+    /**
+     * Opens a stream without a behaviour or queue, to write and read packets directly (eg. through a StreamReactor).
+     * Streams opened with the same name share their packets, so one can be written while another is read
+     *
+     * @param name Stream name
+     * @returns Stream, which throws once the simulator is closed
+     */
+    std::unique_ptr<SimulatedStream> openStream(const std::string& name);
+
+    /**
+     * Stops behaviours and closes all streams. Queues close with an exception, as on device disconnect
+     */
+    void close();
+
+    /**
+     * Is the simulator already closed
+     *
+     * @returns True if closed, false otherwise
+     */
+    bool isClosed() const;
+
+   private:
+    const Config config;
+    std::atomic<bool> running{true};
+    std::mutex mtx;
+    std::condition_variable stopCv;
+    std::vector<std::shared_ptr<SimulatedStream::Channel>> channels;
+    std::unordered_map<std::string, std::shared_ptr<DataOutputQueue>> outputQueueMap;
+    std::unordered_map<std::string, std::shared_ptr<DataInputQueue>> inputQueueMap;
+    std::unordered_map<std::string, std::shared_ptr<SimulatedStream::Channel>> openedChannels;
+    std::vector<std::thread> behaviours;
+
+    // Must be called with 'mtx' locked
+    std::shared_ptr<SimulatedStream::Channel> createChannel(const std::string& name);
+    void generate(std::shared_ptr<SimulatedStream::Channel> output, GeneratorConfig config);
+    void echo(SimulatedStream input, std::shared_ptr<SimulatedStream::Channel> output);
+};
+
+}  // namespace dai
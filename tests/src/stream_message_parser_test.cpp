@@ -1,8 +1,17 @@
 #include <catch2/catch_all.hpp>
 
+// std
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// libraries
+#include <XLink/XLinkPlatform.h>
+
 // Include depthai library
 #include <depthai/depthai.hpp>
 #include <depthai/pipeline/datatype/StreamMessageParser.hpp>
+#include <depthai/xlink/XLinkStream.hpp>
 
 // TODO(themarpe) - fuzz me instead
 
@@ -148,3 +157,164 @@ TEST_CASE("Raw - Incorrect message too small size 2") {
 
     REQUIRE_THROWS(dai::StreamMessageParser::parseMessage(&packet));
 }
+
+TEST_CASE("Data view matches data") {
+    dai::ImgFrame frm;
+    frm.setData({0, 1, 2, 3, 4, 5, 6, 7});
+    auto ser = dai::StreamMessageParser::serializeMessage(frm);
+
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+
+    auto des = std::dynamic_pointer_cast<dai::ImgFrame>(dai::StreamMessageParser::parseMessageToADatatype(&packet));
+    REQUIRE(des != nullptr);
+    auto view = des->getDataView();
+    REQUIRE(std::vector<uint8_t>(view.begin(), view.end()) == frm.getData());
+    REQUIRE(view.data() == des->getData().data());
+}
+
+// Packet owning XLink allocated memory, as if read from a stream
+static dai::StreamPacketDesc allocatePacket(const std::vector<uint8_t>& ser) {
+    constexpr std::uint32_t alignment = 64;
+    dai::StreamPacketDesc packet;
+    packet.data = static_cast<std::uint8_t*>(XLinkPlatformAllocateData((ser.size() + alignment - 1) / alignment * alignment, alignment));
+    REQUIRE(packet.data != nullptr);
+    std::memcpy(packet.data, ser.data(), ser.size());
+    packet.length = static_cast<std::uint32_t>(ser.size());
+    return packet;
+}
+
+TEST_CASE("Adopted data is viewed in place and copied on access") {
+    dai::ImgFrame frm;
+    frm.setData({0, 1, 2, 3, 4, 5, 6, 7});
+    auto ser = dai::StreamMessageParser::serializeMessage(frm);
+
+    auto packet = allocatePacket(ser);
+    const std::uint8_t* packetData = packet.data;
+
+    dai::DatatypeEnum type;
+    auto des = std::dynamic_pointer_cast<dai::ImgFrame>(dai::StreamMessageParser::parseMessageToADatatype(std::move(packet), type));
+    REQUIRE(type == dai::DatatypeEnum::ImgFrame);
+    REQUIRE(des != nullptr);
+    REQUIRE(packet.data == nullptr);
+
+    // View of the packet itself, read-only
+    auto view = des->getDataView();
+    static_assert(std::is_same<decltype(view), dai::span<const std::uint8_t>>::value, "Data view must be read-only");
+    REQUIRE(view.data() == packetData);
+    REQUIRE(std::vector<uint8_t>(view.begin(), view.end()) == frm.getData());
+
+    // getData copies the data out of the packet, views follow the copy
+    auto& data = des->getData();
+    REQUIRE(data == frm.getData());
+    REQUIRE(data.data() != packetData);
+    REQUIRE(des->getDataView().data() == data.data());
+
+    REQUIRE(dai::StreamMessageParser::serializeMessage(des) == ser);
+}
+
+TEST_CASE("Adopted data of group members is copied only when the group is serialized") {
+    dai::Buffer buffer;
+    buffer.setData({0, 1, 2, 3, 4, 5, 6, 7});
+    auto packet = allocatePacket(dai::StreamMessageParser::serializeMessage(buffer));
+    const std::uint8_t* packetData = packet.data;
+
+    dai::DatatypeEnum type;
+    auto member = dai::StreamMessageParser::parseMessageToADatatype(std::move(packet), type);
+    dai::MessageGroup group;
+    group.add("member", member);
+
+    // Still viewed in the packet
+    REQUIRE(group.get<dai::Buffer>("member")->getDataView().data() == packetData);
+
+    // Members are serialized with their data
+    auto rawGroup = std::dynamic_pointer_cast<dai::RawMessageGroup>(static_cast<const dai::ADatatype&>(group).serialize());
+    REQUIRE(rawGroup != nullptr);
+    REQUIRE(rawGroup->group.at("member").buffer->data == buffer.getData());
+}
+
+TEST_CASE("Data followed by serialized metadata equals serialized message") {
+    dai::ImgFrame frm;
+    frm.setData({0, 1, 2, 3, 4, 5, 6, 7});
+    auto ser = dai::StreamMessageParser::serializeMessage(frm);
+
+    auto metadata = dai::StreamMessageParser::serializeMetadata(frm.getRaw());
+    std::vector<uint8_t> concat(frm.getData());
+    concat.insert(concat.end(), metadata.begin(), metadata.end());
+
+    REQUIRE(ser == concat);
+}
+
+static std::vector<uint8_t> serializeDetections(std::size_t count) {
+    dai::ImgDetections dets;
+    dets.detections.resize(count);
+    for(std::size_t i = 0; i < count; i++) {
+        dets.detections[i].label = static_cast<std::uint32_t>(i);
+        dets.detections[i].confidence = 0.5f;
+    }
+    dets.setSequenceNum(42);
+    return dai::StreamMessageParser::serializeMessage(dets);
+}
+
+TEST_CASE("Lazy metadata is decoded on access") {
+    auto ser = serializeDetections(10);
+
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+
+    dai::DatatypeEnum type;
+    auto des = dai::StreamMessageParser::parseMessageToADatatype(&packet, type, nullptr, true);
+    REQUIRE(type == dai::DatatypeEnum::ImgDetections);
+
+    auto raw = std::dynamic_pointer_cast<dai::RawImgDetections>(des->getRaw());
+    REQUIRE(raw != nullptr);
+    REQUIRE(raw->sequenceNum == 42);
+    REQUIRE(raw->detections.size() == 10);
+    REQUIRE(raw->detections[9].label == 9);
+    REQUIRE(dai::StreamMessageParser::serializeMessage(des) == ser);
+}
+
+TEST_CASE("Message groups are parsed eagerly") {
+    dai::Buffer buf;
+    buf.setData({1, 2, 3});
+    dai::MessageGroup grp;
+    grp.add("first", buf);
+    grp.add("second", buf);
+    grp.setSequenceNum(7);
+    auto ser = dai::StreamMessageParser::serializeMessage(grp);
+
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+
+    dai::DatatypeEnum type;
+    auto des = std::dynamic_pointer_cast<dai::MessageGroup>(dai::StreamMessageParser::parseMessageToADatatype(&packet, type, nullptr, true));
+    REQUIRE(type == dai::DatatypeEnum::MessageGroup);
+    REQUIRE(des != nullptr);
+    // Number of members is known without decoding, as queues read the members based on it
+    REQUIRE(des->getNumMessages() == 2);
+    REQUIRE(des->getSequenceNum() == 7);
+}
+
+TEST_CASE("Lazy metadata parsing", "[.][benchmark]") {
+    // Parse and drop messages with large metadata, as a full non-blocking queue would
+    auto ser = serializeDetections(200);
+
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+    dai::DatatypeEnum type;
+
+    BENCHMARK("Eager") {
+        return dai::StreamMessageParser::parseMessageToADatatype(&packet, type, nullptr, false);
+    };
+    BENCHMARK("Lazy") {
+        return dai::StreamMessageParser::parseMessageToADatatype(&packet, type, nullptr, true);
+    };
+    BENCHMARK("Lazy, accessed") {
+        auto msg = dai::StreamMessageParser::parseMessageToADatatype(&packet, type, nullptr, true);
+        return msg->getRaw();
+    };
+}
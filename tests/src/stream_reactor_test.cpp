@@ -0,0 +1,228 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai-shared/datatype/RawMessageGroup.hpp>
+#include <depthai/pipeline/datatype/Buffer.hpp>
+#include <depthai/pipeline/datatype/MessageGroup.hpp>
+#include <depthai/pipeline/datatype/StreamMessageParser.hpp>
+#include <depthai/xlink/StreamReactor.hpp>
+
+#include "simulator/DeviceSimulator.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Reactor queue constructor taking a PacketStream is only accessible to derived classes
+class ReactorOutputQueue : public dai::DataOutputQueue {
+   public:
+    ReactorOutputQueue(std::unique_ptr<dai::PacketStream> stream, const std::string& name, std::shared_ptr<dai::StreamReactor> reactor)
+        : DataOutputQueue(std::move(stream), name, std::move(reactor)) {}
+};
+
+void writePacket(dai::PacketStream& stream, const std::vector<std::uint8_t>& data) {
+    stream.write({dai::span<const std::uint8_t>(data.data(), data.size())});
+}
+
+bool waitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout = 1000ms) {
+    const auto start = std::chrono::steady_clock::now();
+    while(!condition()) {
+        if(std::chrono::steady_clock::now() - start > timeout) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+void ignoreErrors(const std::exception&) {}
+
+}  // namespace
+
+TEST_CASE("Streams of a thread are read in turn") {
+    dai::DeviceSimulator::Config simulatorConfig;
+    simulatorConfig.streamCapacity = 64;
+    dai::DeviceSimulator simulator(simulatorConfig);
+    dai::StreamReactor::Config config;
+    config.numThreads = 1;
+    dai::StreamReactor reactor(config);
+
+    // The first packet holds the thread in its handler until both streams are full
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool filled = false;
+    std::vector<std::string> order;
+    const auto handler = [&](dai::PacketStream& stream, dai::StreamPacketDesc&&) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&filled]() { return filled; });
+        order.push_back(static_cast<dai::SimulatedStream&>(stream).getName());
+    };
+    auto a = simulator.openStream("a");
+    auto b = simulator.openStream("b");
+    const auto idA = reactor.add(simulator.openStream("a"), handler, ignoreErrors);
+    const auto idB = reactor.add(simulator.openStream("b"), handler, ignoreErrors);
+
+    constexpr int numPackets = 32;
+    const std::vector<std::uint8_t> data(100);
+    for(int i = 0; i < numPackets; i++) writePacket(*a, data);
+    for(int i = 0; i < numPackets; i++) writePacket(*b, data);
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        filled = true;
+    }
+    cv.notify_all();
+
+    REQUIRE(waitFor([&]() {
+        std::unique_lock<std::mutex> lock(mtx);
+        return order.size() == 2 * numPackets;
+    }));
+    // Neither stream gets ahead of the other. The first packet may have been read before the thread noticed stream b
+    int balance = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    for(const auto& name : order) {
+        balance += name == "a" ? 1 : -1;
+        REQUIRE(std::abs(balance) <= 2);
+    }
+    lock.unlock();
+
+    reactor.remove(idA);
+    reactor.remove(idB);
+}
+
+TEST_CASE("Stream can be removed from its handler") {
+    dai::DeviceSimulator simulator;
+    dai::StreamReactor reactor;
+
+    std::atomic<int> numPackets{0};
+    std::atomic<dai::StreamReactor::StreamId> id{0};
+    auto writer = simulator.openStream("a");
+    id = reactor.add(
+        simulator.openStream("a"),
+        [&](dai::PacketStream&, dai::StreamPacketDesc&&) {
+            numPackets++;
+            reactor.remove(id);
+        },
+        ignoreErrors);
+
+    const std::vector<std::uint8_t> data(100);
+    for(int i = 0; i < 3; i++) writePacket(*writer, data);
+    REQUIRE(waitFor([&]() { return reactor.getStats().numStreams == 0; }));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(numPackets == 1);
+}
+
+TEST_CASE("Removing a busy stream waits for its handler") {
+    dai::DeviceSimulator simulator;
+    dai::StreamReactor reactor;
+
+    std::atomic<int> numPackets{0};
+    std::atomic<bool> entered{false};
+    std::atomic<bool> finished{false};
+    auto writer = simulator.openStream("a");
+    const auto id = reactor.add(
+        simulator.openStream("a"),
+        [&](dai::PacketStream&, dai::StreamPacketDesc&&) {
+            numPackets++;
+            entered = true;
+            std::this_thread::sleep_for(50ms);
+            finished = true;
+        },
+        ignoreErrors);
+
+    const std::vector<std::uint8_t> data(100);
+    writePacket(*writer, data);
+    REQUIRE(waitFor([&]() { return entered.load(); }));
+    reactor.remove(id);
+    REQUIRE(finished);
+
+    // Not read anymore
+    writePacket(*writer, data);
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(numPackets == 1);
+    REQUIRE(reactor.getStats().numStreams == 0);
+}
+
+TEST_CASE("Read errors are reported once and remove the stream") {
+    dai::DeviceSimulator simulator;
+    dai::StreamReactor reactor;
+
+    std::atomic<int> numErrors{0};
+    reactor.add(
+        simulator.openStream("a"), [](dai::PacketStream&, dai::StreamPacketDesc&&) {}, [&](const std::exception&) { numErrors++; });
+
+    // Reading from closed streams throws
+    simulator.close();
+    REQUIRE(waitFor([&]() { return reactor.getStats().numStreams == 0; }));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(numErrors == 1);
+}
+
+TEST_CASE("Output queue read by a reactor closes on read errors") {
+    dai::DeviceSimulator simulator;
+    auto reactor = std::make_shared<dai::StreamReactor>();
+    ReactorOutputQueue queue(simulator.openStream("out"), "out", reactor);
+
+    // The queue is closed from within the reactor's error handler
+    simulator.close();
+    REQUIRE(waitFor([&]() { return queue.isClosed(); }));
+    REQUIRE_THROWS_AS(queue.get(), std::runtime_error);
+    REQUIRE(reactor->getStats().numStreams == 0);
+}
+
+TEST_CASE("Message group waiting for its members doesn't stall other streams") {
+    dai::DeviceSimulator simulator;
+    dai::StreamReactor::Config config;
+    config.numThreads = 1;
+    auto reactor = std::make_shared<dai::StreamReactor>(config);
+
+    auto groupWriter = simulator.openStream("group");
+    ReactorOutputQueue queue(simulator.openStream("group"), "group", reactor);
+    auto otherWriter = simulator.openStream("other");
+    std::atomic<int> numOtherPackets{0};
+    const auto otherId = reactor->add(
+        simulator.openStream("other"), [&](dai::PacketStream&, dai::StreamPacketDesc&&) { numOtherPackets++; }, ignoreErrors);
+
+    // Group followed by its members, as an input queue sends it
+    dai::Buffer first;
+    first.setData({1, 2, 3});
+    dai::Buffer second;
+    second.setData({4, 5});
+    dai::MessageGroup group;
+    group.add("first", first);
+    group.add("second", second);
+    auto rawGroup = std::dynamic_pointer_cast<dai::RawMessageGroup>(static_cast<const dai::ADatatype&>(group).serialize());
+    REQUIRE(rawGroup != nullptr);
+    std::vector<std::vector<std::uint8_t>> members;
+    unsigned int index = 0;
+    for(auto& member : rawGroup->group) {
+        member.second.index = index++;
+        members.push_back(dai::StreamMessageParser::serializeMessage(*member.second.buffer));
+    }
+
+    // Members are late, other streams are read meanwhile
+    writePacket(*groupWriter, dai::StreamMessageParser::serializeMessage(*rawGroup));
+    const std::vector<std::uint8_t> data(100);
+    for(int i = 0; i < 3; i++) writePacket(*otherWriter, data);
+    REQUIRE(waitFor([&]() { return numOtherPackets == 3; }));
+    REQUIRE_FALSE(queue.has());
+
+    for(const auto& member : members) writePacket(*groupWriter, member);
+    bool timedOut = false;
+    auto received = queue.get<dai::MessageGroup>(1s, timedOut);
+    REQUIRE_FALSE(timedOut);
+    REQUIRE(received->getNumMessages() == 2);
+    REQUIRE(received->get<dai::Buffer>("first")->getData() == first.getData());
+    REQUIRE(received->get<dai::Buffer>("second")->getData() == second.getData());
+
+    reactor->remove(otherId);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include "depthai/device/Device.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/ImgDetections.hpp"
+#include "depthai/pipeline/node/ColorCamera.hpp"
+#include "depthai/pipeline/node/XLinkOut.hpp"
+
+#include "simulator/DeviceSimulator.hpp"
+
+using namespace std::chrono_literals;
+
+dai::Pipeline getPipeline() {
+    dai::Pipeline pipeline;
+    auto camNode = pipeline.create<dai::node::ColorCamera>();
+    auto xlinkOut = pipeline.create<dai::node::XLinkOut>();
+    camNode->setPreviewSize(300, 300);
+    camNode->preview.link(xlinkOut->input);
+    xlinkOut->setStreamName("preview");
+    return pipeline;
+}
+
+TEST_CASE("Typed queue returns messages of its type") {
+    dai::Device device(getPipeline());
+    auto queue = device.getOutputQueue<dai::ImgFrame>("preview", 8, false);
+
+    for(int i = 0; i < 10; i++) {
+        auto frame = queue.get();
+        REQUIRE(frame != nullptr);
+        REQUIRE(frame->getWidth() == 300);
+    }
+
+    // Reused vector keeps its capacity
+    std::vector<std::shared_ptr<dai::ImgFrame>> frames;
+    frames.reserve(8);
+    const auto capacity = frames.capacity();
+    for(int i = 0; i < 10; i++) {
+        frames.clear();
+        REQUIRE(queue.getAll(frames) > 0);
+        REQUIRE(frames.capacity() == capacity);
+        for(const auto& frame : frames) REQUIRE(frame != nullptr);
+    }
+}
+
+TEST_CASE("Typed queue throws on mismatched message type") {
+    dai::Device device(getPipeline());
+    auto queue = device.getOutputQueue<dai::ImgDetections>("preview");
+    REQUIRE_THROWS(queue.get());
+}
+
+TEST_CASE("Typed queue doesn't get stuck on a mismatched message") {
+    dai::DeviceSimulator simulator;
+    simulator.addEcho("in", "out");
+    auto in = simulator.getInputQueue("in");
+    dai::TypedOutputQueue<dai::ImgFrame> queue(simulator.getOutputQueue("out"));
+
+    const auto sendMismatchedThenValid = [&in]() {
+        in->send(dai::ImgDetections());
+        dai::ImgFrame frame;
+        frame.setWidth(300);
+        in->send(frame);
+        // Wait until both arrived
+        std::this_thread::sleep_for(100ms);
+    };
+
+    sendMismatchedThenValid();
+    REQUIRE_THROWS(queue.get());
+    bool timedOut = false;
+    auto frame = queue.get(1s, timedOut);
+    REQUIRE_FALSE(timedOut);
+    REQUIRE(frame->getWidth() == 300);
+
+    sendMismatchedThenValid();
+    std::vector<std::shared_ptr<dai::ImgFrame>> frames;
+    REQUIRE_THROWS(queue.getAll(frames));
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0]->getWidth() == 300);
+    REQUIRE_FALSE(queue.has());
+}
+
+TEST_CASE("Typed queue callback receives typed messages") {
+    dai::Device device(getPipeline());
+    auto queue = device.getOutputQueue<dai::ImgFrame>("preview", 4, false);
+
+    std::atomic<int> numFrames{0};
+    queue.addCallback([&numFrames](std::shared_ptr<dai::ImgFrame> frame) {
+        if(frame->getWidth() == 300) numFrames++;
+    });
+    const auto start = std::chrono::steady_clock::now();
+    while(numFrames < 10 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(numFrames >= 10);
+}